@@ -1,6 +1,8 @@
 #pragma once
 #include "../Collection/ICollection.h"
 #include "../Collection/IIterable.h"
+#include "Scan.h"
+#include "Span.h"
 #include <stdexcept>
 
 namespace Structs
@@ -86,6 +88,7 @@ namespace Structs
 	{
 	public:
 		using Iterator = QueueIterator<T>;
+		static constexpr size_t NotFound = Scan::NotFound;
 
 	public:
 		Queue()
@@ -130,6 +133,8 @@ namespace Structs
 			queue.capacity = 0;
 			queue.firstElementIndex = 0;
 			queue.lastElementIndex = 0;
+
+			return *this;
 		}
 
 		~Queue()
@@ -155,7 +160,11 @@ namespace Structs
 				ReAlloc();
 			}
 
-			if (!IsEmpty())
+			if (IsEmpty())
+			{
+				lastElementIndex = firstElementIndex;
+			}
+			else
 			{
 				++lastElementIndex;
 
@@ -198,40 +207,81 @@ namespace Structs
 			return elements[firstElementIndex];
 		}
 
-		bool Contains(const T& value)
+		bool Contains(const T& value) const
 		{
-			size_t elementIndex = firstElementIndex;
+			return IndexOf(value) != NotFound;
+		}
+
+		// The position of the first element equal to value, counting from the front, or NotFound.
+		size_t IndexOf(const T& value) const
+		{
+			size_t index = Scan::IndexOf(GetFrontSpan(), value);
 
-			for (size_t i = 0; i < size; ++i)
+			if (index != NotFound)
 			{
-				if (elementIndex >= capacity)
-				{
-					elementIndex -= capacity;
-				}
-				
-				if (elements[elementIndex] == value)
-				{
-					return true;
-				}
+				return index;
+			}
+
+			index = Scan::IndexOf(GetBackSpan(), value);
+			return index == NotFound ? NotFound : GetFrontSpan().GetSize() + index;
+		}
+
+		size_t Count(const T& value) const
+		{
+			return Scan::Count(GetFrontSpan(), value) + Scan::Count(GetBackSpan(), value);
+		}
+
+		T Min() const
+		{
+			if (IsEmpty())
+			{
+				throw std::out_of_range("Queue is empty");
+			}
+
+			T min = Scan::Min(GetFrontSpan());
+			Span<const T> back = GetBackSpan();
 
-				++elementIndex;
+			return back.IsEmpty() ? min : Scan::Smallest::Combine(min, Scan::Min(back));
+		}
+
+		T Max() const
+		{
+			if (IsEmpty())
+			{
+				throw std::out_of_range("Queue is empty");
 			}
 
-			return false;
+			T max = Scan::Max(GetFrontSpan());
+			Span<const T> back = GetBackSpan();
+
+			return back.IsEmpty() ? max : Scan::Largest::Combine(max, Scan::Max(back));
+		}
+
+		// The sum of the elements, or a value-initialized T when there are none.
+		T Sum() const
+		{
+			return Scan::Total::Combine(Scan::Sum(GetFrontSpan()), Scan::Sum(GetBackSpan()));
 		}
 
 		virtual void Clear() override
 		{
 			size = 0;
 			firstElementIndex = 0;
-			lastElementIndex = -1;
+			lastElementIndex = 0;
 		}
 
 	private:
-		void AddElement(size_t index)
+		// The ring buffer holds the elements in at most two runs: from the front up to the end of
+		// the buffer, then whatever wrapped around to its start.
+		Span<const T> GetFrontSpan() const
 		{
-			elements[index] = value;
-			++size;
+			size_t count = capacity - firstElementIndex < size ? capacity - firstElementIndex : size;
+			return Span<const T>(elements + firstElementIndex, count);
+		}
+
+		Span<const T> GetBackSpan() const
+		{
+			return Span<const T>(elements, size - GetFrontSpan().GetSize());
 		}
 
 		void ReAlloc()
@@ -0,0 +1,436 @@
+#pragma once
+#include "Span.h"
+#include "../Memory/Simd.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Structs
+{
+	// Linear scans over contiguous elements. Spans of int32_t, int64_t, float and double are
+	// scanned several elements per instruction with the widest of AVX2 or SSE2 the compiler
+	// targets; any other element type, or a build without either, takes a plain loop.
+	namespace Scan
+	{
+		constexpr size_t NotFound = static_cast<size_t>(-1);
+
+		// How many registers a loop works on at once, to hide the latency of each instruction.
+		constexpr size_t Unroll = 4;
+
+		template<typename T>
+		struct Lanes
+		{
+			static constexpr bool IsVectorized = false;
+			static constexpr bool HasOrdering = false;
+		};
+
+#if defined(STRUCTS_AVX2)
+		template<>
+		struct Lanes<int32_t>
+		{
+			using Register = __m256i;
+			static constexpr size_t Count = 8;
+			static constexpr bool IsVectorized = true;
+			static constexpr bool HasOrdering = true;
+
+			static Register Load(const int32_t* elements) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(elements)); }
+			static void Store(int32_t* elements, Register r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(elements), r); }
+			static Register Broadcast(int32_t value) { return _mm256_set1_epi32(value); }
+			static uint32_t MatchMask(Register a, Register b) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))); }
+			static Register Min(Register a, Register b) { return _mm256_min_epi32(a, b); }
+			static Register Max(Register a, Register b) { return _mm256_max_epi32(a, b); }
+			static Register Add(Register a, Register b) { return _mm256_add_epi32(a, b); }
+		};
+
+		template<>
+		struct Lanes<int64_t>
+		{
+			using Register = __m256i;
+			static constexpr size_t Count = 4;
+			static constexpr bool IsVectorized = true;
+			static constexpr bool HasOrdering = true;
+
+			static Register Load(const int64_t* elements) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(elements)); }
+			static void Store(int64_t* elements, Register r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(elements), r); }
+			static Register Broadcast(int64_t value) { return _mm256_set1_epi64x(value); }
+			static uint32_t MatchMask(Register a, Register b) { return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)))); }
+			static Register Min(Register a, Register b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+			static Register Max(Register a, Register b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a)); }
+			static Register Add(Register a, Register b) { return _mm256_add_epi64(a, b); }
+		};
+
+		template<>
+		struct Lanes<float>
+		{
+			using Register = __m256;
+			static constexpr size_t Count = 8;
+			static constexpr bool IsVectorized = true;
+			static constexpr bool HasOrdering = true;
+
+			static Register Load(const float* elements) { return _mm256_loadu_ps(elements); }
+			static void Store(float* elements, Register r) { _mm256_storeu_ps(elements, r); }
+			static Register Broadcast(float value) { return _mm256_set1_ps(value); }
+			static uint32_t MatchMask(Register a, Register b) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+			static Register Min(Register a, Register b) { return _mm256_min_ps(a, b); }
+			static Register Max(Register a, Register b) { return _mm256_max_ps(a, b); }
+			static Register Add(Register a, Register b) { return _mm256_add_ps(a, b); }
+		};
+
+		template<>
+		struct Lanes<double>
+		{
+			using Register = __m256d;
+			static constexpr size_t Count = 4;
+			static constexpr bool IsVectorized = true;
+			static constexpr bool HasOrdering = true;
+
+			static Register Load(const double* elements) { return _mm256_loadu_pd(elements); }
+			static void Store(double* elements, Register r) { _mm256_storeu_pd(elements, r); }
+			static Register Broadcast(double value) { return _mm256_set1_pd(value); }
+			static uint32_t MatchMask(Register a, Register b) { return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+			static Register Min(Register a, Register b) { return _mm256_min_pd(a, b); }
+			static Register Max(Register a, Register b) { return _mm256_max_pd(a, b); }
+			static Register Add(Register a, Register b) { return _mm256_add_pd(a, b); }
+		};
+#elif defined(STRUCTS_SSE2)
+		// SSE2 has no signed 32-bit minimum or maximum, so those select through a compare.
+		template<>
+		struct Lanes<int32_t>
+		{
+			using Register = __m128i;
+			static constexpr size_t Count = 4;
+			static constexpr bool IsVectorized = true;
+			static constexpr bool HasOrdering = true;
+
+			static Register Load(const int32_t* elements) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(elements)); }
+			static void Store(int32_t* elements, Register r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(elements), r); }
+			static Register Broadcast(int32_t value) { return _mm_set1_epi32(value); }
+			static uint32_t MatchMask(Register a, Register b) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+			static Register Min(Register a, Register b) { return Select(_mm_cmpgt_epi32(a, b), b, a); }
+			static Register Max(Register a, Register b) { return Select(_mm_cmpgt_epi32(b, a), b, a); }
+			static Register Add(Register a, Register b) { return _mm_add_epi32(a, b); }
+
+		private:
+			static Register Select(Register mask, Register ifSet, Register ifClear)
+			{
+				return _mm_or_si128(_mm_and_si128(mask, ifSet), _mm_andnot_si128(mask, ifClear));
+			}
+		};
+
+		// Nor does it compare 64-bit integers: equality pairs up the halves of a 32-bit compare,
+		// and ordering is left to the plain loop.
+		template<>
+		struct Lanes<int64_t>
+		{
+			using Register = __m128i;
+			static constexpr size_t Count = 2;
+			static constexpr bool IsVectorized = true;
+			static constexpr bool HasOrdering = false;
+
+			static Register Load(const int64_t* elements) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(elements)); }
+			static void Store(int64_t* elements, Register r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(elements), r); }
+			static Register Broadcast(int64_t value) { return _mm_set1_epi64x(value); }
+			static Register Add(Register a, Register b) { return _mm_add_epi64(a, b); }
+
+			static uint32_t MatchMask(Register a, Register b)
+			{
+				__m128i halves = _mm_cmpeq_epi32(a, b);
+				__m128i both = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+				return static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(both)));
+			}
+		};
+
+		template<>
+		struct Lanes<float>
+		{
+			using Register = __m128;
+			static constexpr size_t Count = 4;
+			static constexpr bool IsVectorized = true;
+			static constexpr bool HasOrdering = true;
+
+			static Register Load(const float* elements) { return _mm_loadu_ps(elements); }
+			static void Store(float* elements, Register r) { _mm_storeu_ps(elements, r); }
+			static Register Broadcast(float value) { return _mm_set1_ps(value); }
+			static uint32_t MatchMask(Register a, Register b) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+			static Register Min(Register a, Register b) { return _mm_min_ps(a, b); }
+			static Register Max(Register a, Register b) { return _mm_max_ps(a, b); }
+			static Register Add(Register a, Register b) { return _mm_add_ps(a, b); }
+		};
+
+		template<>
+		struct Lanes<double>
+		{
+			using Register = __m128d;
+			static constexpr size_t Count = 2;
+			static constexpr bool IsVectorized = true;
+			static constexpr bool HasOrdering = true;
+
+			static Register Load(const double* elements) { return _mm_loadu_pd(elements); }
+			static void Store(double* elements, Register r) { _mm_storeu_pd(elements, r); }
+			static Register Broadcast(double value) { return _mm_set1_pd(value); }
+			static uint32_t MatchMask(Register a, Register b) { return static_cast<uint32_t>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+			static Register Min(Register a, Register b) { return _mm_min_pd(a, b); }
+			static Register Max(Register a, Register b) { return _mm_max_pd(a, b); }
+			static Register Add(Register a, Register b) { return _mm_add_pd(a, b); }
+		};
+#endif
+
+		template<typename T>
+		using IsVectorized = std::integral_constant<bool, Lanes<T>::IsVectorized>;
+
+		template<typename T>
+		using HasVectorizedOrdering = std::integral_constant<bool, Lanes<T>::HasOrdering>;
+
+		inline size_t CountBits(uint32_t mask)
+		{
+			mask = mask - ((mask >> 1) & 0x55555555u);
+			mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+			return static_cast<size_t>((((mask + (mask >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+		}
+
+		// Which of the Unroll registers starting at elements equal the broadcast value, one bit
+		// per element in order.
+		template<typename T>
+		uint32_t MatchBlock(const T* elements, typename Lanes<T>::Register value)
+		{
+			using L = Lanes<T>;
+
+			return L::MatchMask(L::Load(elements), value)
+				| L::MatchMask(L::Load(elements + L::Count), value) << L::Count
+				| L::MatchMask(L::Load(elements + L::Count * 2), value) << L::Count * 2
+				| L::MatchMask(L::Load(elements + L::Count * 3), value) << L::Count * 3;
+		}
+
+		template<typename T>
+		size_t IndexOf(const T* elements, size_t count, const T& value, std::false_type)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (elements[i] == value)
+				{
+					return i;
+				}
+			}
+
+			return NotFound;
+		}
+
+		template<typename T>
+		size_t IndexOf(const T* elements, size_t count, const T& value, std::true_type)
+		{
+			using L = Lanes<T>;
+			constexpr size_t Step = L::Count * Unroll;
+
+			typename L::Register broadcast = L::Broadcast(value);
+			size_t i = 0;
+
+			for (; i + Step <= count; i += Step)
+			{
+				uint32_t mask = MatchBlock(elements + i, broadcast);
+
+				if (mask != 0)
+				{
+					return i + Simd::CountTrailingZeros(mask);
+				}
+			}
+
+			size_t index = IndexOf(elements + i, count - i, value, std::false_type());
+			return index == NotFound ? NotFound : i + index;
+		}
+
+		template<typename T>
+		size_t Count(const T* elements, size_t count, const T& value, std::false_type)
+		{
+			size_t matches = 0;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (elements[i] == value)
+				{
+					++matches;
+				}
+			}
+
+			return matches;
+		}
+
+		template<typename T>
+		size_t Count(const T* elements, size_t count, const T& value, std::true_type)
+		{
+			using L = Lanes<T>;
+			constexpr size_t Step = L::Count * Unroll;
+
+			typename L::Register broadcast = L::Broadcast(value);
+			size_t matches = 0;
+			size_t i = 0;
+
+			for (; i + Step <= count; i += Step)
+			{
+				matches += CountBits(MatchBlock(elements + i, broadcast));
+			}
+
+			return matches + Count(elements + i, count - i, value, std::false_type());
+		}
+
+		// Signed integers add through their unsigned type, so a sum that overflows wraps around
+		// like the vector lanes do instead of being undefined.
+		template<typename T>
+		T Add(const T& a, const T& b, std::true_type)
+		{
+			using Unsigned = std::make_unsigned_t<T>;
+			return static_cast<T>(static_cast<Unsigned>(a) + static_cast<Unsigned>(b));
+		}
+
+		template<typename T>
+		T Add(const T& a, const T& b, std::false_type)
+		{
+			return a + b;
+		}
+
+		struct Smallest
+		{
+			template<typename T>
+			static T Combine(const T& a, const T& b) { return b < a ? b : a; }
+
+			template<typename L, typename Register>
+			static Register CombineLanes(Register a, Register b) { return L::Min(a, b); }
+		};
+
+		struct Largest
+		{
+			template<typename T>
+			static T Combine(const T& a, const T& b) { return a < b ? b : a; }
+
+			template<typename L, typename Register>
+			static Register CombineLanes(Register a, Register b) { return L::Max(a, b); }
+		};
+
+		struct Total
+		{
+			template<typename T>
+			static T Combine(const T& a, const T& b) { return Add(a, b, std::integral_constant<bool, std::is_integral<T>::value && std::is_signed<T>::value>()); }
+
+			template<typename L, typename Register>
+			static Register CombineLanes(Register a, Register b) { return L::Add(a, b); }
+		};
+
+		// Combines count elements, at least one, from the first onwards.
+		template<typename Operation, typename T>
+		T Fold(const T* elements, size_t count, std::false_type)
+		{
+			T result = elements[0];
+
+			for (size_t i = 1; i < count; ++i)
+			{
+				result = Operation::Combine(result, elements[i]);
+			}
+
+			return result;
+		}
+
+		// Each register folds its own share of the elements, in a different order than the loop
+		// would: the same result for integers, but not always for floating point sums.
+		template<typename Operation, typename T>
+		T Fold(const T* elements, size_t count, std::true_type)
+		{
+			using L = Lanes<T>;
+			constexpr size_t Step = L::Count * Unroll;
+
+			if (count < Step)
+			{
+				return Fold<Operation>(elements, count, std::false_type());
+			}
+
+			typename L::Register r0 = L::Load(elements);
+			typename L::Register r1 = L::Load(elements + L::Count);
+			typename L::Register r2 = L::Load(elements + L::Count * 2);
+			typename L::Register r3 = L::Load(elements + L::Count * 3);
+			size_t i = Step;
+
+			for (; i + Step <= count; i += Step)
+			{
+				r0 = Operation::template CombineLanes<L>(r0, L::Load(elements + i));
+				r1 = Operation::template CombineLanes<L>(r1, L::Load(elements + i + L::Count));
+				r2 = Operation::template CombineLanes<L>(r2, L::Load(elements + i + L::Count * 2));
+				r3 = Operation::template CombineLanes<L>(r3, L::Load(elements + i + L::Count * 3));
+			}
+
+			r0 = Operation::template CombineLanes<L>(Operation::template CombineLanes<L>(r0, r1), Operation::template CombineLanes<L>(r2, r3));
+
+			T lanes[L::Count];
+			L::Store(lanes, r0);
+
+			T result = Fold<Operation>(lanes, L::Count, std::false_type());
+
+			for (; i < count; ++i)
+			{
+				result = Operation::Combine(result, elements[i]);
+			}
+
+			return result;
+		}
+
+		template<typename T>
+		size_t IndexOf(Span<T> span, const std::remove_const_t<T>& value)
+		{
+			using Element = std::remove_const_t<T>;
+			return IndexOf<Element>(span.GetData(), span.GetSize(), value, IsVectorized<Element>());
+		}
+
+		template<typename T>
+		bool Contains(Span<T> span, const std::remove_const_t<T>& value)
+		{
+			return IndexOf(span, value) != NotFound;
+		}
+
+		template<typename T>
+		size_t Count(Span<T> span, const std::remove_const_t<T>& value)
+		{
+			using Element = std::remove_const_t<T>;
+			return Count<Element>(span.GetData(), span.GetSize(), value, IsVectorized<Element>());
+		}
+
+		// The smallest element by operator<. Which one comes back when a floating point span
+		// holds a NaN is unspecified.
+		template<typename T>
+		std::remove_const_t<T> Min(Span<T> span)
+		{
+			using Element = std::remove_const_t<T>;
+
+			if (span.IsEmpty())
+			{
+				throw std::out_of_range("Span is empty");
+			}
+
+			return Fold<Smallest, Element>(span.GetData(), span.GetSize(), HasVectorizedOrdering<Element>());
+		}
+
+		template<typename T>
+		std::remove_const_t<T> Max(Span<T> span)
+		{
+			using Element = std::remove_const_t<T>;
+
+			if (span.IsEmpty())
+			{
+				throw std::out_of_range("Span is empty");
+			}
+
+			return Fold<Largest, Element>(span.GetData(), span.GetSize(), HasVectorizedOrdering<Element>());
+		}
+
+		// The sum of the elements, or a value-initialized one for an empty span.
+		template<typename T>
+		std::remove_const_t<T> Sum(Span<T> span)
+		{
+			using Element = std::remove_const_t<T>;
+
+			if (span.IsEmpty())
+			{
+				return Element();
+			}
+
+			return Fold<Total, Element>(span.GetData(), span.GetSize(), IsVectorized<Element>());
+		}
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Vector.h"
+#include <type_traits>
+
+namespace Structs
+{
+	// A vector that keeps its first N elements inside the object and only allocates once it
+	// holds more, for the many vectors that stay small.
+	template <typename T, size_t N>
+	class SmallVector final : public VectorBase<T>
+	{
+	private:
+		static_assert(N > 0, "A SmallVector without inline elements is a Vector");
+
+		// Inline elements are relocated one by one, which copies those whose move might throw.
+		static constexpr bool IsNothrowMovable = std::is_nothrow_move_constructible<T>::value || Memory::IsTriviallyRelocatable<T>::value;
+
+	public:
+		SmallVector()
+			: VectorBase<T>(reinterpret_cast<T*>(inlineStorage), N)
+		{}
+
+		SmallVector(SmallVector&& vector) noexcept(IsNothrowMovable)
+			: VectorBase<T>(reinterpret_cast<T*>(inlineStorage), N)
+		{
+			this->MoveFrom(vector);
+		}
+
+		SmallVector& operator=(SmallVector&& vector) noexcept(IsNothrowMovable)
+		{
+			this->MoveFrom(vector);
+			return *this;
+		}
+
+		// The elements are destroyed here, while the inline buffer they may live in still exists.
+		~SmallVector()
+		{
+			this->Free();
+		}
+
+	public:
+		bool IsInline() const { return this->UsesInlineElements(); }
+
+	private:
+		alignas(T) unsigned char inlineStorage[N * sizeof(T)];
+	};
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace Structs
+{
+	// A view of elements that lie next to each other in memory, owned by someone else. It stays
+	// valid until the owner moves or frees those elements.
+	template <typename T>
+	class Span final
+	{
+	public:
+		Span()
+			: elements(nullptr), size(0)
+		{}
+
+		Span(T* elements, size_t size)
+			: elements(elements), size(size)
+		{}
+
+		// A span of mutable elements is also a span of const ones.
+		template <typename U, typename = std::enable_if_t<std::is_convertible<U(*)[], T(*)[]>::value>>
+		Span(const Span<U>& span)
+			: elements(span.GetData()), size(span.GetSize())
+		{}
+
+	public:
+		T& operator[](size_t index) const
+		{
+			return elements[index];
+		}
+
+		T& At(size_t index) const
+		{
+			if (index >= size)
+			{
+				throw std::out_of_range(std::to_string(index));
+			}
+
+			return elements[index];
+		}
+
+		Span Subspan(size_t offset, size_t count) const
+		{
+			if (offset > size || count > size - offset)
+			{
+				throw std::out_of_range(std::to_string(offset));
+			}
+
+			return Span(elements + offset, count);
+		}
+
+	public:
+		T* GetData() const { return elements; }
+		size_t GetSize() const { return size; }
+		bool IsEmpty() const { return size == 0; }
+
+	public:
+		T* begin() const
+		{
+			return elements;
+		}
+
+		T* end() const
+		{
+			return elements + size;
+		}
+
+	private:
+		T* elements;
+		size_t size;
+	};
+}
@@ -1,8 +1,13 @@
 #pragma once
 #include "../Collection/ICollection.h"
 #include "../Collection/IIterable.h"
+#include "../Memory/Uninitialized.h"
+#include "Scan.h"
+#include "Span.h"
 #include "Vector.h"
+#include <new>
 #include <stdexcept>
+#include <utility>
 
 namespace Structs
 {
@@ -11,20 +16,19 @@ namespace Structs
 	{
 	public:
 		using Iterator = VectorIterator<T>;
+		static constexpr size_t NotFound = Scan::NotFound;
 
 	public:
 		Stack()
 			: elements(nullptr), size(0), capacity(0)
-		{
-			ReAlloc(5);
-		}
+		{}
 
 		Stack(const Stack& vector) = delete;
 		Stack& operator=(const Stack& vector) = delete;
 
 		Stack(Stack&& vector) noexcept
 			:
-			elements(std::move(vector.elements)),
+			elements(vector.elements),
 			capacity(vector.capacity),
 			size(vector.size)
 		{
@@ -35,36 +39,40 @@ namespace Structs
 
 		Stack& operator=(Stack&& vector) noexcept
 		{
-			elements = std::move(vector.elements);
+			Free();
+
+			elements = vector.elements;
 			capacity = vector.capacity;
 			size = vector.size;
 
 			vector.elements = nullptr;
 			vector.capacity = 0;
 			vector.size = 0;
+
+			return *this;
 		}
 
 		~Stack()
 		{
-			if (elements == nullptr)
-				return;
-
-			delete[] elements;
-
-			elements = nullptr;
-			capacity = 0;
-			size = 0;
+			Free();
 		}
 
 	public:
 		void Push(const T& value)
 		{
-			if (size >= capacity)
+			if (size < capacity)
 			{
-				ReAlloc();
+				new (&elements[size]) T(value);
+				++size;
+				return;
 			}
 
-			elements[size] = value;
+			size_t newCapacity = capacity == 0 ? InitialCapacity : capacity * 2;
+			T* newElements = Memory::RelocateAndEmplace(elements, size, newCapacity, value);
+
+			Memory::Deallocate(elements);
+			elements = newElements;
+			capacity = newCapacity;
 			++size;
 		}
 
@@ -78,66 +86,118 @@ namespace Structs
 			return elements[size - 1];
 		}
 
-		T& Pop()
+		T Pop()
 		{
 			if (IsEmpty())
 			{
 				throw std::out_of_range("Stack is empty");
 			}
 
-			T temp = elements[size - 1];
+			T temp = std::move(elements[size - 1]);
+			elements[size - 1].~T();
 			--size;
 
 			return temp;
 		}
 
-		bool Contains(const T& value)
+		bool Contains(const T& value) const
 		{
-			for (size_t i = 0; i < size; ++i)
+			return Scan::Contains(Span<const T>(elements, size), value);
+		}
+
+		// The position of the first element equal to value, or NotFound.
+		size_t IndexOf(const T& value) const
+		{
+			return Scan::IndexOf(Span<const T>(elements, size), value);
+		}
+
+		size_t Count(const T& value) const
+		{
+			return Scan::Count(Span<const T>(elements, size), value);
+		}
+
+		T Min() const
+		{
+			if (IsEmpty())
 			{
-				if (elements[i] == value)
-				{
-					return true;
-				}
+				throw std::out_of_range("Stack is empty");
 			}
 
-			return false;
+			return Scan::Min(Span<const T>(elements, size));
+		}
+
+		T Max() const
+		{
+			if (IsEmpty())
+			{
+				throw std::out_of_range("Stack is empty");
+			}
+
+			return Scan::Max(Span<const T>(elements, size));
+		}
+
+		// The sum of the elements, or a value-initialized T when there are none.
+		T Sum() const
+		{
+			return Scan::Sum(Span<const T>(elements, size));
 		}
 
 		virtual void Clear() override
 		{
+			Memory::Destroy(elements, size);
 			size = 0;
 		}
 
-	private:
-		void ReAlloc()
+		void Reserve(size_t count)
 		{
-			size_t newCapacity = capacity * 2;
-			ReAlloc(newCapacity);
+			if (count > capacity)
+			{
+				ReAlloc(count);
+			}
 		}
 
+		void ShrinkToFit()
+		{
+			if (capacity > size)
+			{
+				ReAlloc(size);
+			}
+		}
+
+	private:
 		void ReAlloc(size_t newCapacity)
 		{
-			T* newElements = new T[newCapacity];
+			T* newElements = Memory::Allocate<T>(newCapacity);
 
-			if (newCapacity < size)
+			try
 			{
-				size = newCapacity;
+				Memory::Relocate(elements, size, newElements);
 			}
-
-			if (elements != nullptr)
+			catch (...)
 			{
-				std::copy(&elements[0], &elements[size], newElements);
-				delete[] elements;
+				Memory::Deallocate(newElements);
+				throw;
 			}
 
+			Memory::Deallocate(elements);
 			elements = newElements;
 			capacity = newCapacity;
 		}
 
+		void Free()
+		{
+			Memory::Destroy(elements, size);
+			Memory::Deallocate(elements);
+
+			elements = nullptr;
+			capacity = 0;
+			size = 0;
+		}
+
 	public:
 		virtual size_t GetSize() const override { return size; }
 		virtual bool IsEmpty() const override { return size == 0; }
+		size_t GetCapacity() const { return capacity; }
 
 	public:
 		virtual Iterator begin() const override
@@ -147,9 +207,12 @@ namespace Structs
 
 		virtual Iterator end() const override
 		{
-			return Iterator(&elements[size]);
+			return Iterator(elements + size);
 		};
 
+	private:
+		static constexpr size_t InitialCapacity = 5;
+
 	private:
 		size_t size;
 		size_t capacity;
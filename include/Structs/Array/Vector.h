@@ -1,7 +1,16 @@
 #pragma once
 #include "../Collection/ICollection.h"
 #include "../Collection/IIterable.h"
+#include "../Memory/Uninitialized.h"
+#include "Scan.h"
+#include "Span.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace Structs
 {
@@ -64,160 +73,525 @@ namespace Structs
 		T* element;
 	};
 
+	// Elements live in raw storage and are constructed only when added, so growing moves
+	// the existing ones over without constructing the free slots behind them. The storage
+	// starts out as a buffer the derived class may provide, which is never freed, and moves
+	// to the heap once it is full. Code that does not care how big that buffer is can take
+	// any vector of T as a VectorBase<T>.
 	template <typename T>
-	class Vector final : public IIterable<T, VectorIterator<T>>, public ICollection
+	class VectorBase : public IIterable<T, VectorIterator<T>>, public ICollection
 	{
 	public:
 		using Iterator = VectorIterator<T>;
+		static constexpr size_t NotFound = Scan::NotFound;
+
+	protected:
+		VectorBase(T* inlineElements, size_t inlineCapacity)
+			: size(0), capacity(inlineCapacity), elements(inlineElements), inlineElements(inlineElements), inlineCapacity(inlineCapacity)
+		{}
 
 	public:
-		Vector()
-			: elements(nullptr), size(0), capacity(0)
+		VectorBase(const VectorBase& vector) = delete;
+		VectorBase& operator=(const VectorBase& vector) = delete;
+
+		~VectorBase()
 		{
-			ReAlloc(5);
+			Free();
 		}
 
-		Vector(const Vector& vector) = delete;
-		Vector& operator=(const Vector& vector) = delete;
+	public:
+		void Add(const T& value)
+		{
+			EmplaceAtEnd(value);
+		}
 
-		Vector(Vector&& vector) noexcept
-			:
-			elements(std::move(vector.elements)),
-			capacity(vector.capacity),
-			size(vector.size)
+		void Add(T&& value)
 		{
-			vector.elements = nullptr;
-			vector.capacity = 0;
-			vector.size = 0;
+			EmplaceAtEnd(std::move(value));
 		}
 
-		Vector& operator=(Vector&& vector) noexcept
+		template<typename... Args>
+		T& EmplaceBack(Args&&... args)
 		{
-			elements = std::move(vector.elements);
-			capacity = vector.capacity;
-			size = vector.size;
+			return EmplaceAtEnd(std::forward<Args>(args)...);
+		}
 
-			vector.elements = nullptr;
-			vector.capacity = 0;
-			vector.size = 0;
+		// Appends a range, growing at most once when its length is known up front. The range
+		// must not refer to elements of the vector. If an element fails to copy, none is added.
+		template<typename InputIterator>
+		void AddRange(InputIterator first, InputIterator last)
+		{
+			AddRange(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
 		}
 
-		~Vector()
+		void Insert(const T& value, size_t index)
 		{
-			if (elements == nullptr)
+			if (index > size)
+			{
+				throw std::out_of_range(std::to_string(index));
+			}
+
+			if (index == size)
+			{
+				EmplaceAtEnd(value);
 				return;
+			}
 
-			delete[] elements;
+			// The value may be one of the elements that are about to move.
+			T item(value);
 
-			elements = nullptr;
-			capacity = 0;
-			size = 0;
-		}
-
-	public:
-		void Add(const T& value)
-		{
 			if (size >= capacity)
 			{
-				ReAlloc();
+				ReAlloc(GetGrownCapacity());
 			}
 
-			elements[size] = value;
+			Memory::RelocateOverlapping(&elements[index], size - index, &elements[index + 1]);
+			new (&elements[index]) T(std::move(item));
 			++size;
 		}
 
-		void Insert(const T& value, size_t index)
+		// Inserts a range before index, growing at most once and moving the tail aside in one
+		// go. The range must not refer to elements of the vector. If an element fails to copy,
+		// the vector is left as it was.
+		template<typename ForwardIterator>
+		void InsertRange(size_t index, ForwardIterator first, ForwardIterator last)
 		{
-			if (index < 0 || index > size)
+			if (index > size)
 			{
 				throw std::out_of_range(std::to_string(index));
 			}
 
-			if (size >= capacity)
+			size_t count = static_cast<size_t>(std::distance(first, last));
+
+			if (count == 0)
 			{
-				ReAlloc();
+				return;
 			}
 
-			for (size_t i = size - 1; i >= index; --i)
+			ReserveForAdding(count);
+			Memory::RelocateOverlapping(&elements[index], size - index, &elements[index + count]);
+
+			try
+			{
+				std::uninitialized_copy(first, last, &elements[index]);
+			}
+			catch (...)
 			{
-				elements[i + 1] = std::move(elements[i]);
+				Memory::RelocateOverlapping(&elements[index + count], size - index, &elements[index]);
+				throw;
 			}
 
-			elements[index] = value;
-			++size;
+			size += count;
 		}
 
 		void Remove(const T& value)
 		{
-			for (size_t i = 0; i < size; ++i)
+			size_t index = IndexOf(value);
+
+			if (index == NotFound)
 			{
-				if (elements[i] == value)
-				{
-					RemoveAt(i);
-					return;
-				}
+				throw std::out_of_range("Value not in range");
 			}
 
-			throw std::out_of_range("Value not in range");
+			RemoveAt(index);
 		}
 
 		void RemoveAt(size_t index)
 		{
-			if (index < 0 || index >= size)
+			if (index >= size)
 			{
 				throw std::out_of_range(std::to_string(index));
 			}
 
-			for (size_t i = index; i < size - 1; ++i)
+			elements[index].~T();
+			Memory::RelocateOverlapping(&elements[index + 1], size - index - 1, &elements[index]);
+			--size;
+		}
+
+		// Removes the element at index by moving the last one into its place, so the order of
+		// the elements is not kept.
+		void SwapRemoveAt(size_t index)
+		{
+			if (index >= size)
 			{
-				elements[i] = std::move(elements[i + 1]);
+				throw std::out_of_range(std::to_string(index));
+			}
+
+			elements[index].~T();
+
+			if (index != size - 1)
+			{
+				Memory::RelocateOverlapping(&elements[size - 1], 1, &elements[index]);
 			}
 
 			--size;
 		}
 
-		bool Contains(const T& value)
+		// Removes every element the predicate holds for, keeping the order of the rest, and
+		// returns how many were removed. Each survivor moves at most once. If the predicate
+		// throws, the elements it has already picked are removed and the others stay.
+		template<typename Predicate>
+		size_t RemoveIf(Predicate predicate)
+		{
+			return RemoveIfFrom(0, predicate);
+		}
+
+		size_t RemoveAll(const T& value)
+		{
+			if (&value >= elements && &value < elements + size)
+			{
+				T item(value);
+				return RemoveAll(item);
+			}
+
+			size_t first = IndexOf(value);
+
+			if (first == NotFound)
+			{
+				return 0;
+			}
+
+			auto equal = [&value](const T& element) { return element == value; };
+			return RemoveIfFrom(first, equal);
+		}
+
+		// Removes the elements at the given positions, which must be in ascending order; repeated
+		// ones are removed once. Returns how many were removed. Throws before removing anything
+		// if the positions are out of order or out of range.
+		size_t RemoveAtIndices(Span<const size_t> indices)
 		{
-			for (size_t i = 0; i < size; ++i)
+			for (size_t i = 0; i < indices.GetSize(); ++i)
 			{
-				if (elements[i] == value)
+				if (indices[i] >= size)
+				{
+					throw std::out_of_range(std::to_string(indices[i]));
+				}
+
+				if (i != 0 && indices[i] < indices[i - 1])
 				{
-					return true;
+					throw std::invalid_argument("Indices are not sorted");
 				}
 			}
 
-			return false;
+			size_t kept = 0;
+			size_t next = 0;
+
+			for (size_t index : indices)
+			{
+				if (index < next)
+				{
+					continue;
+				}
+
+				kept = MoveDownBefore(kept, next, index);
+				elements[index].~T();
+				next = index + 1;
+			}
+
+			return CloseGap(kept, next);
+		}
+
+		bool Contains(const T& value) const
+		{
+			return Scan::Contains(Span<const T>(elements, size), value);
+		}
+
+		// The position of the first element equal to value, or NotFound.
+		size_t IndexOf(const T& value) const
+		{
+			return Scan::IndexOf(Span<const T>(elements, size), value);
+		}
+
+		size_t Count(const T& value) const
+		{
+			return Scan::Count(Span<const T>(elements, size), value);
+		}
+
+		T Min() const
+		{
+			if (IsEmpty())
+			{
+				throw std::out_of_range("Vector is empty");
+			}
+
+			return Scan::Min(Span<const T>(elements, size));
+		}
+
+		T Max() const
+		{
+			if (IsEmpty())
+			{
+				throw std::out_of_range("Vector is empty");
+			}
+
+			return Scan::Max(Span<const T>(elements, size));
+		}
+
+		// The sum of the elements, or a value-initialized T when there are none.
+		T Sum() const
+		{
+			return Scan::Sum(Span<const T>(elements, size));
 		}
 
 		virtual void Clear() override
 		{
+			Memory::Destroy(elements, size);
 			size = 0;
 		}
 
+		void Reserve(size_t count)
+		{
+			if (count > capacity)
+			{
+				ReAlloc(count);
+			}
+		}
+
+		void ShrinkToFit()
+		{
+			if (capacity > size)
+			{
+				ReAlloc(size);
+			}
+		}
+
+		// Removes the elements past count, or adds value-initialized ones up to it.
+		void Resize(size_t count)
+		{
+			ResizeWith(count, [](T* element) { new (element) T(); });
+		}
+
+		void Resize(size_t count, const T& value)
+		{
+			if (count > capacity && &value >= elements && &value < elements + size)
+			{
+				T item(value);
+				Resize(count, item);
+				return;
+			}
+
+			ResizeWith(count, [&value](T* element) { new (element) T(value); });
+		}
+
 	private:
-		void ReAlloc()
+		template<typename InputIterator>
+		void AddRange(InputIterator first, InputIterator last, std::input_iterator_tag)
 		{
-			size_t newCapacity = capacity * 2;
-			ReAlloc(newCapacity);
+			size_t oldSize = size;
+
+			try
+			{
+				for (; first != last; ++first)
+				{
+					EmplaceAtEnd(*first);
+				}
+			}
+			catch (...)
+			{
+				Truncate(oldSize);
+				throw;
+			}
 		}
 
-		void ReAlloc(size_t newCapacity)
+		template<typename ForwardIterator>
+		void AddRange(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
 		{
-			T* newElements = new T[newCapacity];
+			size_t count = static_cast<size_t>(std::distance(first, last));
 
-			if (newCapacity < size)
+			ReserveForAdding(count);
+			std::uninitialized_copy(first, last, &elements[size]);
+			size += count;
+		}
+
+		// Grows once for count more elements, to at least the capacity a single add would grow to.
+		void ReserveForAdding(size_t count)
+		{
+			if (size + count > capacity)
 			{
-				size = newCapacity;
+				ReAlloc(std::max(GetGrownCapacity(), size + count));
 			}
+		}
 
-			if (elements != nullptr)
+		template<typename... Args>
+		T& EmplaceAtEnd(Args&&... args)
+		{
+			if (size < capacity)
 			{
-				std::copy(&elements[0], &elements[size], newElements);
-				delete[] elements;
+				new (&elements[size]) T(std::forward<Args>(args)...);
+				return elements[size++];
 			}
 
+			size_t newCapacity = GetGrownCapacity();
+			T* newElements = Memory::RelocateAndEmplace(elements, size, newCapacity, std::forward<Args>(args)...);
+
+			FreeStorage();
 			elements = newElements;
 			capacity = newCapacity;
+
+			return elements[size++];
+		}
+
+		template<typename Construct>
+		void ResizeWith(size_t count, Construct construct)
+		{
+			if (count <= size)
+			{
+				Truncate(count);
+				return;
+			}
+
+			Reserve(count);
+
+			for (; size < count; ++size)
+			{
+				construct(&elements[size]);
+			}
+		}
+
+		// Compacts in one pass: the elements before kept are the survivors so far, the slots from
+		// kept up to next are a gap left by removed ones, and the elements from next onwards are
+		// still to be looked at.
+		template<typename Predicate>
+		size_t RemoveIfFrom(size_t first, Predicate& predicate)
+		{
+			size_t kept = first;
+			size_t next = first;
+
+			try
+			{
+				for (size_t i = first; i < size; ++i)
+				{
+					if (predicate(elements[i]))
+					{
+						kept = MoveDownBefore(kept, next, i);
+						elements[i].~T();
+						next = i + 1;
+					}
+				}
+			}
+			catch (...)
+			{
+				CloseGap(kept, next);
+				throw;
+			}
+
+			return CloseGap(kept, next);
+		}
+
+		// Moves the survivors from next up to end down to kept, returning where the gap now starts.
+		size_t MoveDownBefore(size_t kept, size_t next, size_t end)
+		{
+			if (kept != next)
+			{
+				Memory::RelocateOverlapping(&elements[next], end - next, &elements[kept]);
+			}
+
+			return kept + end - next;
+		}
+
+		// Moves the remaining elements down over the gap and returns its length.
+		size_t CloseGap(size_t kept, size_t next)
+		{
+			MoveDownBefore(kept, next, size);
+			size -= next - kept;
+
+			return next - kept;
+		}
+
+		void Truncate(size_t count)
+		{
+			Memory::Destroy(&elements[count], size - count);
+			size = count;
+		}
+
+		size_t GetGrownCapacity() const
+		{
+			return capacity == 0 ? InitialCapacity : capacity * 2;
+		}
+
+		void ReAlloc(size_t newCapacity)
+		{
+			if (newCapacity < size)
+			{
+				Truncate(newCapacity);
+			}
+
+			bool toInline = newCapacity <= inlineCapacity;
+
+			if (toInline && elements == inlineElements)
+			{
+				return;
+			}
+
+			T* newElements = toInline ? inlineElements : Memory::Allocate<T>(newCapacity);
+
+			try
+			{
+				Memory::Relocate(elements, size, newElements);
+			}
+			catch (...)
+			{
+				if (!toInline)
+				{
+					Memory::Deallocate(newElements);
+				}
+
+				throw;
+			}
+
+			FreeStorage();
+			elements = newElements;
+			capacity = toInline ? inlineCapacity : newCapacity;
+		}
+
+		void FreeStorage()
+		{
+			if (elements != inlineElements)
+			{
+				Memory::Deallocate(elements);
+			}
+		}
+
+	protected:
+		bool UsesInlineElements() const { return elements == inlineElements; }
+
+		void Free()
+		{
+			Memory::Destroy(elements, size);
+			FreeStorage();
+
+			elements = inlineElements;
+			capacity = inlineCapacity;
+			size = 0;
+		}
+
+		// Takes the heap storage of another vector, or moves its elements over when they are
+		// still in its own inline buffer.
+		void MoveFrom(VectorBase& vector)
+		{
+			if (this == &vector)
+			{
+				return;
+			}
+
+			Free();
+
+			if (vector.elements != vector.inlineElements)
+			{
+				elements = vector.elements;
+				capacity = vector.capacity;
+				size = vector.size;
+
+				vector.elements = vector.inlineElements;
+				vector.capacity = vector.inlineCapacity;
+				vector.size = 0;
+				return;
+			}
+
+			Reserve(vector.size);
+			Memory::Relocate(vector.elements, vector.size, elements);
+			size = vector.size;
+			vector.size = 0;
 		}
 
 	public:
@@ -229,6 +603,7 @@ namespace Structs
 	public:
 		virtual size_t GetSize() const override { return size; }
 		virtual bool IsEmpty() const override { return size == 0; }
+		size_t GetCapacity() const { return capacity; }
 
 	public:
 		virtual Iterator begin() const override
@@ -238,12 +613,39 @@ namespace Structs
 
 		virtual Iterator end() const override
 		{
-			return Iterator(&elements[size]);
+			return Iterator(elements + size);
 		};
 
+	private:
+		static constexpr size_t InitialCapacity = 5;
+
 	private:
 		size_t size;
 		size_t capacity;
 		T* elements;
+		T* const inlineElements;
+		const size_t inlineCapacity;
+	};
+
+	// A vector that only allocates once elements are added.
+	template <typename T>
+	class Vector final : public VectorBase<T>
+	{
+	public:
+		Vector()
+			: VectorBase<T>(nullptr, 0)
+		{}
+
+		Vector(Vector&& vector) noexcept
+			: VectorBase<T>(nullptr, 0)
+		{
+			this->MoveFrom(vector);
+		}
+
+		Vector& operator=(Vector&& vector) noexcept
+		{
+			this->MoveFrom(vector);
+			return *this;
+		}
 	};
 }
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace Structs
+{
+	namespace Buckets
+	{
+		// Power-of-two bucket counts, so the index is a mask instead of a division. The hash is
+		// multiplied by 2^N / phi first and its high half folded down, so that identity hashes
+		// of sequential or strided keys still spread over every bucket.
+		struct Fibonacci
+		{
+		public:
+			static size_t GetInitialCapacity() { return 8; }
+			static size_t GetNextCapacity(size_t capacity) { return capacity * 2; }
+
+			static size_t GetCapacityFor(size_t buckets)
+			{
+				size_t capacity = GetInitialCapacity();
+
+				while (capacity < buckets)
+				{
+					capacity *= 2;
+				}
+
+				return capacity;
+			}
+
+			static size_t GetIndex(size_t hash, size_t capacity)
+			{
+				size_t product = hash * Multiplier;
+				return (product ^ (product >> HalfBits)) & (capacity - 1);
+			}
+
+		private:
+			static constexpr size_t HalfBits = sizeof(size_t) * 4;
+			static constexpr size_t Multiplier = sizeof(size_t) == 8
+				? static_cast<size_t>(11400714819323198485ull)
+				: static_cast<size_t>(2654435769ul);
+		};
+
+		// Prime bucket counts that roughly double, for hashes whose low bits are poor and must
+		// all take part in the index.
+		struct PrimeModulo
+		{
+		public:
+			static size_t GetInitialCapacity() { return Primes[0]; }
+
+			static size_t GetNextCapacity(size_t capacity)
+			{
+				for (uint32_t prime : Primes)
+				{
+					if (prime > capacity)
+					{
+						return prime;
+					}
+				}
+
+				return capacity * 2 + 1;
+			}
+
+			static size_t GetCapacityFor(size_t buckets)
+			{
+				size_t capacity = GetInitialCapacity();
+
+				while (capacity < buckets)
+				{
+					capacity = GetNextCapacity(capacity);
+				}
+
+				return capacity;
+			}
+
+			static size_t GetIndex(size_t hash, size_t capacity)
+			{
+				return hash % capacity;
+			}
+
+		private:
+			static constexpr uint32_t Primes[] =
+			{
+				5, 11, 23, 47, 97, 197, 397, 797, 1597, 3203, 6421, 12853, 25717, 51437, 102877,
+				205759, 411527, 823117, 1646237, 3292489, 6584983, 13169977, 26339969, 52679969,
+				105359939, 210719881, 421439783, 842879579, 1685759167, 3371518343u
+			};
+		};
+	}
+}
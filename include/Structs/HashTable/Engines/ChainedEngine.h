@@ -0,0 +1,894 @@
+#pragma once
+#include "../../Collection/IIterator.h"
+#include "../Parallel.h"
+#include "BucketIndex.h"
+#include "Prefetch.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Structs
+{
+	class HashTableLink
+	{
+	public:
+		explicit HashTableLink(size_t hash)
+			: hash(hash), nextIndex(0), hasNext(false)
+		{}
+
+	public:
+		size_t GetHash() const { return hash; }
+
+		void SetNextIndex(size_t value) { nextIndex = value; hasNext = true; }
+		void ResetNextIndex() { nextIndex = 0; hasNext = false; }
+		size_t GetNextIndex() const { return nextIndex; }
+
+		bool HasNext() const { return hasNext; }
+
+	private:
+		size_t hash;
+		size_t nextIndex;
+		bool hasNext;
+	};
+
+	template<typename T>
+	class BucketElement
+	{
+	public:
+		BucketElement()
+			: elementIndex(0), hasElement(false)
+		{}
+
+	public:
+		void SetElementIndex(size_t value) { elementIndex = value; hasElement = true; }
+		void ResetElementIndex() { elementIndex = 0; hasElement = false; }
+		size_t GetElementIndex() const { return elementIndex; }
+
+		bool HasElement() const { return hasElement; }
+
+	private:
+		size_t elementIndex;
+		bool hasElement;
+	};
+
+	template <typename T>
+	class HashTableIterator : public IIterator<T, HashTableIterator<T>>
+	{
+	public:
+		HashTableIterator()
+			: HashTableIterator(nullptr)
+		{}
+
+		explicit HashTableIterator(T* value)
+			: value(value)
+		{}
+
+		virtual HashTableIterator& operator++() override
+		{
+			++value;
+			return *this;
+		}
+
+		virtual HashTableIterator& operator++(int) override
+		{
+			HashTableIterator temp = *this;
+			++(*this);
+			return temp;
+		}
+
+		HashTableIterator& operator--()
+		{
+			--value;
+			return *this;
+		}
+
+		HashTableIterator& operator--(int)
+		{
+			HashTableIterator temp = *this;
+			--(*this);
+			return temp;
+		}
+
+		virtual bool operator==(const HashTableIterator& rhs) const override
+		{
+			return value == rhs.value;
+		}
+
+		virtual bool operator!=(const HashTableIterator& rhs) const override
+		{
+			return !(*this == rhs);
+		}
+
+		virtual T& operator*() const override
+		{
+			return *value;
+		}
+
+		virtual T* operator->() const override
+		{
+			return value;
+		}
+
+	private:
+		T* value;
+	};
+
+	// Values are kept densely packed in insertion order, apart from their chain links, so
+	// iteration is a contiguous scan over values only. Removing a value moves the last one
+	// into its place.
+	template<typename T, typename BucketIndex = Buckets::Fibonacci>
+	class ChainedStorage
+	{
+	private:
+		static_assert(std::is_trivially_copyable<BucketElement<T>>::value, "Buckets are allocated as zeroed memory");
+
+	public:
+		using Iterator = HashTableIterator<T>;
+		using Link = HashTableLink;
+		using Bucket = BucketElement<T>;
+
+	public:
+		ChainedStorage()
+			: ChainedStorage(0)
+		{}
+
+		explicit ChainedStorage(size_t capacity, float maxLoadFactor = DefaultMaxLoadFactor)
+			: values(nullptr), links(nullptr), buckets(nullptr), size(0), capacity(0), maxSize(0), maxLoadFactor(maxLoadFactor)
+		{
+			if (capacity != 0)
+			{
+				ReAlloc(capacity);
+			}
+		}
+
+		ChainedStorage(const ChainedStorage& storage) = delete;
+		ChainedStorage& operator=(const ChainedStorage& storage) = delete;
+
+		ChainedStorage(ChainedStorage&& storage) noexcept
+			:
+			values(storage.values),
+			links(storage.links),
+			buckets(storage.buckets),
+			size(storage.size),
+			capacity(storage.capacity),
+			maxSize(storage.maxSize),
+			maxLoadFactor(storage.maxLoadFactor)
+		{
+			storage.values = nullptr;
+			storage.links = nullptr;
+			storage.buckets = nullptr;
+			storage.size = 0;
+			storage.capacity = 0;
+			storage.maxSize = 0;
+		}
+
+		ChainedStorage& operator=(ChainedStorage&& storage) noexcept
+		{
+			Clear();
+
+			values = storage.values;
+			links = storage.links;
+			buckets = storage.buckets;
+			size = storage.size;
+			capacity = storage.capacity;
+			maxSize = storage.maxSize;
+			maxLoadFactor = storage.maxLoadFactor;
+
+			storage.values = nullptr;
+			storage.links = nullptr;
+			storage.buckets = nullptr;
+			storage.size = 0;
+			storage.capacity = 0;
+			storage.maxSize = 0;
+
+			return *this;
+		}
+
+		~ChainedStorage()
+		{
+			Clear();
+		}
+
+	public:
+		template<typename Equal, typename Create>
+		std::pair<T*, bool> FindOrInsert(size_t hash, Equal equal, Create create)
+		{
+			size_t index = FindIndex(hash, equal);
+
+			if (index != npos)
+			{
+				return { &values[index], false };
+			}
+
+			if (IsFull())
+			{
+				// create() may read a value stored here, so it runs before growing moves them.
+				T value = create();
+				ReAlloc();
+
+				auto move = [&value]() { return std::move(value); };
+				return { &Emplace(hash, move), true };
+			}
+
+			return { &Emplace(hash, create), true };
+		}
+
+		template<typename Equal>
+		bool TryRemove(size_t hash, Equal equal)
+		{
+			if (capacity == 0)
+			{
+				return false;
+			}
+
+			Bucket& bucket = GetBucketByHash(hash);
+
+			if (!bucket.HasElement())
+			{
+				return false;
+			}
+
+			size_t index = bucket.GetElementIndex();
+			Link* previous = nullptr;
+
+			while (!IsMatch(index, hash, equal))
+			{
+				if (!links[index].HasNext())
+				{
+					return false;
+				}
+
+				previous = &links[index];
+				index = links[index].GetNextIndex();
+			}
+
+			Unlink(bucket, previous, links[index]);
+			MoveLastTo(index);
+			--size;
+
+			return true;
+		}
+
+		template<typename Equal>
+		T* Find(size_t hash, Equal equal) const
+		{
+			size_t index = FindIndex(hash, equal);
+
+			if (index == npos)
+			{
+				return nullptr;
+			}
+
+			return &values[index];
+		}
+
+		// The number of chain links a lookup of the key inspects before it finds the key or gives up.
+		template<typename Equal>
+		size_t GetProbeLength(size_t hash, Equal equal) const
+		{
+			if (capacity == 0 || !GetBucketByHash(hash).HasElement())
+			{
+				return 0;
+			}
+
+			size_t index = GetBucketByHash(hash).GetElementIndex();
+			size_t length = 1;
+
+			while (!IsMatch(index, hash, equal) && links[index].HasNext())
+			{
+				index = links[index].GetNextIndex();
+				++length;
+			}
+
+			return length;
+		}
+
+		void Prefetch(size_t hash) const
+		{
+			if (capacity != 0)
+			{
+				Memory::Prefetch(&GetBucketByHash(hash));
+			}
+		}
+
+		void PrefetchEntry(size_t hash) const
+		{
+			if (capacity == 0)
+			{
+				return;
+			}
+
+			size_t index = GetBucketByHash(hash).GetElementIndex();
+			Memory::Prefetch(&links[index]);
+			Memory::Prefetch(&values[index]);
+		}
+
+		void Append(T&& value, size_t hash)
+		{
+			if (IsFull())
+			{
+				ReAlloc();
+			}
+
+			auto create = [&value]() { return std::move(value); };
+			Emplace(hash, create);
+		}
+
+		void MoveBucketTo(size_t bucketIndex, ChainedStorage& storage)
+		{
+			Bucket& bucket = buckets[bucketIndex];
+
+			while (bucket.HasElement())
+			{
+				size_t index = bucket.GetElementIndex();
+
+				storage.Append(std::move(values[index]), links[index].GetHash());
+				Unlink(bucket, nullptr, links[index]);
+				MoveLastTo(index);
+				--size;
+			}
+		}
+
+		// Fills an empty storage with count values at once, hashes[i] being the hash of the i-th.
+		// The values are partitioned by the range of buckets they land in, and every partition
+		// is filled by one thread with no locks, since its buckets, chains and slots are its own.
+		// equal(i, value) tells whether the i-th value has the key of a stored one and create(i)
+		// makes it. Returns the positions of the values left out as duplicates of earlier ones.
+		// The values are stored in partition order rather than input order.
+		template<typename Equal, typename Create>
+		std::vector<size_t> BulkInsert(const size_t* hashes, size_t count, size_t threads, Equal equal, Create create)
+		{
+			std::vector<size_t> duplicates;
+
+			if (count == 0)
+			{
+				return duplicates;
+			}
+
+			Reserve(count);
+			threads = std::max<size_t>(1, threads);
+
+			size_t partitionCount = std::min(capacity, threads * PartitionsPerThread);
+			size_t bucketsPerPartition = (capacity + partitionCount - 1) / partitionCount;
+			partitionCount = (capacity + bucketsPerPartition - 1) / bucketsPerPartition;
+
+			auto getPartition = [this, hashes, bucketsPerPartition](size_t i)
+			{
+				return BucketIndex::GetIndex(hashes[i], capacity) / bucketsPerPartition;
+			};
+
+			// Every thread counts its share of the values per partition, and then writes their
+			// hashes out partition by partition, so each partition lists them in input order.
+			std::vector<size_t> offsets(threads * partitionCount);
+			std::vector<size_t> partitionStarts(partitionCount + 1);
+			std::vector<BulkEntry> entries(count);
+
+			Parallel::Run(threads, [&](size_t thread)
+			{
+				size_t* counts = &offsets[thread * partitionCount];
+				size_t last = Parallel::GetChunkStart(thread + 1, threads, count);
+
+				for (size_t i = Parallel::GetChunkStart(thread, threads, count); i < last; ++i)
+				{
+					++counts[getPartition(i)];
+				}
+			});
+
+			size_t offset = 0;
+
+			for (size_t partition = 0; partition < partitionCount; ++partition)
+			{
+				partitionStarts[partition] = offset;
+
+				for (size_t thread = 0; thread < threads; ++thread)
+				{
+					size_t threadCount = offsets[thread * partitionCount + partition];
+					offsets[thread * partitionCount + partition] = offset;
+					offset += threadCount;
+				}
+			}
+
+			partitionStarts[partitionCount] = count;
+
+			Parallel::Run(threads, [&](size_t thread)
+			{
+				size_t* next = &offsets[thread * partitionCount];
+				size_t last = Parallel::GetChunkStart(thread + 1, threads, count);
+
+				for (size_t i = Parallel::GetChunkStart(thread, threads, count); i < last; ++i)
+				{
+					entries[next[getPartition(i)]++] = { hashes[i], i };
+				}
+			});
+
+			// Partitions are taken from a shared counter, as they are not equally full. A value
+			// goes to the next free slot of its partition unless its chain already holds the key.
+			std::vector<size_t> filled(partitionCount);
+			std::vector<std::vector<size_t>> threadDuplicates(threads);
+			std::atomic<size_t> nextPartition(0);
+
+			try
+			{
+				Parallel::Run(threads, [&](size_t thread)
+				{
+					for (size_t partition = nextPartition++; partition < partitionCount; partition = nextPartition++)
+					{
+						size_t first = partitionStarts[partition];
+						size_t slot = first;
+
+						try
+						{
+							for (size_t k = first; k < partitionStarts[partition + 1]; ++k)
+							{
+								size_t i = entries[k].position;
+								size_t hash = entries[k].hash;
+								Bucket& bucket = GetBucketByHash(hash);
+
+								auto equalValue = [&equal, i](const T& value) { return equal(i, value); };
+
+								if (ChainContains(bucket, hash, equalValue))
+								{
+									threadDuplicates[thread].push_back(i);
+									continue;
+								}
+
+								new (&values[slot]) T(create(i));
+								LinkToBucket(slot, *new (&links[slot]) Link(hash), bucket);
+								++slot;
+							}
+						}
+						catch (...)
+						{
+							filled[partition] = slot - first;
+							throw;
+						}
+
+						filled[partition] = slot - first;
+					}
+				});
+			}
+			catch (...)
+			{
+				for (size_t partition = 0; partition < partitionCount; ++partition)
+				{
+					DestroyValues(values + partitionStarts[partition], filled[partition]);
+				}
+
+				Clear();
+				throw;
+			}
+
+			for (std::vector<size_t>& positions : threadDuplicates)
+			{
+				duplicates.insert(duplicates.end(), positions.begin(), positions.end());
+			}
+
+			if (!duplicates.empty())
+			{
+				CloseGaps(partitionStarts, filled, count - duplicates.size());
+				std::sort(duplicates.begin(), duplicates.end());
+			}
+
+			size = count - duplicates.size();
+			return duplicates;
+		}
+
+		void Clear()
+		{
+			if (values == nullptr)
+				return;
+
+			DestroyValues(values, size);
+			Deallocate(values);
+			Deallocate(links);
+			DeallocateBuckets(buckets);
+
+			values = nullptr;
+			links = nullptr;
+			buckets = nullptr;
+
+			capacity = 0;
+			maxSize = 0;
+			size = 0;
+		}
+
+		void Reserve(size_t count)
+		{
+			if (count > maxSize)
+			{
+				ReAlloc(GetCapacityFor(count));
+			}
+		}
+
+		void Rehash(size_t minimumCapacity)
+		{
+			size_t newCapacity = std::max(GetCapacityFor(size), minimumCapacity == 0 ? 0 : BucketIndex::GetCapacityFor(minimumCapacity));
+
+			if (newCapacity == 0)
+			{
+				Clear();
+			}
+			else if (newCapacity != capacity)
+			{
+				ReAlloc(newCapacity);
+			}
+		}
+
+		void ShrinkToFit()
+		{
+			Rehash(0);
+		}
+
+		void SetMaxLoadFactor(float value)
+		{
+			maxLoadFactor = value;
+
+			if (capacity != 0)
+			{
+				ReAlloc(std::max(capacity, GetCapacityFor(size)));
+			}
+		}
+
+	private:
+		template<typename Create>
+		T& Emplace(size_t hash, Create& create)
+		{
+			size_t index = size;
+			T* value = new (&values[index]) T(create());
+			Link& link = *new (&links[index]) Link(hash);
+
+			LinkToBucket(index, link, GetBucketByHash(hash));
+			++size;
+
+			return *value;
+		}
+
+		static void LinkToBucket(size_t index, Link& link, Bucket& bucket)
+		{
+			if (bucket.HasElement())
+			{
+				link.SetNextIndex(bucket.GetElementIndex());
+			}
+
+			bucket.SetElementIndex(index);
+		}
+
+		Bucket& GetBucketByHash(size_t hash, Bucket* buckets, size_t capacity) const
+		{
+			size_t bucketIndex = BucketIndex::GetIndex(hash, capacity);
+			return buckets[bucketIndex];
+		}
+
+		Bucket& GetBucketByHash(size_t hash) const
+		{
+			return GetBucketByHash(hash, buckets, capacity);
+		}
+
+		void Unlink(Bucket& bucket, Link* previous, Link& link)
+		{
+			if (previous == nullptr)
+			{
+				link.HasNext()
+					? bucket.SetElementIndex(link.GetNextIndex())
+					: bucket.ResetElementIndex();
+			}
+			else
+			{
+				link.HasNext()
+					? previous->SetNextIndex(link.GetNextIndex())
+					: previous->ResetNextIndex();
+			}
+
+			link.ResetNextIndex();
+		}
+
+		void MoveLastTo(size_t index)
+		{
+			size_t lastIndex = size - 1;
+
+			if (index == lastIndex)
+			{
+				values[index].~T();
+				return;
+			}
+
+			RepointChain(lastIndex, index);
+
+			values[index] = std::move(values[lastIndex]);
+			values[lastIndex].~T();
+			links[index] = links[lastIndex];
+		}
+
+		// Moves the last values into the slots that duplicates left free at the end of the
+		// partitions, so that the values are densely packed again.
+		void CloseGaps(const std::vector<size_t>& partitionStarts, const std::vector<size_t>& filled, size_t newSize)
+		{
+			size_t sourcePartition = filled.size();
+			size_t sourceCount = 0;
+
+			for (size_t partition = 0; partitionStarts[partition] < newSize; ++partition)
+			{
+				size_t last = std::min(partitionStarts[partition + 1], newSize);
+
+				for (size_t slot = partitionStarts[partition] + filled[partition]; slot < last; ++slot)
+				{
+					while (sourceCount == 0)
+					{
+						sourceCount = filled[--sourcePartition];
+					}
+
+					size_t source = partitionStarts[sourcePartition] + --sourceCount;
+
+					RepointChain(source, slot);
+					new (&values[slot]) T(std::move(values[source]));
+					values[source].~T();
+					links[slot] = links[source];
+				}
+			}
+		}
+
+		// Makes the bucket or the link that refers to the value at one index refer to another.
+		void RepointChain(size_t from, size_t to)
+		{
+			Bucket& bucket = GetBucketByHash(links[from].GetHash());
+
+			if (bucket.GetElementIndex() == from)
+			{
+				bucket.SetElementIndex(to);
+				return;
+			}
+
+			Link* link = &links[bucket.GetElementIndex()];
+
+			while (link->GetNextIndex() != from)
+			{
+				link = &links[link->GetNextIndex()];
+			}
+
+			link->SetNextIndex(to);
+		}
+
+		void ReAlloc()
+		{
+			if (capacity == 0)
+			{
+				ReAlloc(BucketIndex::GetInitialCapacity());
+				return;
+			}
+
+			size_t newCapacity = BucketIndex::GetNextCapacity(capacity);
+			ReAlloc(newCapacity);
+		}
+
+		void ReAlloc(size_t newCapacity)
+		{
+			size_t newMaxSize = GetMaxSize(newCapacity);
+			Bucket* newBuckets = AllocateBuckets(newCapacity);
+			T* newValues = Allocate<T>(newMaxSize);
+			Link* newLinks = Allocate<Link>(newMaxSize);
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				new (&newValues[i]) T(std::move(values[i]));
+
+				size_t hash = links[i].GetHash();
+				Link& link = *new (&newLinks[i]) Link(hash);
+				LinkToBucket(i, link, GetBucketByHash(hash, newBuckets, newCapacity));
+			}
+
+			if (values != nullptr)
+			{
+				DestroyValues(values, size);
+				Deallocate(values);
+				Deallocate(links);
+				DeallocateBuckets(buckets);
+			}
+
+			capacity = newCapacity;
+			maxSize = newMaxSize;
+			values = newValues;
+			links = newLinks;
+			buckets = newBuckets;
+		}
+
+		// The value and link arrays hold exactly the elements the buckets may take before growing.
+		size_t GetMaxSize(size_t capacity) const
+		{
+			return std::max<size_t>(1, static_cast<size_t>(capacity * static_cast<double>(maxLoadFactor)));
+		}
+
+		size_t GetCapacityFor(size_t count) const
+		{
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			size_t capacity = BucketIndex::GetCapacityFor(static_cast<size_t>(std::ceil(count / static_cast<double>(maxLoadFactor))));
+
+			while (GetMaxSize(capacity) < count)
+			{
+				capacity = BucketIndex::GetNextCapacity(capacity);
+			}
+
+			return capacity;
+		}
+
+		// Values are constructed only when a slot is used, and buckets come from zeroed memory
+		// (an all-zero Bucket is empty), so a large allocation is not initialized up front and
+		// the pages are only touched once the table actually fills them.
+		template<typename Item>
+		static Item* Allocate(size_t count)
+		{
+			return static_cast<Item*>(::operator new(count * sizeof(Item)));
+		}
+
+		static void Deallocate(void* items)
+		{
+			::operator delete(items);
+		}
+
+		static Bucket* AllocateBuckets(size_t capacity)
+		{
+			void* buckets = std::calloc(capacity, sizeof(Bucket));
+
+			if (buckets == nullptr)
+			{
+				throw std::bad_alloc();
+			}
+
+			return static_cast<Bucket*>(buckets);
+		}
+
+		static void DeallocateBuckets(Bucket* buckets)
+		{
+			std::free(buckets);
+		}
+
+		static void DestroyValues(T* values, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				values[i].~T();
+			}
+		}
+
+	private:
+		template<typename Equal>
+		bool IsMatch(size_t index, size_t hash, Equal& equal) const
+		{
+			return links[index].GetHash() == hash && equal(values[index]);
+		}
+
+		template<typename Equal>
+		size_t FindIndex(size_t hash, Equal& equal) const
+		{
+			if (capacity == 0)
+			{
+				return npos;
+			}
+
+			Bucket& bucket = GetBucketByHash(hash);
+
+			if (!bucket.HasElement())
+			{
+				return npos;
+			}
+
+			size_t index = bucket.GetElementIndex();
+
+			while (!IsMatch(index, hash, equal))
+			{
+				if (!links[index].HasNext())
+				{
+					return npos;
+				}
+
+				index = links[index].GetNextIndex();
+			}
+
+			return index;
+		}
+
+		template<typename Equal>
+		bool ChainContains(const Bucket& bucket, size_t hash, Equal& equal) const
+		{
+			if (!bucket.HasElement())
+			{
+				return false;
+			}
+
+			size_t index = bucket.GetElementIndex();
+
+			while (!IsMatch(index, hash, equal))
+			{
+				if (!links[index].HasNext())
+				{
+					return false;
+				}
+
+				index = links[index].GetNextIndex();
+			}
+
+			return true;
+		}
+
+	public:
+		size_t GetSize() const { return size; }
+		size_t GetCapacity() const { return capacity; }
+		bool IsEmpty() const { return size == 0; }
+		bool IsFull() const { return size >= maxSize; }
+		size_t GetFreeSlots() const { return maxSize - size; }
+		float GetMaxLoadFactor() const { return maxLoadFactor; }
+		size_t GetTombstoneCount() const { return 0; }
+
+		size_t GetAllocatedBytes() const
+		{
+			return capacity * sizeof(Bucket) + maxSize * (sizeof(T) + sizeof(Link));
+		}
+
+		size_t GetBucketIndex(size_t hash) const { return BucketIndex::GetIndex(hash, capacity); }
+		T* GetValues() const { return values; }
+
+	public:
+		Iterator begin() const
+		{
+			return Iterator(values);
+		}
+
+		Iterator end() const
+		{
+			return Iterator(values + size);
+		}
+
+	public:
+		static constexpr float DefaultMaxLoadFactor = 0.75f;
+
+	private:
+		struct BulkEntry
+		{
+			size_t hash;
+			size_t position;
+		};
+
+	private:
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		// Enough partitions that a thread stuck with a full one does not hold the others up.
+		static constexpr size_t PartitionsPerThread = 16;
+
+	private:
+		T* values;
+		Link* links;
+		Bucket* buckets;
+
+		size_t size;
+		size_t capacity;
+		size_t maxSize;
+		float maxLoadFactor;
+	};
+
+	namespace Engines
+	{
+		template<typename BucketIndex = Buckets::Fibonacci>
+		struct Chained
+		{
+			template<typename T>
+			using Storage = ChainedStorage<T, BucketIndex>;
+		};
+
+		// Storages that fill themselves from many threads through BulkInsert.
+		template<typename Storage>
+		struct CanBulkInsert : std::false_type
+		{};
+
+		template<typename T, typename BucketIndex>
+		struct CanBulkInsert<ChainedStorage<T, BucketIndex>> : std::true_type
+		{};
+	}
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include "../../Memory/Simd.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Structs
+{
+	namespace Control
+	{
+		constexpr int8_t Empty = -128;
+		constexpr int8_t Deleted = -2;
+		constexpr int8_t Sentinel = -1;
+
+		constexpr size_t GroupWidth = 16;
+
+		inline bool IsFull(int8_t control) { return control >= 0; }
+		inline bool IsEmptyOrDeleted(int8_t control) { return control < Sentinel; }
+
+		using Simd::CountTrailingZeros;
+
+		class BitMask
+		{
+		public:
+			explicit BitMask(uint32_t mask)
+				: mask(mask)
+			{}
+
+		public:
+			explicit operator bool() const { return mask != 0; }
+
+			size_t GetLowest() const { return CountTrailingZeros(mask); }
+			void RemoveLowest() { mask &= mask - 1; }
+
+		private:
+			uint32_t mask;
+		};
+
+		// Sixteen control bytes that are matched at once: one SSE2 compare when available,
+		// a plain byte loop otherwise.
+		class Group
+		{
+		public:
+			explicit Group(const int8_t* control)
+#if defined(STRUCTS_SSE2)
+				: bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control)))
+			{}
+#else
+				: bytes(control)
+			{}
+#endif
+
+		public:
+			BitMask Match(int8_t h2) const
+			{
+#if defined(STRUCTS_SSE2)
+				__m128i pattern = _mm_set1_epi8(h2);
+				return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(pattern, bytes))));
+#else
+				uint32_t mask = 0;
+
+				for (size_t i = 0; i < GroupWidth; ++i)
+				{
+					mask |= static_cast<uint32_t>(bytes[i] == h2) << i;
+				}
+
+				return BitMask(mask);
+#endif
+			}
+
+			BitMask MatchEmpty() const
+			{
+				return Match(Empty);
+			}
+
+			BitMask MatchEmptyOrDeleted() const
+			{
+#if defined(STRUCTS_SSE2)
+				__m128i sentinel = _mm_set1_epi8(Sentinel);
+				return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(sentinel, bytes))));
+#else
+				uint32_t mask = 0;
+
+				for (size_t i = 0; i < GroupWidth; ++i)
+				{
+					mask |= static_cast<uint32_t>(IsEmptyOrDeleted(bytes[i])) << i;
+				}
+
+				return BitMask(mask);
+#endif
+			}
+
+		private:
+#if defined(STRUCTS_SSE2)
+			__m128i bytes;
+#else
+			const int8_t* bytes;
+#endif
+		};
+
+		constexpr size_t BucketWidth = 8;
+
+		// The control bytes of two buckets of eight, matched at once like a group: the first
+		// bucket in the low eight bits of a mask, the second in the high eight.
+		class BucketPair
+		{
+		public:
+			BucketPair(const int8_t* first, const int8_t* second)
+#if defined(STRUCTS_SSE2)
+				: bytes(_mm_unpacklo_epi64(
+					_mm_loadl_epi64(reinterpret_cast<const __m128i*>(first)),
+					_mm_loadl_epi64(reinterpret_cast<const __m128i*>(second))))
+			{}
+#else
+			{
+				for (size_t i = 0; i < BucketWidth; ++i)
+				{
+					bytes[i] = first[i];
+					bytes[BucketWidth + i] = second[i];
+				}
+			}
+#endif
+
+		public:
+			BitMask Match(int8_t h2) const
+			{
+#if defined(STRUCTS_SSE2)
+				__m128i pattern = _mm_set1_epi8(h2);
+				return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(pattern, bytes))));
+#else
+				uint32_t mask = 0;
+
+				for (size_t i = 0; i < GroupWidth; ++i)
+				{
+					mask |= static_cast<uint32_t>(bytes[i] == h2) << i;
+				}
+
+				return BitMask(mask);
+#endif
+			}
+
+			BitMask MatchEmpty() const
+			{
+				return Match(Empty);
+			}
+
+		private:
+#if defined(STRUCTS_SSE2)
+			__m128i bytes;
+#else
+			int8_t bytes[GroupWidth];
+#endif
+		};
+	}
+}
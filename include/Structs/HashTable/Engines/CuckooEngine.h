@@ -0,0 +1,734 @@
+#pragma once
+#include "BucketIndex.h"
+#include "ControlGroup.h"
+#include "Prefetch.h"
+#include "SwissEngine.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace Structs
+{
+	// Bucketized cuckoo hashing: every hash has two candidate buckets of eight slots, and a
+	// value always lives in one of them, so a lookup matches the control bytes of both buckets
+	// with one compare and never probes further. An insert into two full buckets searches
+	// breadth-first for a short path of values to move to their other bucket. When no path is
+	// found within the search bound, the value goes to a small stash that lookups only check
+	// while it is not empty; only a full stash or the load factor grows the table.
+	template<typename T>
+	class CuckooStorage
+	{
+	public:
+		using Iterator = SwissIterator<T>;
+		using Pair = Control::BucketPair;
+
+	public:
+		CuckooStorage()
+			:
+			control(nullptr),
+			slots(nullptr),
+			hashes(nullptr),
+			size(0),
+			bucketCount(0),
+			maxSize(0),
+			stashSize(0),
+			maxLoadFactor(DefaultMaxLoadFactor)
+		{}
+
+		CuckooStorage(const CuckooStorage& storage) = delete;
+		CuckooStorage& operator=(const CuckooStorage& storage) = delete;
+
+		CuckooStorage(CuckooStorage&& storage) noexcept
+			:
+			control(storage.control),
+			slots(storage.slots),
+			hashes(storage.hashes),
+			size(storage.size),
+			bucketCount(storage.bucketCount),
+			maxSize(storage.maxSize),
+			stashSize(storage.stashSize),
+			maxLoadFactor(storage.maxLoadFactor)
+		{
+			storage.control = nullptr;
+			storage.slots = nullptr;
+			storage.hashes = nullptr;
+			storage.size = 0;
+			storage.bucketCount = 0;
+			storage.maxSize = 0;
+			storage.stashSize = 0;
+		}
+
+		CuckooStorage& operator=(CuckooStorage&& storage) noexcept
+		{
+			Clear();
+
+			control = storage.control;
+			slots = storage.slots;
+			hashes = storage.hashes;
+			size = storage.size;
+			bucketCount = storage.bucketCount;
+			maxSize = storage.maxSize;
+			stashSize = storage.stashSize;
+			maxLoadFactor = storage.maxLoadFactor;
+
+			storage.control = nullptr;
+			storage.slots = nullptr;
+			storage.hashes = nullptr;
+			storage.size = 0;
+			storage.bucketCount = 0;
+			storage.maxSize = 0;
+			storage.stashSize = 0;
+
+			return *this;
+		}
+
+		~CuckooStorage()
+		{
+			Clear();
+		}
+
+	public:
+		// Throws std::invalid_argument when more values share one hash than its two buckets
+		// and the stash can hold, which no amount of growth would fix.
+		template<typename Equal, typename Create>
+		std::pair<T*, bool> FindOrInsert(size_t hash, Equal equal, Create create)
+		{
+			size_t index = FindIndex(hash, equal);
+
+			if (index != npos)
+			{
+				return { &slots[index], false };
+			}
+
+			// Making room kicks values to their other bucket and growing moves all of them, and
+			// create() may read one of them, so the value is built before either.
+			T value = create();
+
+			if (size >= maxSize)
+			{
+				ReAlloc();
+			}
+
+			index = PrepareInsert(hash);
+			new (&slots[index]) T(std::move(value));
+			SetFull(index, hash);
+
+			return { &slots[index], true };
+		}
+
+		template<typename Equal>
+		bool TryRemove(size_t hash, Equal equal)
+		{
+			size_t index = FindIndex(hash, equal);
+
+			if (index == npos)
+			{
+				return false;
+			}
+
+			slots[index].~T();
+			control[index] = Control::Empty;
+			--size;
+
+			if (index >= GetCapacity())
+			{
+				--stashSize;
+			}
+			else if (stashSize != 0)
+			{
+				DrainStashInto(index / Control::BucketWidth);
+			}
+
+			return true;
+		}
+
+		template<typename Equal>
+		T* Find(size_t hash, Equal equal) const
+		{
+			size_t index = FindIndex(hash, equal);
+
+			if (index == npos)
+			{
+				return nullptr;
+			}
+
+			return &slots[index];
+		}
+
+		// The number of buckets a lookup of the key reads: its two candidates, and the stash
+		// while anything lives there.
+		template<typename Equal>
+		size_t GetProbeLength(size_t, Equal) const
+		{
+			if (bucketCount == 0)
+			{
+				return 0;
+			}
+
+			return stashSize == 0 ? 2 : 3;
+		}
+
+		void Prefetch(size_t hash) const
+		{
+			if (bucketCount == 0)
+			{
+				return;
+			}
+
+			size_t first = GetFirstBucket(hash);
+			Memory::Prefetch(control + first * Control::BucketWidth);
+			Memory::Prefetch(control + GetSecondBucket(hash, first) * Control::BucketWidth);
+		}
+
+		void PrefetchEntry(size_t hash) const
+		{
+			if (bucketCount == 0)
+			{
+				return;
+			}
+
+			size_t first = GetFirstBucket(hash);
+			size_t second = GetSecondBucket(hash, first);
+			Control::BitMask match = Pair(GetBucketControl(first), GetBucketControl(second)).Match(H2(hash));
+
+			if (match)
+			{
+				Memory::Prefetch(&slots[GetPairIndex(first, second, match.GetLowest())]);
+			}
+		}
+
+		void Clear()
+		{
+			if (control == nullptr)
+				return;
+
+			DestroySlots(control, slots, GetSlotCount(bucketCount));
+
+			delete[] control;
+			DeallocateSlots(slots);
+			delete[] hashes;
+
+			control = nullptr;
+			slots = nullptr;
+			hashes = nullptr;
+
+			size = 0;
+			bucketCount = 0;
+			maxSize = 0;
+			stashSize = 0;
+		}
+
+		void Reserve(size_t count)
+		{
+			if (count > maxSize)
+			{
+				ReAlloc(GetBucketCountFor(count));
+			}
+		}
+
+		void Rehash(size_t minimumCapacity)
+		{
+			size_t buckets = (minimumCapacity + Control::BucketWidth - 1) / Control::BucketWidth;
+			size_t newBucketCount = std::max(GetBucketCountFor(size), RoundUpToPowerOfTwo(buckets));
+
+			if (newBucketCount == 0)
+			{
+				Clear();
+			}
+			else if (newBucketCount != bucketCount)
+			{
+				ReAlloc(newBucketCount);
+			}
+		}
+
+		void ShrinkToFit()
+		{
+			Rehash(0);
+		}
+
+		// Two buckets of eight stay placeable up to about 98% of the slots; past that the
+		// path search fails often enough that the stash keeps growing the table anyway.
+		void SetMaxLoadFactor(float value)
+		{
+			maxLoadFactor = std::min(value, MaxLoadFactorLimit);
+
+			if (bucketCount != 0)
+			{
+				ReAlloc(std::max(bucketCount, GetBucketCountFor(size)));
+			}
+		}
+
+	private:
+		struct PathNode
+		{
+		public:
+			size_t bucket;
+			size_t parent;
+			size_t slot;
+		};
+
+		static size_t Mix(size_t hash)
+		{
+			uint64_t mixed = static_cast<uint64_t>(hash);
+			mixed ^= mixed >> 33;
+			mixed *= 0xff51afd7ed558ccdULL;
+			mixed ^= mixed >> 33;
+			return static_cast<size_t>(mixed);
+		}
+
+		static int8_t H2(size_t hash) { return static_cast<int8_t>(Mix(hash) & 0x7F); }
+
+		size_t GetFirstBucket(size_t hash) const
+		{
+			return Buckets::Fibonacci::GetIndex(hash, bucketCount);
+		}
+
+		// Another bucket from the mixed hash, moved off the first one if they coincide.
+		size_t GetSecondBucket(size_t hash, size_t first) const
+		{
+			size_t second = Buckets::Fibonacci::GetIndex(Mix(hash) >> 7, bucketCount);
+			return second == first ? first ^ 1 : second;
+		}
+
+		size_t GetAlternateBucket(size_t hash, size_t bucket) const
+		{
+			size_t first = GetFirstBucket(hash);
+			size_t second = GetSecondBucket(hash, first);
+
+			return bucket == first ? second : first;
+		}
+
+		const int8_t* GetBucketControl(size_t bucket) const
+		{
+			return control + bucket * Control::BucketWidth;
+		}
+
+		static size_t GetPairIndex(size_t first, size_t second, size_t bit)
+		{
+			return bit < Control::BucketWidth
+				? first * Control::BucketWidth + bit
+				: second * Control::BucketWidth + bit - Control::BucketWidth;
+		}
+
+		size_t FindEmptySlot(size_t bucket) const
+		{
+			const int8_t* bucketControl = GetBucketControl(bucket);
+
+			for (size_t i = 0; i < Control::BucketWidth; ++i)
+			{
+				if (bucketControl[i] == Control::Empty)
+				{
+					return bucket * Control::BucketWidth + i;
+				}
+			}
+
+			return npos;
+		}
+
+		template<typename Equal>
+		size_t FindIndex(size_t hash, Equal& equal) const
+		{
+			if (bucketCount == 0)
+			{
+				return npos;
+			}
+
+			size_t first = GetFirstBucket(hash);
+			size_t second = GetSecondBucket(hash, first);
+			int8_t h2 = H2(hash);
+
+			for (Control::BitMask match = Pair(GetBucketControl(first), GetBucketControl(second)).Match(h2); match; match.RemoveLowest())
+			{
+				size_t index = GetPairIndex(first, second, match.GetLowest());
+
+				if (hashes[index] == hash && equal(slots[index]))
+				{
+					return index;
+				}
+			}
+
+			if (stashSize == 0)
+			{
+				return npos;
+			}
+
+			for (size_t index = GetCapacity(); index < GetSlotCount(bucketCount); ++index)
+			{
+				if (control[index] == h2 && hashes[index] == hash && equal(slots[index]))
+				{
+					return index;
+				}
+			}
+
+			return npos;
+		}
+
+		size_t PrepareInsert(size_t hash)
+		{
+			if (bucketCount == 0)
+			{
+				ReAlloc(InitialBucketCount);
+			}
+
+			size_t index = MakeRoom(hash);
+
+			if (index != npos)
+			{
+				return index;
+			}
+
+			// A random hash finds room in a table that has just doubled, so a second failure
+			// means too many values share the hash.
+			ReAlloc(bucketCount * 2);
+			index = MakeRoom(hash);
+
+			if (index == npos)
+			{
+				throw std::invalid_argument("Too many values share the same hash");
+			}
+
+			return index;
+		}
+
+		// Returns a free slot in one of the hash's buckets, moving other values to their
+		// alternate buckets along the shortest path found, or a free stash slot.
+		size_t MakeRoom(size_t hash)
+		{
+			size_t first = GetFirstBucket(hash);
+			size_t second = GetSecondBucket(hash, first);
+			Control::BitMask empty = Pair(GetBucketControl(first), GetBucketControl(second)).MatchEmpty();
+
+			if (empty)
+			{
+				return GetPairIndex(first, second, empty.GetLowest());
+			}
+
+			PathNode path[MaxPathNodes];
+			size_t nodeCount = 0;
+
+			path[nodeCount++] = PathNode{ first, npos, 0 };
+			path[nodeCount++] = PathNode{ second, npos, 0 };
+
+			for (size_t node = 0; node < nodeCount; ++node)
+			{
+				size_t bucket = path[node].bucket;
+
+				for (size_t slot = 0; slot < Control::BucketWidth; ++slot)
+				{
+					size_t index = bucket * Control::BucketWidth + slot;
+					size_t alternate = GetAlternateBucket(hashes[index], bucket);
+					size_t target = FindEmptySlot(alternate);
+
+					if (target != npos)
+					{
+						return MoveAlong(path, node, slot, target);
+					}
+
+					if (nodeCount < MaxPathNodes)
+					{
+						path[nodeCount++] = PathNode{ alternate, node, slot };
+					}
+				}
+			}
+
+			return FindEmptyStashSlot();
+		}
+
+		// Moves the value in the slot of the node into the free target, then every value on
+		// the way back to the root into the slot its child just left. Every move takes a value
+		// to its other bucket, so the table stays valid even if a revisited bucket makes a
+		// later move stale and the walk stops early.
+		size_t MoveAlong(const PathNode* path, size_t node, size_t slot, size_t target)
+		{
+			while (true)
+			{
+				size_t bucket = path[node].bucket;
+				size_t index = bucket * Control::BucketWidth + slot;
+
+				if (!Control::IsFull(control[index]) ||
+					control[target] != Control::Empty ||
+					GetAlternateBucket(hashes[index], bucket) != target / Control::BucketWidth)
+				{
+					return FindEmptyStashSlot();
+				}
+
+				MoveSlot(index, target);
+				target = index;
+
+				if (path[node].parent == npos)
+				{
+					return target;
+				}
+
+				slot = path[node].slot;
+				node = path[node].parent;
+			}
+		}
+
+		size_t FindEmptyStashSlot() const
+		{
+			for (size_t index = GetCapacity(); index < GetSlotCount(bucketCount); ++index)
+			{
+				if (control[index] == Control::Empty)
+				{
+					return index;
+				}
+			}
+
+			return npos;
+		}
+
+		// Moves stashed values whose buckets include the one that just lost a value.
+		void DrainStashInto(size_t bucket)
+		{
+			for (size_t index = GetCapacity(); index < GetSlotCount(bucketCount) && stashSize != 0; ++index)
+			{
+				if (!Control::IsFull(control[index]))
+				{
+					continue;
+				}
+
+				size_t first = GetFirstBucket(hashes[index]);
+
+				if (bucket != first && bucket != GetSecondBucket(hashes[index], first))
+				{
+					continue;
+				}
+
+				size_t target = FindEmptySlot(bucket);
+
+				if (target == npos)
+				{
+					return;
+				}
+
+				MoveSlot(index, target);
+				--stashSize;
+			}
+		}
+
+		void MoveSlot(size_t from, size_t to)
+		{
+			new (&slots[to]) T(std::move(slots[from]));
+			slots[from].~T();
+
+			control[to] = control[from];
+			hashes[to] = hashes[from];
+			control[from] = Control::Empty;
+		}
+
+		void SetFull(size_t index, size_t hash)
+		{
+			control[index] = H2(hash);
+			hashes[index] = hash;
+			++size;
+
+			if (index >= GetCapacity())
+			{
+				++stashSize;
+			}
+		}
+
+		void ReAlloc()
+		{
+			if (bucketCount == 0)
+			{
+				ReAlloc(InitialBucketCount);
+				return;
+			}
+
+			ReAlloc(bucketCount * 2);
+		}
+
+		// Values that find no room even in the new table double it again; the nested call
+		// moves what was placed so far and the loop goes on in the larger table.
+		void ReAlloc(size_t newBucketCount)
+		{
+			int8_t* oldControl = control;
+			T* oldSlots = slots;
+			size_t* oldHashes = hashes;
+			size_t oldSlotCount = GetSlotCount(bucketCount);
+			size_t slotCount = GetSlotCount(newBucketCount);
+
+			control = new int8_t[slotCount + 1];
+			slots = AllocateSlots(slotCount);
+			hashes = new size_t[slotCount];
+			bucketCount = newBucketCount;
+			maxSize = GetMaxSize(newBucketCount);
+			size = 0;
+			stashSize = 0;
+
+			for (size_t i = 0; i < slotCount; ++i)
+			{
+				control[i] = Control::Empty;
+			}
+
+			control[slotCount] = Control::Sentinel;
+
+			if (oldControl == nullptr)
+			{
+				return;
+			}
+
+			for (size_t i = 0; i < oldSlotCount; ++i)
+			{
+				if (!Control::IsFull(oldControl[i]))
+				{
+					continue;
+				}
+
+				size_t hash = oldHashes[i];
+				size_t index = MakeRoom(hash);
+
+				while (index == npos)
+				{
+					ReAlloc(bucketCount * 2);
+					index = MakeRoom(hash);
+				}
+
+				new (&slots[index]) T(std::move(oldSlots[i]));
+				SetFull(index, hash);
+			}
+
+			DestroySlots(oldControl, oldSlots, oldSlotCount);
+
+			delete[] oldControl;
+			DeallocateSlots(oldSlots);
+			delete[] oldHashes;
+		}
+
+		size_t GetMaxSize(size_t bucketCount) const
+		{
+			size_t capacity = bucketCount * Control::BucketWidth;
+			return std::max<size_t>(1, static_cast<size_t>(capacity * static_cast<double>(maxLoadFactor)));
+		}
+
+		size_t GetBucketCountFor(size_t count) const
+		{
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			size_t buckets = InitialBucketCount;
+
+			while (GetMaxSize(buckets) < count)
+			{
+				buckets *= 2;
+			}
+
+			return buckets;
+		}
+
+		static size_t RoundUpToPowerOfTwo(size_t buckets)
+		{
+			if (buckets == 0)
+			{
+				return 0;
+			}
+
+			size_t rounded = InitialBucketCount;
+
+			while (rounded < buckets)
+			{
+				rounded *= 2;
+			}
+
+			return rounded;
+		}
+
+		// The buckets and the stash after them.
+		static size_t GetSlotCount(size_t bucketCount)
+		{
+			return bucketCount == 0 ? 0 : (bucketCount + 1) * Control::BucketWidth;
+		}
+
+		static T* AllocateSlots(size_t capacity)
+		{
+			return static_cast<T*>(::operator new(capacity * sizeof(T)));
+		}
+
+		static void DeallocateSlots(T* slots)
+		{
+			::operator delete(slots);
+		}
+
+		static void DestroySlots(const int8_t* control, T* slots, size_t slotCount)
+		{
+			for (size_t i = 0; i < slotCount; ++i)
+			{
+				if (Control::IsFull(control[i]))
+				{
+					slots[i].~T();
+				}
+			}
+		}
+
+	public:
+		size_t GetSize() const { return size; }
+		size_t GetCapacity() const { return bucketCount * Control::BucketWidth; }
+		size_t GetStashSize() const { return stashSize; }
+		bool IsEmpty() const { return size == 0; }
+		float GetMaxLoadFactor() const { return maxLoadFactor; }
+		size_t GetTombstoneCount() const { return 0; }
+
+		size_t GetAllocatedBytes() const
+		{
+			size_t slotCount = GetSlotCount(bucketCount);
+			return slotCount == 0 ? 0 : slotCount + 1 + slotCount * (sizeof(T) + sizeof(size_t));
+		}
+
+	public:
+		Iterator begin() const
+		{
+			if (control == nullptr)
+			{
+				return Iterator();
+			}
+
+			return Iterator(control, slots);
+		}
+
+		Iterator end() const
+		{
+			if (control == nullptr)
+			{
+				return Iterator();
+			}
+
+			size_t slotCount = GetSlotCount(bucketCount);
+			return Iterator(control + slotCount, slots + slotCount);
+		}
+
+	public:
+		static constexpr float DefaultMaxLoadFactor = 0.95f;
+		static constexpr float MaxLoadFactorLimit = 0.98f;
+
+	private:
+		static constexpr size_t InitialBucketCount = 2;
+		static constexpr size_t MaxPathNodes = 256;
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+	private:
+		int8_t* control;
+		T* slots;
+		size_t* hashes;
+
+		size_t size;
+		size_t bucketCount;
+		size_t maxSize;
+		size_t stashSize;
+		float maxLoadFactor;
+	};
+
+	namespace Engines
+	{
+		struct Cuckoo
+		{
+			template<typename T>
+			using Storage = CuckooStorage<T>;
+		};
+	}
+}
@@ -0,0 +1,391 @@
+#pragma once
+#include "../../Collection/IIterator.h"
+#include "ChainedEngine.h"
+#include <utility>
+
+namespace Structs
+{
+	template <typename T>
+	class IncrementalChainedIterator : public IIterator<T, IncrementalChainedIterator<T>>
+	{
+	public:
+		IncrementalChainedIterator()
+			: IncrementalChainedIterator(nullptr, nullptr, nullptr, nullptr)
+		{}
+
+		IncrementalChainedIterator(T* value, T* end, T* nextValue, T* nextEnd)
+			: value(value), end(end), nextValue(nextValue), nextEnd(nextEnd)
+		{
+			SkipFinishedRange();
+		}
+
+		virtual IncrementalChainedIterator& operator++() override
+		{
+			++value;
+			SkipFinishedRange();
+			return *this;
+		}
+
+		virtual IncrementalChainedIterator& operator++(int) override
+		{
+			IncrementalChainedIterator temp = *this;
+			++(*this);
+			return temp;
+		}
+
+		virtual bool operator==(const IncrementalChainedIterator& rhs) const override
+		{
+			return value == rhs.value;
+		}
+
+		virtual bool operator!=(const IncrementalChainedIterator& rhs) const override
+		{
+			return !(*this == rhs);
+		}
+
+		virtual T& operator*() const override
+		{
+			return *value;
+		}
+
+		virtual T* operator->() const override
+		{
+			return value;
+		}
+
+	private:
+		void SkipFinishedRange()
+		{
+			if (value != end)
+			{
+				return;
+			}
+
+			value = nextValue;
+			end = nextEnd;
+			nextValue = nullptr;
+			nextEnd = nullptr;
+
+			if (value == end)
+			{
+				value = nullptr;
+				end = nullptr;
+			}
+		}
+
+	private:
+		T* value;
+		T* end;
+		T* nextValue;
+		T* nextEnd;
+	};
+
+	// Chained storage that grows without a stop-the-world rehash: when the table is full the
+	// old arrays are kept as `previous`, and every operation moves BucketsPerStep of its
+	// buckets into the doubled `current` table until nothing is left to migrate. Inserts move
+	// more when needed to be done before `current` is full.
+	template<typename T, size_t BucketsPerStep, typename BucketIndex = Buckets::Fibonacci>
+	class IncrementalChainedStorage
+	{
+	private:
+		static_assert(BucketsPerStep > 0, "BucketsPerStep must be greater than zero");
+
+	public:
+		using Iterator = IncrementalChainedIterator<T>;
+		using Table = ChainedStorage<T, BucketIndex>;
+
+	public:
+		IncrementalChainedStorage()
+			: current(), previous(0), migratedBuckets(0)
+		{}
+
+		IncrementalChainedStorage(const IncrementalChainedStorage& storage) = delete;
+		IncrementalChainedStorage& operator=(const IncrementalChainedStorage& storage) = delete;
+
+		IncrementalChainedStorage(IncrementalChainedStorage&& storage) noexcept
+			:
+			current(std::move(storage.current)),
+			previous(std::move(storage.previous)),
+			migratedBuckets(storage.migratedBuckets)
+		{
+			storage.migratedBuckets = 0;
+		}
+
+		IncrementalChainedStorage& operator=(IncrementalChainedStorage&& storage) noexcept
+		{
+			current = std::move(storage.current);
+			previous = std::move(storage.previous);
+			migratedBuckets = storage.migratedBuckets;
+
+			storage.migratedBuckets = 0;
+
+			return *this;
+		}
+
+	public:
+		template<typename Equal, typename Create>
+		std::pair<T*, bool> FindOrInsert(size_t hash, Equal equal, Create create)
+		{
+			T* value = static_cast<const IncrementalChainedStorage&>(*this).Find(hash, equal);
+
+			if (value != nullptr)
+			{
+				// The step may move the value, so it is looked up again after it.
+				return { IsMigrating() ? Find(hash, equal) : value, false };
+			}
+
+			if (!IsMigrating() && current.IsFull() && current.GetCapacity() != 0)
+			{
+				StartMigration();
+			}
+
+			if (!IsMigrating())
+			{
+				return current.FindOrInsert(hash, equal, create);
+			}
+
+			// The step moves values that create() may read, so the value is built before it.
+			T created = create();
+			MigrateStep(GetBucketsPerInsert());
+
+			auto move = [&created]() { return std::move(created); };
+			return current.FindOrInsert(hash, equal, move);
+		}
+
+		template<typename Equal>
+		bool TryRemove(size_t hash, Equal equal)
+		{
+			MigrateStep();
+
+			if (IsMigrating() && !IsMigrated(hash) && previous.TryRemove(hash, equal))
+			{
+				FinishMigrationIfDone();
+				return true;
+			}
+
+			return current.TryRemove(hash, equal);
+		}
+
+		template<typename Equal>
+		T* Find(size_t hash, Equal equal)
+		{
+			MigrateStep();
+			return static_cast<const IncrementalChainedStorage&>(*this).Find(hash, equal);
+		}
+
+		template<typename Equal>
+		T* Find(size_t hash, Equal equal) const
+		{
+			T* value = FindInPrevious(hash, equal);
+
+			if (value != nullptr)
+			{
+				return value;
+			}
+
+			return current.Find(hash, equal);
+		}
+
+		// Both tables' chains while the key's bucket is still waiting to migrate.
+		template<typename Equal>
+		size_t GetProbeLength(size_t hash, Equal equal) const
+		{
+			if (IsMigrating() && !IsMigrated(hash))
+			{
+				size_t length = previous.GetProbeLength(hash, equal);
+
+				if (previous.Find(hash, equal) != nullptr)
+				{
+					return length;
+				}
+
+				return length + current.GetProbeLength(hash, equal);
+			}
+
+			return current.GetProbeLength(hash, equal);
+		}
+
+		void Prefetch(size_t hash) const
+		{
+			if (IsMigrating() && !IsMigrated(hash))
+			{
+				previous.Prefetch(hash);
+			}
+
+			current.Prefetch(hash);
+		}
+
+		void PrefetchEntry(size_t hash) const
+		{
+			if (IsMigrating() && !IsMigrated(hash))
+			{
+				previous.PrefetchEntry(hash);
+			}
+
+			current.PrefetchEntry(hash);
+		}
+
+		void Clear()
+		{
+			current.Clear();
+			previous.Clear();
+			migratedBuckets = 0;
+		}
+
+		void Reserve(size_t count)
+		{
+			FinishMigration();
+			current.Reserve(count);
+		}
+
+		void Rehash(size_t minimumCapacity)
+		{
+			FinishMigration();
+			current.Rehash(minimumCapacity);
+		}
+
+		void ShrinkToFit()
+		{
+			FinishMigration();
+			current.ShrinkToFit();
+		}
+
+		void SetMaxLoadFactor(float value)
+		{
+			FinishMigration();
+			current.SetMaxLoadFactor(value);
+		}
+
+		bool IsMigrating() const { return previous.GetCapacity() != 0; }
+
+	private:
+		bool IsMigrated(size_t hash) const
+		{
+			return previous.GetBucketIndex(hash) < migratedBuckets;
+		}
+
+		template<typename Equal>
+		T* FindInPrevious(size_t hash, Equal equal) const
+		{
+			if (!IsMigrating() || IsMigrated(hash))
+			{
+				return nullptr;
+			}
+
+			return previous.Find(hash, equal);
+		}
+
+		void StartMigration()
+		{
+			size_t newCapacity = BucketIndex::GetNextCapacity(current.GetCapacity());
+
+			previous = std::move(current);
+			current = Table(newCapacity, previous.GetMaxLoadFactor());
+			migratedBuckets = 0;
+		}
+
+		// Every insert may take one of the slots current has left once all of previous is in it,
+		// so the buckets still to migrate are spread over those slots. That ends the migration
+		// before current fills up and would have to grow all at once.
+		size_t GetBucketsPerInsert() const
+		{
+			if (!IsMigrating())
+			{
+				return 0;
+			}
+
+			size_t remainingBuckets = previous.GetCapacity() - migratedBuckets;
+
+			if (current.GetFreeSlots() <= previous.GetSize())
+			{
+				return remainingBuckets;
+			}
+
+			size_t freeSlots = current.GetFreeSlots() - previous.GetSize();
+			size_t buckets = (remainingBuckets + freeSlots - 1) / freeSlots;
+
+			return buckets > BucketsPerStep ? buckets : BucketsPerStep;
+		}
+
+		void MigrateStep()
+		{
+			MigrateStep(BucketsPerStep);
+		}
+
+		void MigrateStep(size_t buckets)
+		{
+			if (!IsMigrating())
+			{
+				return;
+			}
+
+			size_t bucketCount = previous.GetCapacity();
+
+			for (size_t i = 0; i < buckets && migratedBuckets < bucketCount; ++i)
+			{
+				previous.MoveBucketTo(migratedBuckets, current);
+				++migratedBuckets;
+			}
+
+			FinishMigrationIfDone();
+		}
+
+		void FinishMigration()
+		{
+			while (IsMigrating())
+			{
+				MigrateStep();
+			}
+		}
+
+		void FinishMigrationIfDone()
+		{
+			if (migratedBuckets < previous.GetCapacity() && !previous.IsEmpty())
+			{
+				return;
+			}
+
+			previous.Clear();
+			migratedBuckets = 0;
+		}
+
+	public:
+		size_t GetSize() const { return current.GetSize() + previous.GetSize(); }
+		size_t GetCapacity() const { return current.GetCapacity(); }
+		float GetMaxLoadFactor() const { return current.GetMaxLoadFactor(); }
+		bool IsEmpty() const { return GetSize() == 0; }
+		size_t GetTombstoneCount() const { return 0; }
+		size_t GetAllocatedBytes() const { return current.GetAllocatedBytes() + previous.GetAllocatedBytes(); }
+
+	public:
+		Iterator begin() const
+		{
+			T* previousValues = previous.GetValues();
+			T* currentValues = current.GetValues();
+
+			return Iterator(
+				previousValues, previousValues + previous.GetSize(),
+				currentValues, currentValues + current.GetSize());
+		}
+
+		Iterator end() const
+		{
+			return Iterator();
+		}
+
+	private:
+		Table current;
+		Table previous;
+		size_t migratedBuckets;
+	};
+
+	namespace Engines
+	{
+		template<size_t BucketsPerStep = 4, typename BucketIndex = Buckets::Fibonacci>
+		struct IncrementalChained
+		{
+			template<typename T>
+			using Storage = IncrementalChainedStorage<T, BucketsPerStep, BucketIndex>;
+		};
+	}
+}
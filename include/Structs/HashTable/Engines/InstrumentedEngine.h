@@ -0,0 +1,207 @@
+#pragma once
+#include "../HashTableStats.h"
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace Structs
+{
+	// Wraps another engine's storage and counts every change of capacity with the time the
+	// call that caused it took. Tables are only instrumented when they name this engine, so
+	// the other engines carry no counters and no clock reads.
+	template<typename T, typename Engine>
+	class InstrumentedStorage
+	{
+	public:
+		using Storage = typename Engine::template Storage<T>;
+		using Iterator = typename Storage::Iterator;
+		using Clock = std::chrono::steady_clock;
+
+	public:
+		InstrumentedStorage()
+			: storage(), rehashCount(0), rehashNanoseconds(0)
+		{}
+
+		InstrumentedStorage(const InstrumentedStorage& instrumented) = delete;
+		InstrumentedStorage& operator=(const InstrumentedStorage& instrumented) = delete;
+
+		InstrumentedStorage(InstrumentedStorage&& instrumented) noexcept
+			: storage(std::move(instrumented.storage)), rehashCount(instrumented.rehashCount), rehashNanoseconds(instrumented.rehashNanoseconds)
+		{
+			instrumented.rehashCount = 0;
+			instrumented.rehashNanoseconds = 0;
+		}
+
+		InstrumentedStorage& operator=(InstrumentedStorage&& instrumented) noexcept
+		{
+			storage = std::move(instrumented.storage);
+			rehashCount = instrumented.rehashCount;
+			rehashNanoseconds = instrumented.rehashNanoseconds;
+
+			instrumented.rehashCount = 0;
+			instrumented.rehashNanoseconds = 0;
+
+			return *this;
+		}
+
+	public:
+		template<typename Equal, typename Create>
+		std::pair<T*, bool> FindOrInsert(size_t hash, Equal equal, Create create)
+		{
+			size_t capacity = storage.GetCapacity();
+			Clock::time_point start = Clock::now();
+			std::pair<T*, bool> result = storage.FindOrInsert(hash, equal, create);
+
+			CountRehash(capacity, start);
+			return result;
+		}
+
+		template<typename Equal>
+		bool TryRemove(size_t hash, Equal equal)
+		{
+			return storage.TryRemove(hash, equal);
+		}
+
+		template<typename Equal>
+		T* Find(size_t hash, Equal equal)
+		{
+			return storage.Find(hash, equal);
+		}
+
+		template<typename Equal>
+		T* Find(size_t hash, Equal equal) const
+		{
+			return storage.Find(hash, equal);
+		}
+
+		template<typename Equal>
+		size_t GetProbeLength(size_t hash, Equal equal) const
+		{
+			return storage.GetProbeLength(hash, equal);
+		}
+
+		void Prefetch(size_t hash) const
+		{
+			storage.Prefetch(hash);
+		}
+
+		void PrefetchEntry(size_t hash) const
+		{
+			storage.PrefetchEntry(hash);
+		}
+
+		void Clear()
+		{
+			storage.Clear();
+		}
+
+		void Reserve(size_t count)
+		{
+			size_t capacity = storage.GetCapacity();
+			Clock::time_point start = Clock::now();
+
+			storage.Reserve(count);
+			CountRehash(capacity, start);
+		}
+
+		void Rehash(size_t minimumCapacity)
+		{
+			size_t capacity = storage.GetCapacity();
+			Clock::time_point start = Clock::now();
+
+			storage.Rehash(minimumCapacity);
+			CountRehash(capacity, start);
+		}
+
+		void ShrinkToFit()
+		{
+			size_t capacity = storage.GetCapacity();
+			Clock::time_point start = Clock::now();
+
+			storage.ShrinkToFit();
+			CountRehash(capacity, start);
+		}
+
+		void SetMaxLoadFactor(float value)
+		{
+			size_t capacity = storage.GetCapacity();
+			Clock::time_point start = Clock::now();
+
+			storage.SetMaxLoadFactor(value);
+			CountRehash(capacity, start);
+		}
+
+		// The counters and sizes; the table fills in the probe lengths, as only it can hash
+		// the stored values.
+		HashTableStats GetStats() const
+		{
+			HashTableStats stats{};
+
+			stats.size = storage.GetSize();
+			stats.capacity = storage.GetCapacity();
+			stats.allocatedBytes = storage.GetAllocatedBytes();
+			stats.tombstoneCount = storage.GetTombstoneCount();
+			stats.rehashCount = rehashCount;
+			stats.rehashNanoseconds = rehashNanoseconds;
+
+			return stats;
+		}
+
+	private:
+		void CountRehash(size_t capacity, Clock::time_point start)
+		{
+			if (storage.GetCapacity() == capacity)
+			{
+				return;
+			}
+
+			++rehashCount;
+			rehashNanoseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+		}
+
+	public:
+		size_t GetSize() const { return storage.GetSize(); }
+		size_t GetCapacity() const { return storage.GetCapacity(); }
+		bool IsEmpty() const { return storage.IsEmpty(); }
+		float GetMaxLoadFactor() const { return storage.GetMaxLoadFactor(); }
+		size_t GetTombstoneCount() const { return storage.GetTombstoneCount(); }
+		size_t GetAllocatedBytes() const { return storage.GetAllocatedBytes(); }
+		size_t GetRehashCount() const { return rehashCount; }
+		uint64_t GetRehashNanoseconds() const { return rehashNanoseconds; }
+
+	public:
+		Iterator begin() const
+		{
+			return storage.begin();
+		}
+
+		Iterator end() const
+		{
+			return storage.end();
+		}
+
+	private:
+		Storage storage;
+		size_t rehashCount;
+		uint64_t rehashNanoseconds;
+	};
+
+	namespace Engines
+	{
+		template<typename Engine>
+		struct Instrumented
+		{
+			template<typename T>
+			using Storage = InstrumentedStorage<T, Engine>;
+		};
+
+		template<typename Engine>
+		struct IsInstrumented : std::false_type
+		{};
+
+		template<typename Engine>
+		struct IsInstrumented<Instrumented<Engine>> : std::true_type
+		{};
+	}
+}
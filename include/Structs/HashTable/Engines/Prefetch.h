@@ -0,0 +1,22 @@
+#pragma once
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace Structs
+{
+	namespace Memory
+	{
+		inline void Prefetch(const void* address)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+			_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+			(void)address;
+#endif
+		}
+	}
+}
@@ -0,0 +1,557 @@
+#pragma once
+#include "../../Collection/IIterator.h"
+#include "BucketIndex.h"
+#include "Prefetch.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace Structs
+{
+	// The hash of a slot and how far it sits from its home slot. A distance of zero marks an
+	// empty slot, so an occupied slot in its home position has a distance of one.
+	struct RobinHoodControl
+	{
+	public:
+		size_t hash;
+		uint32_t distance;
+
+	public:
+		bool IsEmpty() const { return distance == 0; }
+	};
+
+	template <typename T>
+	class RobinHoodIterator : public IIterator<T, RobinHoodIterator<T>>
+	{
+	public:
+		RobinHoodIterator()
+			: RobinHoodIterator(nullptr, nullptr)
+		{}
+
+		RobinHoodIterator(const RobinHoodControl* control, T* slot)
+			: control(control), slot(slot)
+		{
+			SkipEmptySlots();
+		}
+
+		virtual RobinHoodIterator& operator++() override
+		{
+			++control;
+			++slot;
+			SkipEmptySlots();
+			return *this;
+		}
+
+		virtual RobinHoodIterator& operator++(int) override
+		{
+			RobinHoodIterator temp = *this;
+			++(*this);
+			return temp;
+		}
+
+		virtual bool operator==(const RobinHoodIterator& rhs) const override
+		{
+			return control == rhs.control;
+		}
+
+		virtual bool operator!=(const RobinHoodIterator& rhs) const override
+		{
+			return !(*this == rhs);
+		}
+
+		virtual T& operator*() const override
+		{
+			return *slot;
+		}
+
+		virtual T* operator->() const override
+		{
+			return slot;
+		}
+
+	private:
+		void SkipEmptySlots()
+		{
+			if (control == nullptr)
+			{
+				return;
+			}
+
+			while (control->IsEmpty())
+			{
+				++control;
+				++slot;
+			}
+		}
+
+	private:
+		const RobinHoodControl* control;
+		T* slot;
+	};
+
+	// Open addressing with linear probing, where an insert takes the slot of any element that
+	// is closer to its home slot than the new one would be. Elements of a run stay ordered by
+	// home slot, so a lookup stops as soon as it passes the distance its key could have, and a
+	// removal shifts the rest of the run back by one instead of leaving a tombstone.
+	template<typename T>
+	class RobinHoodStorage
+	{
+	public:
+		using Iterator = RobinHoodIterator<T>;
+		using Control = RobinHoodControl;
+
+	public:
+		RobinHoodStorage()
+			: controls(nullptr), slots(nullptr), size(0), capacity(0), maxSize(0), maxLoadFactor(DefaultMaxLoadFactor)
+		{}
+
+		RobinHoodStorage(const RobinHoodStorage& storage) = delete;
+		RobinHoodStorage& operator=(const RobinHoodStorage& storage) = delete;
+
+		RobinHoodStorage(RobinHoodStorage&& storage) noexcept
+			:
+			controls(storage.controls),
+			slots(storage.slots),
+			size(storage.size),
+			capacity(storage.capacity),
+			maxSize(storage.maxSize),
+			maxLoadFactor(storage.maxLoadFactor)
+		{
+			storage.controls = nullptr;
+			storage.slots = nullptr;
+			storage.size = 0;
+			storage.capacity = 0;
+			storage.maxSize = 0;
+		}
+
+		RobinHoodStorage& operator=(RobinHoodStorage&& storage) noexcept
+		{
+			Clear();
+
+			controls = storage.controls;
+			slots = storage.slots;
+			size = storage.size;
+			capacity = storage.capacity;
+			maxSize = storage.maxSize;
+			maxLoadFactor = storage.maxLoadFactor;
+
+			storage.controls = nullptr;
+			storage.slots = nullptr;
+			storage.size = 0;
+			storage.capacity = 0;
+			storage.maxSize = 0;
+
+			return *this;
+		}
+
+		~RobinHoodStorage()
+		{
+			Clear();
+		}
+
+	public:
+		template<typename Equal, typename Create>
+		std::pair<T*, bool> FindOrInsert(size_t hash, Equal equal, Create create)
+		{
+			size_t index = FindIndex(hash, equal);
+
+			if (index != npos)
+			{
+				return { &slots[index], false };
+			}
+
+			// Making room shifts values and growing moves all of them, and create() may read one
+			// of them, so the value is built before either.
+			T value = create();
+
+			if (size >= maxSize)
+			{
+				ReAlloc();
+			}
+
+			index = MakeRoom(hash);
+
+			try
+			{
+				new (&slots[index]) T(std::move(value));
+			}
+			catch (...)
+			{
+				ShiftBack(index);
+				throw;
+			}
+
+			++size;
+			return { &slots[index], true };
+		}
+
+		template<typename Equal>
+		bool TryRemove(size_t hash, Equal equal)
+		{
+			size_t index = FindIndex(hash, equal);
+
+			if (index == npos)
+			{
+				return false;
+			}
+
+			slots[index].~T();
+			ShiftBack(index);
+			--size;
+
+			return true;
+		}
+
+		template<typename Equal>
+		T* Find(size_t hash, Equal equal) const
+		{
+			size_t index = FindIndex(hash, equal);
+
+			if (index == npos)
+			{
+				return nullptr;
+			}
+
+			return &slots[index];
+		}
+
+		// The number of slots a lookup of the key inspects before it finds the key or gives up.
+		template<typename Equal>
+		size_t GetProbeLength(size_t hash, Equal equal) const
+		{
+			if (capacity == 0)
+			{
+				return 0;
+			}
+
+			size_t index = GetHomeIndex(hash);
+
+			for (uint32_t distance = 1; ; ++distance)
+			{
+				if (controls[index].distance < distance || IsMatch(index, hash, equal))
+				{
+					return distance;
+				}
+
+				index = GetNextIndex(index);
+			}
+		}
+
+		void Prefetch(size_t hash) const
+		{
+			if (capacity != 0)
+			{
+				Memory::Prefetch(&controls[GetHomeIndex(hash)]);
+			}
+		}
+
+		void PrefetchEntry(size_t hash) const
+		{
+			if (capacity != 0)
+			{
+				Memory::Prefetch(&slots[GetHomeIndex(hash)]);
+			}
+		}
+
+		void Clear()
+		{
+			if (controls == nullptr)
+				return;
+
+			DestroySlots(controls, slots, capacity);
+
+			delete[] controls;
+			DeallocateSlots(slots);
+
+			controls = nullptr;
+			slots = nullptr;
+
+			size = 0;
+			capacity = 0;
+			maxSize = 0;
+		}
+
+		void Reserve(size_t count)
+		{
+			if (count > maxSize)
+			{
+				ReAlloc(GetCapacityFor(count));
+			}
+		}
+
+		void Rehash(size_t minimumCapacity)
+		{
+			size_t newCapacity = std::max(GetCapacityFor(size), minimumCapacity == 0 ? 0 : Buckets::Fibonacci::GetCapacityFor(minimumCapacity));
+
+			if (newCapacity == 0)
+			{
+				Clear();
+			}
+			else if (newCapacity != capacity)
+			{
+				ReAlloc(newCapacity);
+			}
+		}
+
+		void ShrinkToFit()
+		{
+			Rehash(0);
+		}
+
+		// Probing and the early exit rely on every run ending in an empty slot, so the factor
+		// is capped below one.
+		void SetMaxLoadFactor(float value)
+		{
+			maxLoadFactor = std::min(value, MaxLoadFactorLimit);
+
+			if (capacity != 0)
+			{
+				ReAlloc(std::max(capacity, GetCapacityFor(size)));
+			}
+		}
+
+	private:
+		size_t GetHomeIndex(size_t hash) const
+		{
+			return Buckets::Fibonacci::GetIndex(hash, capacity);
+		}
+
+		size_t GetNextIndex(size_t index) const
+		{
+			return (index + 1) & (capacity - 1);
+		}
+
+		template<typename Equal>
+		bool IsMatch(size_t index, size_t hash, Equal& equal) const
+		{
+			return controls[index].hash == hash && equal(slots[index]);
+		}
+
+		template<typename Equal>
+		size_t FindIndex(size_t hash, Equal& equal) const
+		{
+			if (capacity == 0)
+			{
+				return npos;
+			}
+
+			size_t index = GetHomeIndex(hash);
+
+			for (uint32_t distance = 1; controls[index].distance >= distance; ++distance)
+			{
+				if (IsMatch(index, hash, equal))
+				{
+					return index;
+				}
+
+				index = GetNextIndex(index);
+			}
+
+			return npos;
+		}
+
+		// Finds where the hash belongs in its run and moves the elements from there up to the
+		// next empty slot one slot further, leaving the returned slot free for the new element.
+		size_t MakeRoom(size_t hash)
+		{
+			size_t index = GetHomeIndex(hash);
+			uint32_t distance = 1;
+
+			while (controls[index].distance >= distance)
+			{
+				index = GetNextIndex(index);
+				++distance;
+			}
+
+			size_t empty = index;
+
+			while (!controls[empty].IsEmpty())
+			{
+				empty = GetNextIndex(empty);
+			}
+
+			while (empty != index)
+			{
+				size_t previous = (empty - 1) & (capacity - 1);
+
+				new (&slots[empty]) T(std::move(slots[previous]));
+				slots[previous].~T();
+				controls[empty] = { controls[previous].hash, controls[previous].distance + 1 };
+
+				empty = previous;
+			}
+
+			controls[index] = { hash, distance };
+			return index;
+		}
+
+		// Moves every following element that is away from its home slot back by one, which
+		// closes the gap at the index without a tombstone.
+		void ShiftBack(size_t index)
+		{
+			size_t next = GetNextIndex(index);
+
+			while (controls[next].distance > 1)
+			{
+				new (&slots[index]) T(std::move(slots[next]));
+				slots[next].~T();
+				controls[index] = { controls[next].hash, controls[next].distance - 1 };
+
+				index = next;
+				next = GetNextIndex(next);
+			}
+
+			controls[index].distance = 0;
+		}
+
+		void ReAlloc()
+		{
+			if (capacity == 0)
+			{
+				ReAlloc(Buckets::Fibonacci::GetInitialCapacity());
+				return;
+			}
+
+			ReAlloc(Buckets::Fibonacci::GetNextCapacity(capacity));
+		}
+
+		void ReAlloc(size_t newCapacity)
+		{
+			Control* oldControls = controls;
+			T* oldSlots = slots;
+			size_t oldCapacity = capacity;
+
+			controls = new Control[newCapacity + 1]();
+			slots = AllocateSlots(newCapacity);
+			capacity = newCapacity;
+			maxSize = GetMaxSize(newCapacity);
+
+			// A full sentinel past the last slot stops the iterator.
+			controls[newCapacity].distance = 1;
+
+			if (oldControls == nullptr)
+			{
+				return;
+			}
+
+			for (size_t i = 0; i < oldCapacity; ++i)
+			{
+				if (oldControls[i].IsEmpty())
+				{
+					continue;
+				}
+
+				size_t index = MakeRoom(oldControls[i].hash);
+				new (&slots[index]) T(std::move(oldSlots[i]));
+			}
+
+			DestroySlots(oldControls, oldSlots, oldCapacity);
+
+			delete[] oldControls;
+			DeallocateSlots(oldSlots);
+		}
+
+		size_t GetMaxSize(size_t capacity) const
+		{
+			size_t maxSize = static_cast<size_t>(capacity * static_cast<double>(maxLoadFactor));
+			return std::min(capacity - 1, std::max<size_t>(1, maxSize));
+		}
+
+		size_t GetCapacityFor(size_t count) const
+		{
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			size_t capacity = Buckets::Fibonacci::GetInitialCapacity();
+
+			while (GetMaxSize(capacity) < count)
+			{
+				capacity = Buckets::Fibonacci::GetNextCapacity(capacity);
+			}
+
+			return capacity;
+		}
+
+		static T* AllocateSlots(size_t capacity)
+		{
+			return static_cast<T*>(::operator new(capacity * sizeof(T)));
+		}
+
+		static void DeallocateSlots(T* slots)
+		{
+			::operator delete(slots);
+		}
+
+		static void DestroySlots(const Control* controls, T* slots, size_t capacity)
+		{
+			for (size_t i = 0; i < capacity; ++i)
+			{
+				if (!controls[i].IsEmpty())
+				{
+					slots[i].~T();
+				}
+			}
+		}
+
+	public:
+		size_t GetSize() const { return size; }
+		size_t GetCapacity() const { return capacity; }
+		bool IsEmpty() const { return size == 0; }
+		float GetMaxLoadFactor() const { return maxLoadFactor; }
+		size_t GetTombstoneCount() const { return 0; }
+
+		size_t GetAllocatedBytes() const
+		{
+			return capacity == 0 ? 0 : (capacity + 1) * sizeof(Control) + capacity * sizeof(T);
+		}
+
+	public:
+		Iterator begin() const
+		{
+			if (controls == nullptr)
+			{
+				return Iterator();
+			}
+
+			return Iterator(controls, slots);
+		}
+
+		Iterator end() const
+		{
+			if (controls == nullptr)
+			{
+				return Iterator();
+			}
+
+			return Iterator(controls + capacity, slots + capacity);
+		}
+
+	public:
+		static constexpr float DefaultMaxLoadFactor = 0.9f;
+		static constexpr float MaxLoadFactorLimit = 0.95f;
+
+	private:
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+	private:
+		Control* controls;
+		T* slots;
+
+		size_t size;
+		size_t capacity;
+		size_t maxSize;
+		float maxLoadFactor;
+	};
+
+	namespace Engines
+	{
+		struct RobinHood
+		{
+			template<typename T>
+			using Storage = RobinHoodStorage<T>;
+		};
+	}
+}
@@ -0,0 +1,645 @@
+#pragma once
+#include "../../Collection/IIterator.h"
+#include "ControlGroup.h"
+#include "Prefetch.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace Structs
+{
+	template <typename T>
+	class SwissIterator : public IIterator<T, SwissIterator<T>>
+	{
+	public:
+		SwissIterator()
+			: SwissIterator(nullptr, nullptr)
+		{}
+
+		SwissIterator(const int8_t* control, T* slot)
+			: control(control), slot(slot)
+		{
+			SkipEmptySlots();
+		}
+
+		virtual SwissIterator& operator++() override
+		{
+			++control;
+			++slot;
+			SkipEmptySlots();
+			return *this;
+		}
+
+		virtual SwissIterator& operator++(int) override
+		{
+			SwissIterator temp = *this;
+			++(*this);
+			return temp;
+		}
+
+		virtual bool operator==(const SwissIterator& rhs) const override
+		{
+			return control == rhs.control;
+		}
+
+		virtual bool operator!=(const SwissIterator& rhs) const override
+		{
+			return !(*this == rhs);
+		}
+
+		virtual T& operator*() const override
+		{
+			return *slot;
+		}
+
+		virtual T* operator->() const override
+		{
+			return slot;
+		}
+
+	private:
+		void SkipEmptySlots()
+		{
+			if (control == nullptr)
+			{
+				return;
+			}
+
+			while (Control::IsEmptyOrDeleted(*control))
+			{
+				++control;
+				++slot;
+			}
+		}
+
+	private:
+		const int8_t* control;
+		T* slot;
+	};
+
+	template<typename T>
+	class SwissStorage
+	{
+	public:
+		using Iterator = SwissIterator<T>;
+		using Group = Control::Group;
+
+	public:
+		SwissStorage()
+			: control(nullptr), slots(nullptr), hashes(nullptr), size(0), capacity(0), growthLeft(0), maxLoadFactor(MaxLoadFactorLimit)
+		{}
+
+		SwissStorage(const SwissStorage& storage) = delete;
+		SwissStorage& operator=(const SwissStorage& storage) = delete;
+
+		SwissStorage(SwissStorage&& storage) noexcept
+			:
+			control(storage.control),
+			slots(storage.slots),
+			hashes(storage.hashes),
+			size(storage.size),
+			capacity(storage.capacity),
+			growthLeft(storage.growthLeft),
+			maxLoadFactor(storage.maxLoadFactor)
+		{
+			storage.control = nullptr;
+			storage.slots = nullptr;
+			storage.hashes = nullptr;
+			storage.size = 0;
+			storage.capacity = 0;
+			storage.growthLeft = 0;
+		}
+
+		SwissStorage& operator=(SwissStorage&& storage) noexcept
+		{
+			Clear();
+
+			control = storage.control;
+			slots = storage.slots;
+			hashes = storage.hashes;
+			size = storage.size;
+			capacity = storage.capacity;
+			growthLeft = storage.growthLeft;
+			maxLoadFactor = storage.maxLoadFactor;
+
+			storage.control = nullptr;
+			storage.slots = nullptr;
+			storage.hashes = nullptr;
+			storage.size = 0;
+			storage.capacity = 0;
+			storage.growthLeft = 0;
+
+			return *this;
+		}
+
+		~SwissStorage()
+		{
+			Clear();
+		}
+
+	public:
+		template<typename Equal, typename Create>
+		std::pair<T*, bool> FindOrInsert(size_t hash, Equal equal, Create create)
+		{
+			size_t index = FindIndex(hash, equal);
+
+			if (index != npos)
+			{
+				return { &slots[index], false };
+			}
+
+			index = FindInsertSlot(hash);
+
+			if (index == npos)
+			{
+				// create() may read a value stored here, so it runs before growing moves them.
+				T value = create();
+				Grow();
+
+				index = FindFirstNonFull(hash);
+				new (&slots[index]) T(std::move(value));
+			}
+			else
+			{
+				new (&slots[index]) T(create());
+			}
+
+			SetFull(index, hash);
+
+			return { &slots[index], true };
+		}
+
+		template<typename Equal>
+		bool TryRemove(size_t hash, Equal equal)
+		{
+			size_t index = FindIndex(hash, equal);
+
+			if (index == npos)
+			{
+				return false;
+			}
+
+			EraseAt(index);
+			return true;
+		}
+
+		template<typename Equal>
+		T* Find(size_t hash, Equal equal) const
+		{
+			size_t index = FindIndex(hash, equal);
+
+			if (index == npos)
+			{
+				return nullptr;
+			}
+
+			return &slots[index];
+		}
+
+		// The number of groups a lookup of the key matches before it finds the key or reaches
+		// a group with an empty slot.
+		template<typename Equal>
+		size_t GetProbeLength(size_t hash, Equal equal) const
+		{
+			if (capacity == 0)
+			{
+				return 0;
+			}
+
+			size_t groupMask = capacity / Control::GroupWidth - 1;
+			size_t group = H1(hash) & groupMask;
+			int8_t h2 = H2(hash);
+
+			for (size_t probe = 1; probe <= groupMask + 1; ++probe)
+			{
+				size_t offset = group * Control::GroupWidth;
+				Group controls(control + offset);
+
+				for (Control::BitMask match = controls.Match(h2); match; match.RemoveLowest())
+				{
+					size_t index = offset + match.GetLowest();
+
+					if (hashes[index] == hash && equal(slots[index]))
+					{
+						return probe;
+					}
+				}
+
+				if (controls.MatchEmpty())
+				{
+					return probe;
+				}
+
+				group = (group + probe) & groupMask;
+			}
+
+			return groupMask + 1;
+		}
+
+		void Prefetch(size_t hash) const
+		{
+			if (capacity == 0)
+			{
+				return;
+			}
+
+			size_t offset = GetGroupOffset(hash);
+			Memory::Prefetch(control + offset);
+			Memory::Prefetch(hashes + offset);
+		}
+
+		void PrefetchEntry(size_t hash) const
+		{
+			if (capacity == 0)
+			{
+				return;
+			}
+
+			size_t offset = GetGroupOffset(hash);
+			Control::BitMask match = Group(control + offset).Match(H2(hash));
+
+			if (match)
+			{
+				Memory::Prefetch(&slots[offset + match.GetLowest()]);
+			}
+		}
+
+		void Clear()
+		{
+			if (control == nullptr)
+				return;
+
+			DestroySlots(control, slots, capacity);
+
+			delete[] control;
+			DeallocateSlots(slots);
+			delete[] hashes;
+
+			control = nullptr;
+			slots = nullptr;
+			hashes = nullptr;
+
+			size = 0;
+			capacity = 0;
+			growthLeft = 0;
+		}
+
+		void Reserve(size_t count)
+		{
+			if (count > size + growthLeft)
+			{
+				ReAlloc(std::max(capacity, GetCapacityFor(count)));
+			}
+		}
+
+		void Rehash(size_t minimumCapacity)
+		{
+			size_t newCapacity = std::max(GetCapacityFor(size), RoundUpToGroups(minimumCapacity));
+
+			if (newCapacity == 0)
+			{
+				Clear();
+			}
+			else
+			{
+				ReAlloc(newCapacity);
+			}
+		}
+
+		void ShrinkToFit()
+		{
+			Rehash(0);
+		}
+
+		// Probing relies on every group keeping a free slot, so the factor is capped at 7/8.
+		void SetMaxLoadFactor(float value)
+		{
+			maxLoadFactor = std::min(value, MaxLoadFactorLimit);
+
+			if (capacity != 0)
+			{
+				ReAlloc(std::max(capacity, GetCapacityFor(size)));
+			}
+		}
+
+	private:
+		static size_t Mix(size_t hash)
+		{
+			uint64_t mixed = static_cast<uint64_t>(hash);
+			mixed ^= mixed >> 33;
+			mixed *= 0xff51afd7ed558ccdULL;
+			mixed ^= mixed >> 33;
+			return static_cast<size_t>(mixed);
+		}
+
+		static size_t H1(size_t hash) { return Mix(hash) >> 7; }
+		static int8_t H2(size_t hash) { return static_cast<int8_t>(Mix(hash) & 0x7F); }
+
+		size_t GetGroupOffset(size_t hash) const
+		{
+			size_t groupMask = capacity / Control::GroupWidth - 1;
+			return (H1(hash) & groupMask) * Control::GroupWidth;
+		}
+
+		size_t GetMaxLoad(size_t capacity) const
+		{
+			return std::max<size_t>(1, static_cast<size_t>(capacity * static_cast<double>(maxLoadFactor)));
+		}
+
+		size_t GetCapacityFor(size_t count) const
+		{
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			size_t capacity = Control::GroupWidth;
+
+			while (GetMaxLoad(capacity) < count)
+			{
+				capacity *= 2;
+			}
+
+			return capacity;
+		}
+
+		static size_t RoundUpToGroups(size_t minimumCapacity)
+		{
+			if (minimumCapacity == 0)
+			{
+				return 0;
+			}
+
+			size_t capacity = Control::GroupWidth;
+
+			while (capacity < minimumCapacity)
+			{
+				capacity *= 2;
+			}
+
+			return capacity;
+		}
+
+		template<typename Equal>
+		size_t FindIndex(size_t hash, Equal equal) const
+		{
+			if (capacity == 0)
+			{
+				return npos;
+			}
+
+			size_t groupMask = capacity / Control::GroupWidth - 1;
+			size_t group = H1(hash) & groupMask;
+			int8_t h2 = H2(hash);
+
+			for (size_t probe = 1; probe <= groupMask + 1; ++probe)
+			{
+				size_t offset = group * Control::GroupWidth;
+				Group controls(control + offset);
+
+				for (Control::BitMask match = controls.Match(h2); match; match.RemoveLowest())
+				{
+					size_t index = offset + match.GetLowest();
+
+					if (hashes[index] == hash && equal(slots[index]))
+					{
+						return index;
+					}
+				}
+
+				if (controls.MatchEmpty())
+				{
+					return npos;
+				}
+
+				group = (group + probe) & groupMask;
+			}
+
+			return npos;
+		}
+
+		size_t FindFirstNonFull(size_t hash) const
+		{
+			size_t groupMask = capacity / Control::GroupWidth - 1;
+			size_t group = H1(hash) & groupMask;
+
+			for (size_t probe = 1; ; ++probe)
+			{
+				size_t offset = group * Control::GroupWidth;
+				Control::BitMask free = Group(control + offset).MatchEmptyOrDeleted();
+
+				if (free)
+				{
+					return offset + free.GetLowest();
+				}
+
+				group = (group + probe) & groupMask;
+			}
+		}
+
+		// The slot a new value goes to, or npos when the table has to grow first.
+		size_t FindInsertSlot(size_t hash) const
+		{
+			if (capacity == 0)
+			{
+				return npos;
+			}
+
+			size_t index = FindFirstNonFull(hash);
+
+			if (growthLeft == 0 && control[index] == Control::Empty)
+			{
+				return npos;
+			}
+
+			return index;
+		}
+
+		void Grow()
+		{
+			if (capacity == 0)
+			{
+				ReAlloc(Control::GroupWidth);
+				return;
+			}
+
+			ReAlloc();
+		}
+
+		void SetFull(size_t index, size_t hash)
+		{
+			if (control[index] == Control::Empty)
+			{
+				--growthLeft;
+			}
+
+			control[index] = H2(hash);
+			hashes[index] = hash;
+			++size;
+		}
+
+		void EraseAt(size_t index)
+		{
+			size_t offset = index - index % Control::GroupWidth;
+			bool wasNeverFull = static_cast<bool>(Group(control + offset).MatchEmpty());
+			slots[index].~T();
+
+			if (wasNeverFull)
+			{
+				control[index] = Control::Empty;
+				++growthLeft;
+			}
+			else
+			{
+				control[index] = Control::Deleted;
+			}
+
+			--size;
+		}
+
+		void ReAlloc()
+		{
+			if (size * 28 <= GetMaxLoad(capacity) * 25)
+			{
+				ReAlloc(capacity);
+				return;
+			}
+
+			size_t newCapacity = capacity * 2;
+			ReAlloc(newCapacity);
+		}
+
+		void ReAlloc(size_t newCapacity)
+		{
+			int8_t* oldControl = control;
+			T* oldSlots = slots;
+			size_t* oldHashes = hashes;
+			size_t oldCapacity = capacity;
+
+			control = new int8_t[newCapacity + 1];
+			slots = AllocateSlots(newCapacity);
+			hashes = new size_t[newCapacity];
+			capacity = newCapacity;
+			growthLeft = GetMaxLoad(newCapacity);
+
+			for (size_t i = 0; i < newCapacity; ++i)
+			{
+				control[i] = Control::Empty;
+			}
+
+			control[newCapacity] = Control::Sentinel;
+
+			if (oldControl == nullptr)
+			{
+				return;
+			}
+
+			for (size_t i = 0; i < oldCapacity; ++i)
+			{
+				if (!Control::IsFull(oldControl[i]))
+				{
+					continue;
+				}
+
+				size_t hash = oldHashes[i];
+				size_t index = FindFirstNonFull(hash);
+
+				control[index] = H2(hash);
+				hashes[index] = hash;
+				new (&slots[index]) T(std::move(oldSlots[i]));
+				--growthLeft;
+			}
+
+			DestroySlots(oldControl, oldSlots, oldCapacity);
+
+			delete[] oldControl;
+			DeallocateSlots(oldSlots);
+			delete[] oldHashes;
+		}
+
+		static T* AllocateSlots(size_t capacity)
+		{
+			return static_cast<T*>(::operator new(capacity * sizeof(T)));
+		}
+
+		static void DeallocateSlots(T* slots)
+		{
+			::operator delete(slots);
+		}
+
+		static void DestroySlots(const int8_t* control, T* slots, size_t capacity)
+		{
+			for (size_t i = 0; i < capacity; ++i)
+			{
+				if (Control::IsFull(control[i]))
+				{
+					slots[i].~T();
+				}
+			}
+		}
+
+	public:
+		size_t GetSize() const { return size; }
+		size_t GetCapacity() const { return capacity; }
+		bool IsEmpty() const { return size == 0; }
+		float GetMaxLoadFactor() const { return maxLoadFactor; }
+
+		// Every slot taken from the growth budget is either full or a deleted marker.
+		size_t GetTombstoneCount() const
+		{
+			return capacity == 0 ? 0 : GetMaxLoad(capacity) - growthLeft - size;
+		}
+
+		size_t GetAllocatedBytes() const
+		{
+			return capacity == 0 ? 0 : capacity + 1 + capacity * (sizeof(T) + sizeof(size_t));
+		}
+
+	public:
+		Iterator begin() const
+		{
+			if (control == nullptr)
+			{
+				return Iterator();
+			}
+
+			return Iterator(control, slots);
+		}
+
+		Iterator end() const
+		{
+			if (control == nullptr)
+			{
+				return Iterator();
+			}
+
+			return Iterator(control + capacity, slots + capacity);
+		}
+
+	public:
+		static constexpr float MaxLoadFactorLimit = 0.875f;
+
+	private:
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+	private:
+		int8_t* control;
+		T* slots;
+		size_t* hashes;
+
+		size_t size;
+		size_t capacity;
+		size_t growthLeft;
+		float maxLoadFactor;
+	};
+
+	namespace Engines
+	{
+		struct Swiss
+		{
+			template<typename T>
+			using Storage = SwissStorage<T>;
+		};
+	}
+}
@@ -0,0 +1,316 @@
+#pragma once
+#include "Hashers.h"
+#include "KeySelectors.h"
+#include "PerfectHash.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Structs
+{
+	// An immutable table over a minimal perfect hash of its keys: values are stored densely,
+	// one slot per value, and every lookup reads one displacement and compares one key.
+	template<typename Key,
+		typename Value = Key,
+		typename KeySelector = Keys::NoSelector<Key>,
+		typename Hasher = Hashers::Default<Key>>
+		class FrozenHashTable final
+	{
+	private:
+		static_assert(Keys::IsSelector<KeySelector, Key, Value>::value, "KeySelector must return const Key& for a const Value&");
+
+	public:
+		using Displacement = PerfectHash::Displacement;
+
+	public:
+		FrozenHashTable()
+			: values(nullptr), displacements(nullptr), size(0), bucketCount(0)
+		{}
+
+		// Copies the values of the range. Throws std::invalid_argument if two values have equal
+		// keys or two keys have equal hashes.
+		template<typename Iterator>
+		FrozenHashTable(Iterator first, Iterator last)
+			: FrozenHashTable(first, last, Hasher())
+		{}
+
+		// For hashers that carry a seed or a secret.
+		template<typename Iterator>
+		FrozenHashTable(Iterator first, Iterator last, const Hasher& hasher)
+			: values(nullptr), displacements(nullptr), size(0), bucketCount(0), hasher(hasher)
+		{
+			std::vector<const Value*> sources;
+
+			for (; first != last; ++first)
+			{
+				sources.push_back(&*first);
+			}
+
+			Build(sources);
+		}
+
+		FrozenHashTable(const FrozenHashTable& table) = delete;
+		FrozenHashTable& operator=(const FrozenHashTable& table) = delete;
+
+		FrozenHashTable(FrozenHashTable&& table) noexcept
+			: values(table.values), displacements(table.displacements), size(table.size), bucketCount(table.bucketCount), hasher(std::move(table.hasher))
+		{
+			table.values = nullptr;
+			table.displacements = nullptr;
+			table.size = 0;
+			table.bucketCount = 0;
+		}
+
+		FrozenHashTable& operator=(FrozenHashTable&& table) noexcept
+		{
+			Clear();
+
+			values = table.values;
+			displacements = table.displacements;
+			size = table.size;
+			bucketCount = table.bucketCount;
+			hasher = std::move(table.hasher);
+
+			table.values = nullptr;
+			table.displacements = nullptr;
+			table.size = 0;
+			table.bucketCount = 0;
+
+			return *this;
+		}
+
+		~FrozenHashTable()
+		{
+			Clear();
+		}
+
+	public:
+		const Value* Find(const Key& key) const
+		{
+			if (size == 0)
+			{
+				return nullptr;
+			}
+
+			uint64_t hash = hasher(key);
+			Displacement displacement = displacements[PerfectHash::GetBucket(hash, bucketCount)];
+			const Value& value = values[PerfectHash::GetSlot(hash, displacement, size)];
+
+			if (!(keySelector(value) == key))
+			{
+				return nullptr;
+			}
+
+			return &value;
+		}
+
+		bool Contains(const Key& key) const
+		{
+			return Find(key) != nullptr;
+		}
+
+	public:
+		size_t GetSize() const { return size; }
+		bool IsEmpty() const { return size == 0; }
+
+		// The memory the table owns, to compare layouts.
+		size_t GetAllocatedBytes() const
+		{
+			return size * sizeof(Value) + bucketCount * sizeof(Displacement);
+		}
+
+	public:
+		const Value* begin() const
+		{
+			return values;
+		}
+
+		const Value* end() const
+		{
+			return values + size;
+		}
+
+	private:
+		void Build(const std::vector<const Value*>& sources)
+		{
+			size_t count = sources.size();
+
+			if (count == 0)
+			{
+				return;
+			}
+
+			std::vector<uint64_t> hashes(count);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				hashes[i] = hasher(keySelector(*sources[i]));
+			}
+
+			size_t buckets = PerfectHash::GetBucketCount(count);
+			std::vector<size_t> slots(count);
+			std::vector<size_t> bucketStarts(buckets + 1);
+			std::vector<size_t> order(count);
+			std::unique_ptr<bool[]> taken(new bool[count]);
+			Displacement* built = new Displacement[buckets];
+
+			if (!PerfectHash::Build(hashes.data(), count, built, buckets, slots.data(), bucketStarts.data(), order.data(), taken.get()))
+			{
+				delete[] built;
+				throw std::invalid_argument("Keys must be unique and have unique hashes");
+			}
+
+			values = static_cast<Value*>(::operator new(count * sizeof(Value)));
+			displacements = built;
+			bucketCount = buckets;
+
+			// Filled slot by slot, so that the constructed values are always a prefix to destroy.
+			for (size_t i = 0; i < count; ++i)
+			{
+				order[slots[i]] = i;
+			}
+
+			for (size_t slot = 0; slot < count; ++slot)
+			{
+				new (&values[slot]) Value(*sources[order[slot]]);
+				++size;
+			}
+		}
+
+		void Clear()
+		{
+			if (values != nullptr)
+			{
+				for (size_t i = 0; i < size; ++i)
+				{
+					values[i].~Value();
+				}
+
+				::operator delete(values);
+			}
+
+			delete[] displacements;
+
+			values = nullptr;
+			displacements = nullptr;
+			size = 0;
+			bucketCount = 0;
+		}
+
+	private:
+		Value* values;
+		Displacement* displacements;
+		size_t size;
+		size_t bucketCount;
+
+		Hasher hasher;
+		KeySelector keySelector;
+	};
+
+	// The same layout with its size fixed at compile time, so that a table of literal keys can
+	// be built by a constant expression and live in read-only data.
+	template<typename Key,
+		typename Value,
+		size_t Size,
+		typename KeySelector = Keys::NoSelector<Key>,
+		typename Hasher = PerfectHash::ConstexprHash<Key>>
+		class StaticFrozenHashTable final
+	{
+	private:
+		static_assert(Size > 0, "A static frozen table needs at least one value");
+
+	public:
+		using Displacement = PerfectHash::Displacement;
+		static constexpr size_t BucketCount = PerfectHash::GetBucketCount(Size);
+
+	public:
+		// Throws std::invalid_argument, which fails a constant expression, if two values have
+		// equal keys or two keys have equal hashes.
+		constexpr explicit StaticFrozenHashTable(const std::array<Value, Size>& sources)
+			: StaticFrozenHashTable(sources, Place(sources), std::make_index_sequence<Size>())
+		{}
+
+	public:
+		constexpr const Value* Find(const Key& key) const
+		{
+			uint64_t hash = Hasher()(key);
+			Displacement displacement = displacements[PerfectHash::GetBucket(hash, BucketCount)];
+			const Value& value = values[PerfectHash::GetSlot(hash, displacement, Size)];
+
+			if (!(KeySelector()(value) == key))
+			{
+				return nullptr;
+			}
+
+			return &value;
+		}
+
+		constexpr bool Contains(const Key& key) const
+		{
+			return Find(key) != nullptr;
+		}
+
+	public:
+		constexpr size_t GetSize() const { return Size; }
+		constexpr bool IsEmpty() const { return false; }
+
+	public:
+		constexpr const Value* begin() const
+		{
+			return values.data();
+		}
+
+		constexpr const Value* end() const
+		{
+			return values.data() + Size;
+		}
+
+	private:
+		struct Placement
+		{
+		public:
+			std::array<Displacement, BucketCount> displacements;
+			std::array<size_t, Size> sourceOf;
+		};
+
+		static constexpr Placement Place(const std::array<Value, Size>& sources)
+		{
+			std::array<uint64_t, Size> hashes{};
+			std::array<size_t, Size> slots{};
+			std::array<size_t, BucketCount + 1> bucketStarts{};
+			std::array<size_t, Size> order{};
+			std::array<bool, Size> taken{};
+			Placement placement{};
+
+			for (size_t i = 0; i < Size; ++i)
+			{
+				hashes[i] = Hasher()(KeySelector()(sources[i]));
+			}
+
+			if (!PerfectHash::Build(hashes.data(), Size, placement.displacements.data(), BucketCount, slots.data(), bucketStarts.data(), order.data(), taken.data()))
+			{
+				throw std::invalid_argument("Keys must be unique and have unique hashes");
+			}
+
+			for (size_t i = 0; i < Size; ++i)
+			{
+				placement.sourceOf[slots[i]] = i;
+			}
+
+			return placement;
+		}
+
+		template<size_t... Slots>
+		constexpr StaticFrozenHashTable(const std::array<Value, Size>& sources, const Placement& placement, std::index_sequence<Slots...>)
+			: values{ { sources[placement.sourceOf[Slots]]... } }, displacements(placement.displacements)
+		{}
+
+	private:
+		std::array<Value, Size> values;
+		std::array<Displacement, BucketCount> displacements;
+	};
+}
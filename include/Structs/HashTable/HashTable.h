@@ -2,287 +2,110 @@
 #include <stdexcept>
 #include "../Collection/ICollection.h"
 #include "../Collection/IIterable.h"
+#include "Hashers.h"
 #include "KeySelectors.h"
+#include "Engines/ChainedEngine.h"
+#include "Engines/CuckooEngine.h"
+#include "Engines/IncrementalChainedEngine.h"
+#include "Engines/InstrumentedEngine.h"
+#include "Engines/RobinHoodEngine.h"
+#include "Engines/SwissEngine.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <type_traits>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace Structs
 {
-	template<typename T>
-	class HashTableElement
+	template<typename Key,
+		typename Value = Key,
+		typename KeySelector = Keys::NoSelector<Key>,
+		typename Hasher = Hashers::Default<Key>,
+		typename Engine = Engines::Chained<>>
+		class HashTable final : public IIterable<Value, typename Engine::template Storage<Value>::Iterator>, public ICollection
 	{
-	public:
-		HashTableElement()
-			: hash(0), nextIndex(0), hasValue(false), hasNext(false)
-		{}
-
-	public:
-		bool operator==(const T& rhs) const
-		{
-			return hasValue && value == rhs;
-		}
-
-		bool operator!=(const T& rhs) const
-		{
-			return !(*this == rhs);
-		}
-
-	public:
-		void SetValue(const T& value, size_t hash) { this->value = value; this->hash = hash; hasValue = true; }
-		void ResetValue() { hasValue = false; }
-		T& GetValue() { return value; }
-
-		size_t GetHash() const { return hash; }
-
-		void SetNextIndex(size_t value) { nextIndex = value; hasNext = true; }
-		void ResetNextIndex() { nextIndex = 0; hasNext = false; }
-		size_t GetNextIndex() const { return nextIndex; }
-
-		bool HasValue() const { return hasValue; }
-		bool HasNext() const { return hasNext; }
-
 	private:
-		T value;
-		size_t hash;
-		size_t nextIndex;
-		bool hasValue;
-		bool hasNext;
-	};
+		static_assert(Keys::IsSelector<KeySelector, Key, Value>::value, "KeySelector must return const Key& for a const Value&");
 
-	template<typename T>
-	class BucketElement
-	{
-	public:
-		BucketElement()
-			: elementIndex(0), hasElement(false)
-		{}
+		// Keys of other types are hashed and compared as they are when the hasher is
+		// transparent, so a string_view finds a string key without copying it.
+		template<typename Lookup>
+		using IfLookup = std::enable_if_t<Hashers::IsTransparent<Hasher>::value && !std::is_same<Lookup, Key>::value>;
 
 	public:
-		void SetElementIndex(size_t value) { elementIndex = value; hasElement = true; }
-		void ResetElementIndex() { elementIndex = 0; hasElement = false; }
-		size_t GetElementIndex() const { return elementIndex; }
-
-		bool HasElement() const { return hasElement; }
-
-	private:
-		size_t elementIndex;
-		bool hasElement;
-	};
-
-	template <typename T>
-	class HashTableIterator : public IIterator<T, HashTableIterator<T>>
-	{
-	private:
-		using Element = HashTableElement<T>;
+		using Storage = typename Engine::template Storage<Value>;
+		using Iterator = typename Storage::Iterator;
 
 	public:
-		HashTableIterator()
-			: HashTableIterator(nullptr, true)
+		HashTable()
+			: storage()
 		{}
 
-		HashTableIterator(Element* element)
-			: HashTableIterator(element, false)
+		// For hashers that carry a seed or a secret.
+		explicit HashTable(const Hasher& hasher)
+			: hasher(hasher), storage()
 		{}
 
-		HashTableIterator(Element* element, bool isInvalid)
-			: currentElement(element), isInvalid(isInvalid)
+		HashTable(HashTable&& set) noexcept
+			: hasher(std::move(set.hasher)), storage(std::move(set.storage))
 		{}
 
-		virtual HashTableIterator& operator++() override
+		HashTable& operator=(HashTable&& set) noexcept
 		{
-			if (isInvalid)
-			{
-				return *this;
-			}
-
-			do
-			{
-				++currentElement;
-			} while (!currentElement->HasValue());
-
+			hasher = std::move(set.hasher);
+			storage = std::move(set.storage);
 			return *this;
 		}
 
-		virtual HashTableIterator& operator++(int) override
-		{
-			HashTableIterator temp = *this;
-			++(*this);
-			return temp;
-		}
-
-		HashTableIterator& operator--()
-		{
-			if (isInvalid)
-			{
-				return *this;
-			}
-
-			do
-			{
-				--currentElement;
-			} while (!currentElement->HasValue());
-
-			return *this;
-		}
-
-		HashTableIterator& operator--(int)
-		{
-			HashTableIterator temp = *this;
-			--(*this);
-			return temp;
-		}
-
-		virtual bool operator==(const HashTableIterator& rhs) const override
+		~HashTable()
 		{
-			if (isInvalid)
-			{
-				return true;
-			}
-
-			isInvalid = currentElement == rhs.currentElement;
-			return false;
+			Clear();
 		}
 
-		virtual bool operator!=(const HashTableIterator& rhs) const override
+	public:
+		void Insert(const Value& value)
 		{
-			return !(*this == rhs);
+			ThrowIfNotInserted(TryInsert(value));
 		}
 
-		virtual T& operator*() const override
+		void Insert(Value&& value)
 		{
-			return currentElement->GetValue();
+			ThrowIfNotInserted(TryInsert(std::move(value)));
 		}
 
-		virtual T* operator->() const override
+		template<typename... Args>
+		void Emplace(const Key& key, Args&&... args)
 		{
-			return &(currentElement->GetValue());
+			ThrowIfNotInserted(TryEmplace(key, std::forward<Args>(args)...));
 		}
 
-	private:
-		Element* currentElement;
-		mutable bool isInvalid;
-	};
-
-
-	template<typename Key,
-		typename Value = Key,
-		typename KeySelector = Keys::NoSelector<Key>,
-		typename Hasher = std::hash<Key>>
-		class HashTable final : public IIterable<Value, HashTableIterator<Value>>, public ICollection
-	{
-	private:
-		static_assert(std::is_base_of<Keys::Selector<Key, Value>, KeySelector>::value, "KeySelector mast be derivied from Structs::Keys::Selector");
-
-	public:
-		using Iterator = HashTableIterator<Value>;
-		using Element = HashTableElement<Value>;
-		using Bucket = BucketElement<Value>;
-
-	public:
-		HashTable()
-			: elements(nullptr), buckets(nullptr), size(0), capacity(0), lastElementIndex(0)
-		{
-			ReAlloc(5);
-		}
-
-		HashTable(HashTable&& set)
-			:
-			elements(std::move(set.elements)),
-			buckets(std::move(set.buckets)),
-			size(set.size),
-			capacity(set.capacity),
-			lastElementIndex(set.lastElementIndex)
-		{
-			set.elements = nullptr;
-			set.buckets = nullptr;
-			set.size = 0;
-			set.capacity = 0;
-			set.lastElementIndex = 0;
-		}
-
-		HashTable& operator=(HashTable&& set) noexcept
+		bool TryInsert(const Value& value)
 		{
-			elements = std::move(set.elements);
-			buckets = std::move(set.buckets);
-			size = set.size;
-			capacity = set.capacity;
-			lastElementIndex = set.lastElementIndex;
-
-			set.elements = nullptr;
-			set.buckets = nullptr;
-			set.size = 0;
-			set.capacity = 0;
-			set.lastElementIndex = 0;
+			const Key& key = keySelector(value);
+			return FindOrInsert(key, [&value]() { return value; }).second;
 		}
 
-		~HashTable()
+		// The key refers into the value it is moved out of, which is safe because storages
+		// call create only after they are done comparing keys.
+		bool TryInsert(Value&& value)
 		{
-			Clear();
+			const Key& key = keySelector(value);
+			return FindOrInsert(key, [&value]() { return std::move(value); }).second;
 		}
 
-	public:
-		void Insert(const Value& value)
+		template<typename... Args>
+		bool TryEmplace(const Key& key, Args&&... args)
 		{
-			bool result = TryInsert(value);
-
-			if (!result)
-			{
-				throw std::invalid_argument("Already contain value");
-			}
+			return FindOrInsert(key, [&]() { return Value(std::forward<Args>(args)...); }).second;
 		}
 
-		bool TryInsert(const Value& value)
+		template<typename Create>
+		std::pair<Value*, bool> FindOrInsert(const Key& key, Create create)
 		{
-			if (lastElementIndex >= capacity || size / capacity > fillValue)
-			{
-				ReAlloc();
-			}
-
-			Key key = keySelector(value);
 			size_t hash = hasher(key);
-			Bucket& bucket = GetBucketByHash(hash);
-
-			if (!(bucket.HasElement()))
-			{
-				size_t elementIndex = lastElementIndex;
-				elements[elementIndex].SetValue(value, hash);
-				bucket.SetElementIndex(elementIndex);
-				++lastElementIndex;
-				++size;
-
-				return true;
-			}
-
-			size_t next = bucket.GetElementIndex();
-			Element* element = &elements[next];
-			Key elementKey = keySelector(element->GetValue());
-
-			while (element->HasNext() && element->HasValue() && elementKey != key)
-			{
-				next = element->GetNextIndex();
-				element = &elements[next];
-				elementKey = keySelector(element->GetValue());
-			}
-
-			if (!element->HasValue())
-			{
-				element->SetValue(value, hash);
-				++size;
-
-				return true;
-			}
-
-			if (elementKey == key)
-			{
-				return false;
-			}
-
-			size_t elementIndex = lastElementIndex;
-			elements[elementIndex].SetValue(value, hash);
-			element->SetNextIndex(elementIndex);
-			++lastElementIndex;
-			++size;
-
-			return true;
+			return storage.FindOrInsert(hash, GetEqual(key), create);
 		}
 
 		void Remove(const Key& key)
@@ -297,238 +120,287 @@ namespace Structs
 
 		bool TryRemove(const Key& key)
 		{
-			Element* element = FindElement(key);
-
-			if (element == nullptr)
-			{
-				return false;
-			}
-
-			element->ResetValue();
-			return true;
+			size_t hash = hasher(key);
+			return storage.TryRemove(hash, GetEqual(key));
 		}
 
 		bool Contains(const Key& key)
 		{
-			Element* element = FindElement(key);
-			return element != nullptr;
+			return Find(key) != nullptr;
 		}
 
-		virtual void Clear() override
+		bool Contains(const Key& key) const
 		{
-			if (elements == nullptr)
-				return;
+			return Find(key) != nullptr;
+		}
 
-			delete[] elements;
-			delete[] buckets;
+		Value* Find(const Key& key)
+		{
+			size_t hash = hasher(key);
+			return storage.Find(hash, GetEqual(key));
+		}
 
-			elements = nullptr;
-			buckets = nullptr;
+		const Value* Find(const Key& key) const
+		{
+			size_t hash = hasher(key);
+			return storage.Find(hash, GetEqual(key));
+		}
 
-			lastElementIndex = 0;
-			capacity = 0;
-			size = 0;
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryRemove(const Lookup& key)
+		{
+			size_t hash = hasher(key);
+			return storage.TryRemove(hash, GetEqual(key));
 		}
 
-	private:
-		Bucket& GetBucketByHash(size_t hash, Bucket* buckets, size_t capacity)
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool Contains(const Lookup& key)
 		{
-			size_t bucketIndex = hash % capacity;
-			return buckets[bucketIndex];
+			return Find(key) != nullptr;
 		}
 
-		Bucket& GetBucketByElement(const Element& element, Bucket* buckets, size_t capacity)
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool Contains(const Lookup& key) const
 		{
-			size_t hash = element.GetHash();
-			return GetBucketByHash(hash, buckets, capacity);
+			return Find(key) != nullptr;
 		}
 
-		Bucket& GetBucket(const Key& key, Bucket* buckets, size_t capacity)
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		Value* Find(const Lookup& key)
 		{
 			size_t hash = hasher(key);
-			return GetBucketByHash(hash, buckets, capacity);
+			return storage.Find(hash, GetEqual(key));
 		}
 
-		Bucket& GetBucketByHash(size_t hash)
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		const Value* Find(const Lookup& key) const
 		{
-			return GetBucketByHash(hash, buckets, capacity);
+			size_t hash = hasher(key);
+			return storage.Find(hash, GetEqual(key));
 		}
 
-		Bucket& GetBucketByElement(const Element& element)
+		// For callers that already hashed the key with this table's hasher, such as to pick a
+		// shard by it.
+		template<typename Create>
+		std::pair<Value*, bool> FindOrInsert(const Key& key, size_t hash, Create create)
 		{
-			return GetBucketByElement(element, buckets, capacity);
+			return storage.FindOrInsert(hash, GetEqual(key), create);
 		}
 
-		Bucket& GetBucket(const Key& key)
+		// The key may be of another type only when the hasher is transparent.
+		template<typename Lookup>
+		bool TryRemove(const Lookup& key, size_t hash)
 		{
-			return GetBucket(key, buckets, capacity);
+			return storage.TryRemove(hash, GetEqual(key));
 		}
 
+		template<typename Lookup>
+		const Value* Find(const Lookup& key, size_t hash) const
+		{
+			return storage.Find(hash, GetEqual(key));
+		}
 
-		void ReAlloc()
+		void ContainsMany(const Key* keys, size_t count, bool* found)
 		{
-			if (capacity == 0)
-			{
-				ReAlloc(5);
-				return;
-			}
+			VisitMany(keys, count, [found](size_t index, Value* value) { found[index] = value != nullptr; });
+		}
 
-			size_t newCapacity = capacity * 2;
-			ReAlloc(newCapacity);
+		void FindMany(const Key* keys, size_t count, Value** values)
+		{
+			VisitMany(keys, count, [values](size_t index, Value* value) { values[index] = value; });
 		}
 
-		void ReAlloc(size_t newCapacity)
+		// Looks keys up in batches: every key of a batch is hashed and its bucket prefetched,
+		// then the first entry of each bucket is prefetched, and only then are the keys
+		// compared, so the cache misses of a batch overlap instead of following each other.
+		template<typename Visit>
+		void VisitMany(const Key* keys, size_t count, Visit visit)
 		{
-			Bucket* newBuckets = new Bucket[newCapacity];
-			Element* newElements = new Element[newCapacity];
+			size_t hashes[BatchSize];
 
-			if (elements != nullptr)
+			for (size_t first = 0; first < count; first += BatchSize)
 			{
-				size_t newLastElementIndex = 0;
+				size_t batch = std::min(BatchSize, count - first);
 
-				for (size_t i = 0; i < lastElementIndex; ++i)
+				for (size_t i = 0; i < batch; ++i)
 				{
-					if (TryMoveElement(i, newLastElementIndex, newElements))
-					{
-						++newLastElementIndex;
-					}
+					hashes[i] = hasher(keys[first + i]);
+					storage.Prefetch(hashes[i]);
 				}
 
-				for (size_t i = 0; i < size; ++i)
+				for (size_t i = 0; i < batch; ++i)
 				{
-					RehashElement(i, newBuckets, newElements, newCapacity);
+					storage.PrefetchEntry(hashes[i]);
 				}
 
-				lastElementIndex = newLastElementIndex;
-				delete[] elements;
-				delete[] buckets;
-			}
+				// A lookup through the const storage changes nothing, so the values found earlier
+				// in the batch stay where they are even in an engine that migrates on access.
+				const Storage& lookup = storage;
 
-			capacity = newCapacity;
-			elements = newElements;
-			buckets = newBuckets;
+				for (size_t i = 0; i < batch; ++i)
+				{
+					const Key& key = keys[first + i];
+					visit(first + i, lookup.Find(hashes[i], GetEqual(key)));
+				}
+			}
 		}
 
-		bool TryMoveElement(const size_t elementIndex, const size_t newElementIndex, Element* const newElements)
+		// Inserts the values of a random access range, hashing them on the given number of
+		// threads (0 for one per core). An empty table with an engine that supports it is also
+		// filled in parallel; otherwise the values go in one by one. Returns the positions in
+		// the range of the values left out because their key was already in the table or
+		// earlier in the range.
+		template<typename RandomAccessIterator>
+		std::vector<size_t> BulkBuild(RandomAccessIterator first, RandomAccessIterator last, size_t threads = 0)
 		{
-			Element& element = elements[elementIndex];
+			size_t count = static_cast<size_t>(last - first);
+			threads = Parallel::GetThreadCount(threads, count);
+
+			std::vector<size_t> hashes(count);
 
-			if (element.HasValue())
+			Parallel::For(threads, count, [this, first, &hashes](size_t begin, size_t end)
 			{
-				newElements[newElementIndex] = std::move(element);
-				return true;
-			}
+				for (size_t i = begin; i < end; ++i)
+				{
+					hashes[i] = hasher(keySelector(first[i]));
+				}
+			});
 
-			return false;
+			return BulkBuild(first, hashes, threads, Engines::CanBulkInsert<Storage>());
 		}
 
-		void RehashElement(const size_t elementIndex, Bucket* const buckets, Element* const elements, size_t capacity)
+		virtual void Clear() override
 		{
-			Element& elementToRehash = elements[elementIndex];
-			elementToRehash.ResetNextIndex();
+			storage.Clear();
+		}
 
-			Bucket& bucket = GetBucketByElement(elementToRehash, buckets, capacity);
+		void Reserve(size_t count)
+		{
+			storage.Reserve(count);
+		}
 
-			if (!bucket.HasElement())
-			{
-				bucket.SetElementIndex(elementIndex);
-				return;
-			}
+		void Rehash(size_t capacity)
+		{
+			storage.Rehash(capacity);
+		}
 
-			size_t next = bucket.GetElementIndex();
-			Element* element = &elements[next];
+		void ShrinkToFit()
+		{
+			storage.ShrinkToFit();
+		}
 
-			while (element->HasNext())
+		void SetMaxLoadFactor(float value)
+		{
+			if (!(value > 0))
 			{
-				next = element->GetNextIndex();
-				element = &elements[next];
+				throw std::invalid_argument("Max load factor must be positive");
 			}
 
-			element->SetNextIndex(elementIndex);
+			storage.SetMaxLoadFactor(value);
 		}
 
-	private:
-		Element* const FindElement(const Key& key)
+		// Only tables with an Engines::Instrumented engine keep the rehash counters, so only
+		// they can take a snapshot. The probe lengths are measured here, one lookup per value.
+		HashTableStats GetStats() const
 		{
-			Bucket& bucket = GetBucket(key);
+			static_assert(Engines::IsInstrumented<Engine>::value, "Stats need an Engines::Instrumented engine");
+
+			HashTableStats stats = storage.GetStats();
 
-			if (!bucket.HasElement())
+			for (const Value& value : storage)
 			{
-				return nullptr;
+				const Key& key = keySelector(value);
+				size_t length = storage.GetProbeLength(hasher(key), GetEqual(key));
+
+				if (length >= stats.probeLengths.size())
+				{
+					stats.probeLengths.resize(length + 1);
+				}
+
+				++stats.probeLengths[length];
+				stats.maxProbeLength = std::max(stats.maxProbeLength, length);
 			}
 
-			size_t index = bucket.GetElementIndex();
-			Element* element = &elements[index];
-			Key elementKey = keySelector(element->GetValue());
+			return stats;
+		}
 
-			while (!(element->HasValue() && elementKey == key) && element->HasNext())
+		void DumpDistribution(std::ostream& stream) const
+		{
+			GetStats().DumpDistribution(stream);
+		}
+
+	private:
+		static void ThrowIfNotInserted(bool inserted)
+		{
+			if (!inserted)
 			{
-				index = element->GetNextIndex();
-				element = &elements[index];
-				elementKey = keySelector(element->GetValue());
+				throw std::invalid_argument("Already contain value");
 			}
+		}
 
-			if (!(element->HasValue() && elementKey == key))
+		template<typename RandomAccessIterator>
+		std::vector<size_t> BulkBuild(RandomAccessIterator first, const std::vector<size_t>& hashes, size_t threads, std::true_type)
+		{
+			if (!storage.IsEmpty())
 			{
-				return nullptr;
+				return BulkBuild(first, hashes, threads, std::false_type());
 			}
 
-			return element;
+			return storage.BulkInsert(hashes.data(), hashes.size(), threads,
+				[this, first](size_t i, const Value& value) { return keySelector(value) == keySelector(first[i]); },
+				[first](size_t i) { return Value(first[i]); });
 		}
 
-		Element* GetLastValidElement() const
+		template<typename RandomAccessIterator>
+		std::vector<size_t> BulkBuild(RandomAccessIterator first, const std::vector<size_t>& hashes, size_t, std::false_type)
 		{
-			for (size_t i = lastElementIndex - 1; i >= 0; --i)
+			std::vector<size_t> duplicates;
+			storage.Reserve(storage.GetSize() + hashes.size());
+
+			for (size_t i = 0; i < hashes.size(); ++i)
 			{
-				if (elements[i].HasValue())
+				const Key& key = keySelector(first[i]);
+
+				if (!storage.FindOrInsert(hashes[i], GetEqual(key), [first, i]() { return Value(first[i]); }).second)
 				{
-					return &elements[i];
+					duplicates.push_back(i);
 				}
 			}
 
-			return nullptr;
+			return duplicates;
+		}
+
+		template<typename Lookup>
+		auto GetEqual(const Lookup& key) const
+		{
+			return [this, &key](const Value& value) { return keySelector(value) == key; };
 		}
 
 	public:
-		virtual size_t GetSize() const override { return size; }
-		virtual bool IsEmpty() const override { return size == 0; }
+		virtual size_t GetSize() const override { return storage.GetSize(); }
+		virtual bool IsEmpty() const override { return storage.IsEmpty(); }
+		size_t GetCapacity() const { return storage.GetCapacity(); }
+		float GetMaxLoadFactor() const { return storage.GetMaxLoadFactor(); }
+		size_t GetAllocatedBytes() const { return storage.GetAllocatedBytes(); }
+		const Hasher& GetHasher() const { return hasher; }
 
 	public:
 		virtual Iterator begin() const override
 		{
-			if (IsEmpty())
-			{
-				return Iterator(nullptr, true);
-			}
-
-			return Iterator(&elements[0]);
+			return storage.begin();
 		}
 
 		virtual Iterator end() const override
 		{
-			if (IsEmpty())
-			{
-				return Iterator(nullptr, true);
-			}
-
-			return Iterator(GetLastValidElement());
+			return storage.end();
 		}
 
 	private:
-		const static float fillValue;
+		static constexpr size_t BatchSize = 16;
 
 	private:
 		Hasher hasher;
 		KeySelector keySelector;
-
-		Element* elements;
-		Bucket* buckets;
-
-		size_t size;
-		size_t capacity;
-		size_t lastElementIndex;
+		Storage storage;
 	};
-
-	template<typename Key, typename Value, typename KeySelector, typename Hasher>
-	const float HashTable<Key, Value, KeySelector, Hasher>::fillValue = 0.75;
 }
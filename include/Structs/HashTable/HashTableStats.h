@@ -0,0 +1,78 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Structs
+{
+	// A snapshot of how a table is laid out, plain data that a metrics exporter can copy out.
+	// Probe lengths count what the engine steps through: chain links for chained tables,
+	// slots for Robin Hood, groups of sixteen for Swiss and buckets for cuckoo tables.
+	struct HashTableStats
+	{
+	public:
+		size_t size;
+		size_t capacity;
+		size_t allocatedBytes;
+		size_t tombstoneCount;
+		size_t rehashCount;
+		uint64_t rehashNanoseconds;
+		size_t maxProbeLength;
+
+		// How many stored values a lookup finds after each probe length, by length.
+		std::vector<size_t> probeLengths;
+
+	public:
+		double GetLoadFactor() const
+		{
+			return capacity == 0 ? 0 : static_cast<double>(size) / capacity;
+		}
+
+		double GetTombstoneRatio() const
+		{
+			return capacity == 0 ? 0 : static_cast<double>(tombstoneCount) / capacity;
+		}
+
+		double GetMeanProbeLength() const
+		{
+			size_t total = 0;
+
+			for (size_t length = 0; length < probeLengths.size(); ++length)
+			{
+				total += length * probeLengths[length];
+			}
+
+			return size == 0 ? 0 : static_cast<double>(total) / size;
+		}
+
+		// Writes the counters and a histogram of probe lengths. A good hasher leaves nearly
+		// every value at the shortest length; a long tail points at keys that collide.
+		void DumpDistribution(std::ostream& stream) const
+		{
+			stream << "size " << size << ", capacity " << capacity << ", load factor " << GetLoadFactor() << '\n';
+			stream << "allocated bytes " << allocatedBytes << ", tombstones " << tombstoneCount << " (ratio " << GetTombstoneRatio() << ")\n";
+			stream << "rehashes " << rehashCount << ", rehash time " << rehashNanoseconds / 1e6 << " ms\n";
+			stream << "probe length mean " << GetMeanProbeLength() << ", max " << maxProbeLength << '\n';
+			stream << "probes\tvalues\n";
+
+			size_t largest = probeLengths.empty() ? 0 : *std::max_element(probeLengths.begin(), probeLengths.end());
+
+			for (size_t length = 0; length < probeLengths.size(); ++length)
+			{
+				if (probeLengths[length] == 0)
+				{
+					continue;
+				}
+
+				size_t bar = (probeLengths[length] * HistogramWidth + largest - 1) / largest;
+				stream << length << '\t' << probeLengths[length] << '\t' << std::string(bar, '#') << '\n';
+			}
+		}
+
+	private:
+		static constexpr size_t HistogramWidth = 50;
+	};
+}
@@ -0,0 +1,381 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace Structs
+{
+	// Hashers to pass as the Hasher of a table in place of std::hash, which maps integers to
+	// themselves and is not seeded. WyHash is a fast 64-bit hash for trusted keys; SipHash is
+	// slower but keyed with a per-process random secret, so that keys chosen from outside
+	// cannot be made to collide.
+	namespace Hashers
+	{
+		inline uint64_t Multiply(uint64_t a, uint64_t b, uint64_t& high)
+		{
+#if defined(__SIZEOF_INT128__)
+			unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+			high = static_cast<uint64_t>(product >> 64);
+			return static_cast<uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			return _umul128(a, b, &high);
+#else
+			uint64_t aLow = a & 0xFFFFFFFFull;
+			uint64_t aHigh = a >> 32;
+			uint64_t bLow = b & 0xFFFFFFFFull;
+			uint64_t bHigh = b >> 32;
+
+			uint64_t low = aLow * bLow;
+			uint64_t middle = (low >> 32) + (aHigh * bLow & 0xFFFFFFFFull) + aLow * bHigh;
+
+			high = aHigh * bHigh + (aHigh * bLow >> 32) + (middle >> 32);
+			return (middle << 32) | (low & 0xFFFFFFFFull);
+#endif
+		}
+
+		// Unaligned reads in the machine's byte order, which the published hashes assume is
+		// little-endian.
+		inline uint64_t Read64(const unsigned char* bytes)
+		{
+			uint64_t value;
+			std::memcpy(&value, bytes, sizeof(value));
+			return value;
+		}
+
+		inline uint64_t Read32(const unsigned char* bytes)
+		{
+			uint32_t value;
+			std::memcpy(&value, bytes, sizeof(value));
+			return value;
+		}
+
+		// wyhash (final version 4): folds 128-bit products of the input with fixed secrets.
+		namespace Wy
+		{
+			constexpr uint64_t Secrets[] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+
+			inline uint64_t Mix(uint64_t a, uint64_t b)
+			{
+				uint64_t high;
+				uint64_t low = Multiply(a, b, high);
+				return low ^ high;
+			}
+
+			inline uint64_t HashInteger(uint64_t value, uint64_t seed = 0)
+			{
+				uint64_t high;
+				uint64_t low = Multiply(value ^ Secrets[0], seed ^ Secrets[1], high);
+				return Mix(low ^ Secrets[0], high ^ Secrets[1]);
+			}
+
+			inline uint64_t HashBytes(const void* data, size_t length, uint64_t seed = 0)
+			{
+				const unsigned char* bytes = static_cast<const unsigned char*>(data);
+				uint64_t a;
+				uint64_t b;
+
+				seed ^= Mix(seed ^ Secrets[0], Secrets[1]);
+
+				if (length <= 16)
+				{
+					if (length >= 4)
+					{
+						size_t middle = (length >> 3) << 2;
+						a = (Read32(bytes) << 32) | Read32(bytes + middle);
+						b = (Read32(bytes + length - 4) << 32) | Read32(bytes + length - 4 - middle);
+					}
+					else if (length > 0)
+					{
+						a = (static_cast<uint64_t>(bytes[0]) << 16) | (static_cast<uint64_t>(bytes[length >> 1]) << 8) | bytes[length - 1];
+						b = 0;
+					}
+					else
+					{
+						a = 0;
+						b = 0;
+					}
+				}
+				else
+				{
+					size_t left = length;
+
+					if (left > 48)
+					{
+						uint64_t first = seed;
+						uint64_t second = seed;
+
+						do
+						{
+							seed = Mix(Read64(bytes) ^ Secrets[1], Read64(bytes + 8) ^ seed);
+							first = Mix(Read64(bytes + 16) ^ Secrets[2], Read64(bytes + 24) ^ first);
+							second = Mix(Read64(bytes + 32) ^ Secrets[3], Read64(bytes + 40) ^ second);
+							bytes += 48;
+							left -= 48;
+						} while (left > 48);
+
+						seed ^= first ^ second;
+					}
+
+					while (left > 16)
+					{
+						seed = Mix(Read64(bytes) ^ Secrets[1], Read64(bytes + 8) ^ seed);
+						bytes += 16;
+						left -= 16;
+					}
+
+					a = Read64(bytes + left - 16);
+					b = Read64(bytes + left - 8);
+				}
+
+				uint64_t high;
+				uint64_t low = Multiply(a ^ Secrets[1], b ^ seed, high);
+
+				return Mix(low ^ Secrets[0] ^ length, high ^ Secrets[1]);
+			}
+		}
+
+		// SipHash-2-4, a keyed hash for which no collisions can be found without the key.
+		namespace Sip
+		{
+			struct Secret
+			{
+			public:
+				uint64_t first;
+				uint64_t second;
+			};
+
+			inline uint64_t RotateLeft(uint64_t value, int bits)
+			{
+				return (value << bits) | (value >> (64 - bits));
+			}
+
+			class State
+			{
+			public:
+				explicit State(Secret secret)
+					:
+					v0(secret.first ^ 0x736f6d6570736575ull),
+					v1(secret.second ^ 0x646f72616e646f6dull),
+					v2(secret.first ^ 0x6c7967656e657261ull),
+					v3(secret.second ^ 0x7465646279746573ull)
+				{}
+
+			public:
+				void Compress(uint64_t word)
+				{
+					v3 ^= word;
+					Round();
+					Round();
+					v0 ^= word;
+				}
+
+				uint64_t Finish(uint64_t last)
+				{
+					Compress(last);
+					v2 ^= 0xFF;
+					Round();
+					Round();
+					Round();
+					Round();
+					return v0 ^ v1 ^ v2 ^ v3;
+				}
+
+			private:
+				void Round()
+				{
+					v0 += v1;
+					v1 = RotateLeft(v1, 13);
+					v1 ^= v0;
+					v0 = RotateLeft(v0, 32);
+					v2 += v3;
+					v3 = RotateLeft(v3, 16);
+					v3 ^= v2;
+					v0 += v3;
+					v3 = RotateLeft(v3, 21);
+					v3 ^= v0;
+					v2 += v1;
+					v1 = RotateLeft(v1, 17);
+					v1 ^= v2;
+					v2 = RotateLeft(v2, 32);
+				}
+
+			private:
+				uint64_t v0;
+				uint64_t v1;
+				uint64_t v2;
+				uint64_t v3;
+			};
+
+			inline uint64_t HashBytes(const void* data, size_t length, Secret secret)
+			{
+				const unsigned char* bytes = static_cast<const unsigned char*>(data);
+				const unsigned char* end = bytes + (length & ~static_cast<size_t>(7));
+				State state(secret);
+
+				for (; bytes != end; bytes += 8)
+				{
+					state.Compress(Read64(bytes));
+				}
+
+				uint64_t last = static_cast<uint64_t>(length) << 56;
+
+				for (size_t i = 0; i < (length & 7); ++i)
+				{
+					last |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+				}
+
+				return state.Finish(last);
+			}
+
+			// An integer hashes as the eight bytes of its value, in one block.
+			inline uint64_t HashInteger(uint64_t value, Secret secret)
+			{
+				State state(secret);
+				state.Compress(value);
+				return state.Finish(static_cast<uint64_t>(8) << 56);
+			}
+
+			// Drawn once per process, so that tables agree with each other but an attacker
+			// cannot precompute colliding keys.
+			inline Secret GetProcessSecret()
+			{
+				static const Secret secret = []()
+				{
+					std::random_device device;
+					std::uniform_int_distribution<uint64_t> distribution;
+
+					return Secret{ distribution(device), distribution(device) };
+				}();
+
+				return secret;
+			}
+		}
+
+		// Hashers that also take types other than the key mark themselves as transparent, as in
+		// the standard library, so that tables look those up without building a temporary key.
+		template<typename Hasher, typename = void>
+		struct IsTransparent : std::false_type
+		{};
+
+		template<typename Hasher>
+		struct IsTransparent<Hasher, std::void_t<typename Hasher::is_transparent>> : std::true_type
+		{};
+
+		// std::hash of a string, which the standard makes equal to that of its string_view.
+		struct StringHash
+		{
+		public:
+			using is_transparent = void;
+
+		public:
+			size_t operator()(std::string_view key) const
+			{
+				return std::hash<std::string_view>()(key);
+			}
+		};
+
+		// std::hash, but transparent for strings.
+		template<typename Key>
+		using Default = std::conditional_t<std::is_same<Key, std::string>::value, StringHash, std::hash<Key>>;
+
+		template<typename Key>
+		struct IsHashedAsInteger : std::integral_constant<bool, std::is_integral<Key>::value || std::is_enum<Key>::value>
+		{};
+
+		template<typename Key>
+		struct IsHashedAsString : std::integral_constant<bool, std::is_same<Key, std::string>::value || std::is_same<Key, std::string_view>::value>
+		{};
+
+		template<typename Key, typename = void>
+		struct WyHash;
+
+		template<typename Key>
+		struct WyHash<Key, std::enable_if_t<IsHashedAsInteger<Key>::value>>
+		{
+		public:
+			explicit WyHash(uint64_t seed = 0)
+				: seed(seed)
+			{}
+
+		public:
+			size_t operator()(Key key) const
+			{
+				return static_cast<size_t>(Wy::HashInteger(static_cast<uint64_t>(key), seed));
+			}
+
+		private:
+			uint64_t seed;
+		};
+
+		template<typename Key>
+		struct WyHash<Key, std::enable_if_t<IsHashedAsString<Key>::value>>
+		{
+		public:
+			using is_transparent = void;
+
+		public:
+			explicit WyHash(uint64_t seed = 0)
+				: seed(seed)
+			{}
+
+		public:
+			size_t operator()(std::string_view key) const
+			{
+				return static_cast<size_t>(Wy::HashBytes(key.data(), key.size(), seed));
+			}
+
+		private:
+			uint64_t seed;
+		};
+
+		template<typename Key, typename = void>
+		struct SipHash;
+
+		template<typename Key>
+		struct SipHash<Key, std::enable_if_t<IsHashedAsInteger<Key>::value>>
+		{
+		public:
+			explicit SipHash(Sip::Secret secret = Sip::GetProcessSecret())
+				: secret(secret)
+			{}
+
+		public:
+			size_t operator()(Key value) const
+			{
+				return static_cast<size_t>(Sip::HashInteger(static_cast<uint64_t>(value), secret));
+			}
+
+		private:
+			Sip::Secret secret;
+		};
+
+		template<typename Key>
+		struct SipHash<Key, std::enable_if_t<IsHashedAsString<Key>::value>>
+		{
+		public:
+			using is_transparent = void;
+
+		public:
+			explicit SipHash(Sip::Secret secret = Sip::GetProcessSecret())
+				: secret(secret)
+			{}
+
+		public:
+			size_t operator()(std::string_view value) const
+			{
+				return static_cast<size_t>(Sip::HashBytes(value.data(), value.size(), secret));
+			}
+
+		private:
+			Sip::Secret secret;
+		};
+	}
+}
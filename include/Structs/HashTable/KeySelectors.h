@@ -1,32 +1,44 @@
 #pragma once
+#include <type_traits>
+#include <utility>
 
 namespace Structs {
 	namespace Keys {
-		template<typename Key, typename Value>
-		struct Selector
-		{
-		public:
-			virtual Key operator()(const Value& value) const = 0;
-		};
+		template<typename Selector, typename Key, typename Value>
+		struct IsSelector : std::is_same<std::invoke_result_t<const Selector&, const Value&>, const Key&>
+		{};
 
 		template<typename Key, typename Value, typename Pair = std::pair<Key,Value>>
-		struct PairSelector final : Selector<Key, Pair>
+		struct PairSelector final
 		{
 		public:
-			Key operator()(const Pair& value) const override final
+			constexpr const Key& operator()(const Pair& value) const
 			{
 				return value.first;
 			}
 		};
 
 		template<typename Key>
-		struct NoSelector final : Selector<Key, Key>
+		struct NoSelector final
 		{
 		public:
-			Key operator()(const Key& value) const override final
+			constexpr const Key& operator()(const Key& value) const
 			{
 				return value;
 			}
 		};
+
+		// A lookup of another type than the key, such as a string_view for string keys, that
+		// ordered containers can compare with stored keys without building a temporary key.
+		template<typename Key, typename Lookup, typename = void>
+		struct IsComparable : std::false_type
+		{};
+
+		template<typename Key, typename Lookup>
+		struct IsComparable<Key, Lookup, std::void_t<
+			decltype(std::declval<const Key&>() < std::declval<const Lookup&>()),
+			decltype(std::declval<const Key&>() > std::declval<const Lookup&>())>>
+			: std::integral_constant<bool, !std::is_same<Key, Lookup>::value>
+		{};
 	}
 }
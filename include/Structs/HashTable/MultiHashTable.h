@@ -0,0 +1,361 @@
+#pragma once
+#include "../Array/Span.h"
+#include "../Collection/ICollection.h"
+#include "HashTable.h"
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace Structs
+{
+	// Maps every key to any number of values. The table holds one group per key, and the values
+	// of all groups share one arena in which every group is a contiguous run, so a key costs
+	// no allocation of its own and its values are read with a linear scan.
+	//
+	// A full group that ends the arena takes the next slot, so values appended key by key are
+	// packed with no gaps. Any other full group doubles by moving to the end, which leaves a
+	// hole. When the arena is full it is copied into one four times the size of the live
+	// values, which drops the holes. Both keep appends amortized O(1); the larger arena makes
+	// the copies rarer, as groups that move keep leaving holes behind.
+	template<typename Key,
+		typename Value,
+		typename Hasher = Hashers::Default<Key>,
+		typename Engine = Engines::Chained<>>
+	class MultiHashTable final : public ICollection
+	{
+	private:
+		struct Group
+		{
+		public:
+			Key key;
+			size_t offset;
+			size_t size;
+			size_t capacity;
+		};
+
+		struct GroupSelector
+		{
+		public:
+			const Key& operator()(const Group& group) const
+			{
+				return group.key;
+			}
+		};
+
+		using Table = HashTable<Key, Group, GroupSelector, Hasher, Engine>;
+
+	public:
+		MultiHashTable()
+			: table(), values(nullptr), used(0), capacity(0), holes(0), size(0)
+		{}
+
+		explicit MultiHashTable(const Hasher& hasher)
+			: table(hasher), values(nullptr), used(0), capacity(0), holes(0), size(0)
+		{}
+
+		MultiHashTable(const MultiHashTable& multiTable) = delete;
+		MultiHashTable& operator=(const MultiHashTable& multiTable) = delete;
+
+		MultiHashTable(MultiHashTable&& multiTable) noexcept
+			:
+			table(std::move(multiTable.table)),
+			values(multiTable.values),
+			used(multiTable.used),
+			capacity(multiTable.capacity),
+			holes(multiTable.holes),
+			size(multiTable.size)
+		{
+			multiTable.values = nullptr;
+			multiTable.used = 0;
+			multiTable.capacity = 0;
+			multiTable.holes = 0;
+			multiTable.size = 0;
+		}
+
+		MultiHashTable& operator=(MultiHashTable&& multiTable) noexcept
+		{
+			Clear();
+			::operator delete(values);
+
+			table = std::move(multiTable.table);
+			values = multiTable.values;
+			used = multiTable.used;
+			capacity = multiTable.capacity;
+			holes = multiTable.holes;
+			size = multiTable.size;
+
+			multiTable.values = nullptr;
+			multiTable.used = 0;
+			multiTable.capacity = 0;
+			multiTable.holes = 0;
+			multiTable.size = 0;
+
+			return *this;
+		}
+
+		~MultiHashTable()
+		{
+			Clear();
+			::operator delete(values);
+		}
+
+	public:
+		template<typename... Args>
+		Value& Emplace(const Key& key, Args&&... args)
+		{
+			std::pair<Group*, bool> found = table.FindOrInsert(key, [&key]() { return Group{ key, 0, 0, 0 }; });
+			Group& group = *found.first;
+
+			if (group.size < group.capacity)
+			{
+				return Append(group, std::forward<Args>(args)...);
+			}
+
+			// The arguments may refer to values in the arena, which growing moves or frees, so
+			// the value is made before the group grows and moved in after.
+			try
+			{
+				Value value(std::forward<Args>(args)...);
+				Grow(group);
+				return Append(group, std::move(value));
+			}
+			catch (...)
+			{
+				// Every key in the table has at least one value.
+				if (found.second)
+				{
+					TryRemove(key);
+				}
+
+				throw;
+			}
+		}
+
+		// Removes every value of the key.
+		template<typename Lookup>
+		bool TryRemove(const Lookup& key)
+		{
+			Group* group = table.Find(key);
+
+			if (group == nullptr)
+			{
+				return false;
+			}
+
+			Destroy(*group);
+			size -= group->size;
+
+			if (group->offset + group->capacity == used)
+			{
+				used = group->offset;
+			}
+			else
+			{
+				holes += group->capacity;
+			}
+
+			table.TryRemove(key);
+
+			if (size == 0)
+			{
+				used = 0;
+				holes = 0;
+			}
+
+			return true;
+		}
+
+		template<typename Lookup>
+		Span<Value> EqualRange(const Lookup& key)
+		{
+			Group* group = table.Find(key);
+			return group == nullptr ? Span<Value>() : Span<Value>(values + group->offset, group->size);
+		}
+
+		template<typename Lookup>
+		Span<const Value> EqualRange(const Lookup& key) const
+		{
+			const Group* group = table.Find(key);
+			return group == nullptr ? Span<const Value>() : Span<const Value>(values + group->offset, group->size);
+		}
+
+		template<typename Lookup>
+		size_t Count(const Lookup& key) const
+		{
+			const Group* group = table.Find(key);
+			return group == nullptr ? 0 : group->size;
+		}
+
+		// Calls visit(key, values) for every key.
+		template<typename Visit>
+		void ForEach(Visit visit) const
+		{
+			for (const Group& group : table)
+			{
+				visit(group.key, Span<const Value>(values + group.offset, group.size));
+			}
+		}
+
+		virtual void Clear() override
+		{
+			for (Group& group : table)
+			{
+				Destroy(group);
+			}
+
+			table.Clear();
+			used = 0;
+			holes = 0;
+			size = 0;
+		}
+
+		void Reserve(size_t keyCount, size_t valueCount)
+		{
+			table.Reserve(keyCount);
+
+			if (valueCount > capacity - used)
+			{
+				Compact(used - holes + valueCount, nullptr);
+			}
+		}
+
+		// Packs every group into exactly its values, for indexes that are built once and then
+		// only read. The next append to any group moves it to the end again.
+		void ShrinkToFit()
+		{
+			table.ShrinkToFit();
+
+			if (size == 0)
+			{
+				::operator delete(values);
+				values = nullptr;
+				used = 0;
+				capacity = 0;
+				holes = 0;
+				return;
+			}
+
+			Compact(size, nullptr, true);
+		}
+
+	private:
+		template<typename... Args>
+		Value& Append(Group& group, Args&&... args)
+		{
+			Value* value = new (values + group.offset + group.size) Value(std::forward<Args>(args)...);
+			++group.size;
+			++size;
+
+			return *value;
+		}
+
+		void Grow(Group& group)
+		{
+			if (group.offset + group.capacity == used && used < capacity)
+			{
+				++used;
+				++group.capacity;
+				return;
+			}
+
+			size_t grown = std::max(group.capacity * 2, InitialGroupCapacity);
+
+			if (used + grown > capacity)
+			{
+				Compact(std::max((used - holes + grown) * ArenaGrowth, MinimumCapacity), &group);
+			}
+
+			if (group.offset + group.capacity == used)
+			{
+				used += grown - group.capacity;
+				group.capacity = grown;
+				return;
+			}
+
+			Value* source = values + group.offset;
+			Value* destination = values + used;
+
+			for (size_t i = 0; i < group.size; ++i)
+			{
+				new (destination + i) Value(std::move(source[i]));
+				source[i].~Value();
+			}
+
+			holes += group.capacity;
+			group.offset = used;
+			group.capacity = grown;
+			used += grown;
+		}
+
+		// Moves every group into a new arena of the given capacity with no holes between them,
+		// keeping their spare room unless they are fitted. The last group, if any, is moved to
+		// the end so that it can grow in place.
+		void Compact(size_t newCapacity, Group* last, bool fit = false)
+		{
+			Value* newValues = static_cast<Value*>(::operator new(newCapacity * sizeof(Value)));
+			size_t offset = 0;
+
+			for (Group& group : table)
+			{
+				if (&group != last)
+				{
+					offset = MoveGroup(group, newValues, offset, fit);
+				}
+			}
+
+			if (last != nullptr)
+			{
+				offset = MoveGroup(*last, newValues, offset, fit);
+			}
+
+			::operator delete(values);
+
+			values = newValues;
+			capacity = newCapacity;
+			used = offset;
+			holes = 0;
+		}
+
+		size_t MoveGroup(Group& group, Value* newValues, size_t offset, bool fit)
+		{
+			for (size_t i = 0; i < group.size; ++i)
+			{
+				new (newValues + offset + i) Value(std::move(values[group.offset + i]));
+				values[group.offset + i].~Value();
+			}
+
+			group.offset = offset;
+			group.capacity = fit ? group.size : group.capacity;
+			return offset + group.capacity;
+		}
+
+		void Destroy(Group& group)
+		{
+			for (size_t i = 0; i < group.size; ++i)
+			{
+				values[group.offset + i].~Value();
+			}
+		}
+
+	public:
+		virtual size_t GetSize() const override { return size; }
+		virtual bool IsEmpty() const override { return size == 0; }
+		size_t GetKeyCount() const { return table.GetSize(); }
+		size_t GetCapacity() const { return capacity; }
+		size_t GetAllocatedBytes() const { return capacity * sizeof(Value) + table.GetAllocatedBytes(); }
+
+	private:
+		static constexpr size_t InitialGroupCapacity = 1;
+		static constexpr size_t MinimumCapacity = 16;
+		static constexpr size_t ArenaGrowth = 4;
+
+	private:
+		Table table;
+		Value* values;
+		size_t used;
+		size_t capacity;
+		size_t holes;
+		size_t size;
+	};
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Structs
+{
+	namespace Parallel
+	{
+		// Below this many items per thread, starting a thread costs more than it saves.
+		constexpr size_t MinimumItemsPerThread = 1 << 14;
+
+		// The threads to split count items over: the requested number, or for 0 one per core,
+		// as long as every core gets enough work to be worth its thread.
+		inline size_t GetThreadCount(size_t threads, size_t count)
+		{
+			if (threads == 0)
+			{
+				threads = std::min<size_t>(std::thread::hardware_concurrency(), count / MinimumItemsPerThread);
+			}
+
+			return std::max<size_t>(1, std::min(threads, count));
+		}
+
+		// The first item of a thread's contiguous share of [0, count).
+		inline size_t GetChunkStart(size_t thread, size_t threads, size_t count)
+		{
+			return static_cast<size_t>(static_cast<unsigned long long>(count) * thread / threads);
+		}
+
+		// Runs body(thread) for every thread number, the calling thread taking number 0, and
+		// returns once all are done. The first exception thrown by any of them is rethrown.
+		template<typename Body>
+		void Run(size_t threads, Body body)
+		{
+			std::exception_ptr error;
+			std::mutex errorMutex;
+
+			auto run = [&body, &error, &errorMutex](size_t thread)
+			{
+				try
+				{
+					body(thread);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(errorMutex);
+
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+				}
+			};
+
+			std::vector<std::thread> workers;
+			workers.reserve(threads - 1);
+
+			try
+			{
+				for (size_t thread = 1; thread < threads; ++thread)
+				{
+					workers.emplace_back(run, thread);
+				}
+			}
+			catch (...)
+			{
+				for (std::thread& worker : workers)
+				{
+					worker.join();
+				}
+
+				throw;
+			}
+
+			run(0);
+
+			for (std::thread& worker : workers)
+			{
+				worker.join();
+			}
+
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+		}
+
+		// Runs body(first, last) over one contiguous share of [0, count) per thread.
+		template<typename Body>
+		void For(size_t threads, size_t count, Body body)
+		{
+			Run(threads, [threads, count, &body](size_t thread)
+			{
+				body(GetChunkStart(thread, threads, count), GetChunkStart(thread + 1, threads, count));
+			});
+		}
+	}
+}
@@ -0,0 +1,263 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace Structs
+{
+	namespace PerfectHash
+	{
+		// Hash-and-displace: keys are split into buckets of about four, and every bucket stores
+		// a displacement that sends each of its keys to its own slot. There are exactly as many
+		// slots as keys, so a lookup hashes once, reads its bucket's displacement and compares
+		// the one key in the slot it lands on.
+		struct Displacement
+		{
+		public:
+			uint32_t seed;
+			uint32_t offset;
+		};
+
+		constexpr size_t KeysPerBucket = 4;
+
+		constexpr uint64_t Mix(uint64_t hash, uint64_t seed)
+		{
+			uint64_t mixed = hash + (seed + 1) * 0x9E3779B97F4A7C15ull;
+			mixed ^= mixed >> 33;
+			mixed *= 0xff51afd7ed558ccdull;
+			mixed ^= mixed >> 33;
+			mixed *= 0xc4ceb9fe1a85ec53ull;
+			mixed ^= mixed >> 33;
+			return mixed;
+		}
+
+		constexpr size_t GetBucketCount(size_t count)
+		{
+			return count / KeysPerBucket + 1;
+		}
+
+		// Maps a mixed hash onto [0, range) with a multiplication instead of a division.
+		constexpr size_t Reduce(uint64_t mixed, size_t range)
+		{
+#if defined(__SIZEOF_INT128__)
+			return static_cast<size_t>((static_cast<unsigned __int128>(mixed) * range) >> 64);
+#else
+			return static_cast<size_t>(mixed % range);
+#endif
+		}
+
+		constexpr size_t GetBucket(uint64_t hash, size_t bucketCount)
+		{
+			return Reduce(Mix(hash, 0), bucketCount);
+		}
+
+		constexpr size_t GetBase(uint64_t hash, uint32_t seed, size_t count)
+		{
+			return Reduce(Mix(hash, static_cast<uint64_t>(seed) + 1), count);
+		}
+
+		constexpr size_t GetSlot(size_t base, uint32_t offset, size_t count)
+		{
+			size_t slot = base + offset;
+			return slot >= count ? slot - count : slot;
+		}
+
+		constexpr size_t GetSlot(uint64_t hash, Displacement displacement, size_t count)
+		{
+			return GetSlot(GetBase(hash, displacement.seed, count), displacement.offset, count);
+		}
+
+		// A hasher that can run at compile time, for tables built from literal keys. Integers
+		// hash to themselves, strings with FNV-1a; Mix spreads both.
+		template<typename Key, typename = void>
+		struct ConstexprHash;
+
+		template<typename Key>
+		struct ConstexprHash<Key, std::enable_if_t<std::is_integral<Key>::value || std::is_enum<Key>::value>>
+		{
+		public:
+			constexpr size_t operator()(Key key) const
+			{
+				return static_cast<size_t>(key);
+			}
+		};
+
+		template<>
+		struct ConstexprHash<std::string_view>
+		{
+		public:
+			constexpr size_t operator()(std::string_view key) const
+			{
+				uint64_t hash = 14695981039346656037ull;
+
+				for (char c : key)
+				{
+					hash ^= static_cast<unsigned char>(c);
+					hash *= 1099511628211ull;
+				}
+
+				return static_cast<size_t>(hash);
+			}
+		};
+
+		template<typename Value, size_t Size, size_t... Indices>
+		constexpr std::array<Value, Size> ToArray(const Value (&values)[Size], std::index_sequence<Indices...>)
+		{
+			return { { values[Indices]... } };
+		}
+
+		// Turns a braced list of literal values into the array a static table is built from.
+		template<typename Value, size_t Size>
+		constexpr std::array<Value, Size> ToArray(const Value (&values)[Size])
+		{
+			return ToArray(values, std::make_index_sequence<Size>());
+		}
+
+		// Finds a displacement for every bucket and the slot of every key, largest buckets
+		// first while the slots are still mostly free. A bucket tries every offset of a seed
+		// before the next seed; a single key reaches any slot with some offset, so the last
+		// buckets just take the free slots in order. Returns false when two keys of a bucket
+		// have the same hash, as no displacement can tell them apart.
+		//
+		// The scratch arrays hold bucketCount + 1, count and count elements; everything works
+		// in place so that the same code builds tables at compile time.
+		constexpr bool Build(
+			const uint64_t* hashes, size_t count,
+			Displacement* displacements, size_t bucketCount,
+			size_t* slots,
+			size_t* bucketStarts, size_t* order, bool* taken)
+		{
+			for (size_t bucket = 0; bucket <= bucketCount; ++bucket)
+			{
+				bucketStarts[bucket] = 0;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				++bucketStarts[GetBucket(hashes[i], bucketCount) + 1];
+				taken[i] = false;
+			}
+
+			size_t largest = 0;
+
+			for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+			{
+				largest = bucketStarts[bucket + 1] > largest ? bucketStarts[bucket + 1] : largest;
+				bucketStarts[bucket + 1] += bucketStarts[bucket];
+			}
+
+			// Places keys by bucket, which leaves every start moved to the next bucket's start.
+			for (size_t i = 0; i < count; ++i)
+			{
+				order[bucketStarts[GetBucket(hashes[i], bucketCount)]++] = i;
+			}
+
+			for (size_t bucket = bucketCount; bucket > 0; --bucket)
+			{
+				bucketStarts[bucket] = bucketStarts[bucket - 1];
+			}
+
+			bucketStarts[0] = 0;
+
+			// Slots are only ever taken, so the first free one never moves back.
+			size_t free = 0;
+
+			for (size_t size = largest; size > 0; --size)
+			{
+				for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+				{
+					size_t first = bucketStarts[bucket];
+					size_t last = bucketStarts[bucket + 1];
+
+					if (last - first != size)
+					{
+						continue;
+					}
+
+					for (size_t i = first; i < last; ++i)
+					{
+						for (size_t j = first; j < i; ++j)
+						{
+							if (hashes[order[i]] == hashes[order[j]])
+							{
+								return false;
+							}
+						}
+					}
+
+					if (size == 1)
+					{
+						while (taken[free])
+						{
+							++free;
+						}
+
+						size_t base = GetBase(hashes[order[first]], 0, count);
+						size_t offset = free >= base ? free - base : free + count - base;
+
+						slots[order[first]] = free;
+						taken[free] = true;
+						displacements[bucket] = Displacement{ 0, static_cast<uint32_t>(offset) };
+						continue;
+					}
+
+					bool placed = false;
+
+					for (uint32_t seed = 0; !placed; ++seed)
+					{
+						// The slots of the bucket's keys hold their bases for this seed. Keys with
+						// equal bases collide at every offset, so the seed is skipped.
+						bool distinct = true;
+
+						for (size_t i = first; i < last && distinct; ++i)
+						{
+							slots[order[i]] = GetBase(hashes[order[i]], seed, count);
+
+							for (size_t j = first; j < i && distinct; ++j)
+							{
+								distinct = slots[order[i]] != slots[order[j]];
+							}
+						}
+
+						for (size_t offset = 0; distinct && offset < count && !placed; ++offset)
+						{
+							size_t i = first;
+
+							while (i < last && !taken[GetSlot(slots[order[i]], static_cast<uint32_t>(offset), count)])
+							{
+								++i;
+							}
+
+							if (i != last)
+							{
+								continue;
+							}
+
+							for (i = first; i < last; ++i)
+							{
+								slots[order[i]] = GetSlot(slots[order[i]], static_cast<uint32_t>(offset), count);
+								taken[slots[order[i]]] = true;
+							}
+
+							displacements[bucket] = Displacement{ seed, static_cast<uint32_t>(offset) };
+							placed = true;
+						}
+					}
+				}
+			}
+
+			for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+			{
+				if (bucketStarts[bucket] == bucketStarts[bucket + 1])
+				{
+					displacements[bucket] = Displacement{ 0, 0 };
+				}
+			}
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,301 @@
+#pragma once
+#include "../HashTable/HashTable.h"
+#include "../HashTable/KeySelectors.h"
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Structs
+{
+	// Keys are spread over independent hash table segments by the high bits of their mixed hash,
+	// and every segment has its own reader/writer lock, so threads only contend when they touch
+	// the same segment. Values are handed out as copies or to callbacks that run under the
+	// segment lock, never as pointers that could outlive it. A key is hashed once, and the
+	// segment table is handed that hash rather than hashing it again.
+	template <typename Key, typename Value, typename Engine = Engines::Chained<>, typename Hasher = Hashers::Default<Key>>
+	class ConcurrentUnorderedMap final
+	{
+	public:
+		using Pair = std::pair<Key, Value>;
+		using KeySelector = Keys::PairSelector<Key, Value>;
+		using Table = HashTable<Key, Pair, KeySelector, Hasher, Engine>;
+
+	private:
+		template<typename Lookup>
+		using IfLookup = std::enable_if_t<Hashers::IsTransparent<Hasher>::value && !std::is_same<Lookup, Key>::value>;
+
+	public:
+		explicit ConcurrentUnorderedMap(size_t segmentCount = DefaultSegmentCount, const Hasher& hasher = Hasher())
+			: segments(nullptr), segmentCount(1), segmentShift(sizeof(size_t) * 8), hasher(hasher)
+		{
+			if (segmentCount == 0)
+			{
+				throw std::invalid_argument("Segment count must be positive");
+			}
+
+			while (this->segmentCount < segmentCount)
+			{
+				this->segmentCount *= 2;
+				--segmentShift;
+			}
+
+			segments = new Segment[this->segmentCount];
+
+			for (size_t i = 0; i < this->segmentCount; ++i)
+			{
+				segments[i].table = Table(hasher);
+			}
+		}
+
+		ConcurrentUnorderedMap(const ConcurrentUnorderedMap& map) = delete;
+		ConcurrentUnorderedMap& operator=(const ConcurrentUnorderedMap& map) = delete;
+
+		~ConcurrentUnorderedMap()
+		{
+			delete[] segments;
+		}
+
+	public:
+		void Insert(const Key& key, const Value& value)
+		{
+			if (!TryInsert(key, value))
+			{
+				throw std::invalid_argument("Already contain value");
+			}
+		}
+
+		bool TryInsert(const Key& key, const Value& value)
+		{
+			return TryEmplace(key, value);
+		}
+
+		template<typename... Args>
+		bool TryEmplace(const Key& key, Args&&... args)
+		{
+			size_t hash = hasher(key);
+			Segment& segment = GetSegment(hash);
+			std::unique_lock<std::shared_mutex> lock(segment.lock);
+
+			return FindOrEmplace(segment, key, hash, std::forward<Args>(args)...).second;
+		}
+
+		// Returns whether the key was inserted rather than assigned.
+		bool InsertOrAssign(const Key& key, const Value& value)
+		{
+			return Upsert(key, value, [&value](Value& current) { current = value; });
+		}
+
+		// Inserts the value if the key is missing, otherwise calls update on the current value;
+		// both happen under the segment's write lock. Returns whether the key was inserted.
+		template<typename Update>
+		bool Upsert(const Key& key, const Value& value, Update update)
+		{
+			size_t hash = hasher(key);
+			Segment& segment = GetSegment(hash);
+			std::unique_lock<std::shared_mutex> lock(segment.lock);
+
+			std::pair<Pair*, bool> result = FindOrEmplace(segment, key, hash, value);
+
+			if (!result.second)
+			{
+				update(result.first->second);
+			}
+
+			return result.second;
+		}
+
+		// Calls compute on the value of the key, default constructing it first if the key is
+		// missing, and returns a copy of the computed value.
+		template<typename Function>
+		Value Compute(const Key& key, Function compute)
+		{
+			size_t hash = hasher(key);
+			Segment& segment = GetSegment(hash);
+			std::unique_lock<std::shared_mutex> lock(segment.lock);
+
+			Value& value = FindOrEmplace(segment, key, hash).first->second;
+			compute(value);
+
+			return value;
+		}
+
+		void Remove(const Key& key)
+		{
+			if (!TryRemove(key))
+			{
+				throw std::invalid_argument("Doesn't contain value");
+			}
+		}
+
+		bool TryRemove(const Key& key)
+		{
+			return RemoveKey(key);
+		}
+
+		bool Contains(const Key& key)
+		{
+			return VisitKey(key, [](const Value&) {});
+		}
+
+		bool TryGet(const Key& key, Value& value)
+		{
+			return VisitKey(key, [&value](const Value& found) { value = found; });
+		}
+
+		// Calls visit with the value of the key under the segment's read lock.
+		template<typename Visitor>
+		bool Visit(const Key& key, Visitor visit)
+		{
+			return VisitKey(key, visit);
+		}
+
+		// A string_view or a literal finds a string key without a temporary copy of it.
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryRemove(const Lookup& key)
+		{
+			return RemoveKey(key);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool Contains(const Lookup& key)
+		{
+			return VisitKey(key, [](const Value&) {});
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryGet(const Lookup& key, Value& value)
+		{
+			return VisitKey(key, [&value](const Value& found) { value = found; });
+		}
+
+		template<typename Lookup, typename Visitor, typename = IfLookup<Lookup>>
+		bool Visit(const Lookup& key, Visitor visit)
+		{
+			return VisitKey(key, visit);
+		}
+
+		void Clear()
+		{
+			for (size_t i = 0; i < segmentCount; ++i)
+			{
+				std::unique_lock<std::shared_mutex> lock(segments[i].lock);
+				segments[i].table.Clear();
+			}
+		}
+
+		void Reserve(size_t count)
+		{
+			for (size_t i = 0; i < segmentCount; ++i)
+			{
+				std::unique_lock<std::shared_mutex> lock(segments[i].lock);
+				segments[i].table.Reserve(count / segmentCount + 1);
+			}
+		}
+
+	public:
+		// Segments are locked one at a time, so under concurrent writes these are not a snapshot.
+		size_t GetSize() const
+		{
+			size_t size = 0;
+
+			for (size_t i = 0; i < segmentCount; ++i)
+			{
+				std::shared_lock<std::shared_mutex> lock(segments[i].lock);
+				size += segments[i].table.GetSize();
+			}
+
+			return size;
+		}
+
+		bool IsEmpty() const { return GetSize() == 0; }
+		size_t GetSegmentCount() const { return segmentCount; }
+
+	public:
+		static constexpr size_t DefaultSegmentCount = 64;
+		static constexpr size_t CacheLineSize = 64;
+
+	private:
+		// Aligned to a cache line, so the lock of one segment never shares a line with another's.
+		struct alignas(CacheLineSize) Segment
+		{
+			mutable std::shared_mutex lock;
+			Table table;
+		};
+
+	private:
+		// The table indexes buckets by the low bits of the same mixed hash, so the segment takes
+		// the high ones.
+		Segment& GetSegment(size_t hash)
+		{
+			if (segmentCount == 1)
+			{
+				return segments[0];
+			}
+
+			size_t mixed = hash * Multiplier;
+			return segments[mixed >> segmentShift];
+		}
+
+		template<typename Lookup>
+		bool RemoveKey(const Lookup& key)
+		{
+			size_t hash = hasher(key);
+			Segment& segment = GetSegment(hash);
+			std::unique_lock<std::shared_mutex> lock(segment.lock);
+
+			return segment.table.TryRemove(key, hash);
+		}
+
+		template<typename Lookup, typename Visitor>
+		bool VisitKey(const Lookup& key, Visitor visit)
+		{
+			size_t hash = hasher(key);
+			Segment& segment = GetSegment(hash);
+			std::shared_lock<std::shared_mutex> lock(segment.lock);
+
+			const Pair* pair = GetReadOnly(segment).Find(key, hash);
+
+			if (pair == nullptr)
+			{
+				return false;
+			}
+
+			visit(static_cast<const Value&>(pair->second));
+			return true;
+		}
+
+		// Readers share the segment lock, so they only go through the const table: some engines
+		// move values around on a non-const lookup.
+		static const Table& GetReadOnly(const Segment& segment)
+		{
+			return segment.table;
+		}
+
+		template<typename... Args>
+		static std::pair<Pair*, bool> FindOrEmplace(Segment& segment, const Key& key, size_t hash, Args&&... args)
+		{
+			return segment.table.FindOrInsert(key, hash, [&]()
+			{
+				return Pair(
+					std::piecewise_construct,
+					std::forward_as_tuple(key),
+					std::forward_as_tuple(std::forward<Args>(args)...));
+			});
+		}
+
+	private:
+		static constexpr size_t Multiplier = sizeof(size_t) == 8
+			? static_cast<size_t>(11400714819323198485ull)
+			: static_cast<size_t>(2654435769ul);
+
+	private:
+		Segment* segments;
+		size_t segmentCount;
+		size_t segmentShift;
+		Hasher hasher;
+	};
+}
@@ -0,0 +1,160 @@
+#pragma once
+#include "../HashTable/FrozenHashTable.h"
+#include "../HashTable/KeySelectors.h"
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+namespace Structs
+{
+	// An immutable map built once, usually by UnorderedMap::Freeze, whose lookups take a single
+	// probe into a table with one slot per entry.
+	template <typename Key, typename Value, typename Hasher = Hashers::Default<Key>>
+	class FrozenUnorderedMap final
+	{
+	public:
+		using Pair = std::pair<Key, Value>;
+		using KeySelector = Keys::PairSelector<Key, Value>;
+		using Table = FrozenHashTable<Key, Pair, KeySelector, Hasher>;
+
+	public:
+		FrozenUnorderedMap()
+			: table()
+		{}
+
+		template<typename Iterator>
+		FrozenUnorderedMap(Iterator first, Iterator last)
+			: table(first, last)
+		{}
+
+		template<typename Iterator>
+		FrozenUnorderedMap(Iterator first, Iterator last, const Hasher& hasher)
+			: table(first, last, hasher)
+		{}
+
+	public:
+		bool Contains(const Key& key) const
+		{
+			return table.Contains(key);
+		}
+
+		const Value* Find(const Key& key) const
+		{
+			const Pair* pair = table.Find(key);
+
+			if (pair == nullptr)
+			{
+				return nullptr;
+			}
+
+			return &pair->second;
+		}
+
+		bool TryGet(const Key& key, const Value*& value) const
+		{
+			value = Find(key);
+			return value != nullptr;
+		}
+
+		const Value& operator[](const Key& key) const
+		{
+			const Value* value = Find(key);
+
+			if (value == nullptr)
+			{
+				throw std::invalid_argument("Doesn't contain value");
+			}
+
+			return *value;
+		}
+
+	public:
+		size_t GetSize() const { return table.GetSize(); }
+		bool IsEmpty() const { return table.IsEmpty(); }
+		size_t GetAllocatedBytes() const { return table.GetAllocatedBytes(); }
+
+	public:
+		const Pair* begin() const
+		{
+			return table.begin();
+		}
+
+		const Pair* end() const
+		{
+			return table.end();
+		}
+
+	private:
+		Table table;
+	};
+
+	template <typename Key, typename Value, size_t Size, typename Hasher = PerfectHash::ConstexprHash<Key>>
+	class StaticFrozenUnorderedMap final
+	{
+	public:
+		using Pair = std::pair<Key, Value>;
+		using KeySelector = Keys::PairSelector<Key, Value>;
+		using Table = StaticFrozenHashTable<Key, Pair, Size, KeySelector, Hasher>;
+
+	public:
+		constexpr explicit StaticFrozenUnorderedMap(const std::array<Pair, Size>& pairs)
+			: table(pairs)
+		{}
+
+	public:
+		constexpr bool Contains(const Key& key) const
+		{
+			return table.Contains(key);
+		}
+
+		constexpr const Value* Find(const Key& key) const
+		{
+			const Pair* pair = table.Find(key);
+
+			if (pair == nullptr)
+			{
+				return nullptr;
+			}
+
+			return &pair->second;
+		}
+
+		constexpr const Value& operator[](const Key& key) const
+		{
+			const Value* value = Find(key);
+
+			if (value == nullptr)
+			{
+				throw std::invalid_argument("Doesn't contain value");
+			}
+
+			return *value;
+		}
+
+	public:
+		constexpr size_t GetSize() const { return Size; }
+		constexpr bool IsEmpty() const { return false; }
+
+	public:
+		constexpr const Pair* begin() const
+		{
+			return table.begin();
+		}
+
+		constexpr const Pair* end() const
+		{
+			return table.end();
+		}
+
+	private:
+		Table table;
+	};
+
+	// Builds a map of literal pairs at compile time:
+	// constexpr auto map = MakeFrozenUnorderedMap<std::string_view, int>({ { "one", 1 }, { "two", 2 } });
+	template <typename Key, typename Value, size_t Size>
+	constexpr StaticFrozenUnorderedMap<Key, Value, Size> MakeFrozenUnorderedMap(const std::pair<Key, Value> (&pairs)[Size])
+	{
+		return StaticFrozenUnorderedMap<Key, Value, Size>(PerfectHash::ToArray(pairs));
+	}
+}
@@ -21,6 +21,8 @@ namespace Structs
 		virtual void Insert(const Key& key, const Value& value) = 0;
 		virtual void Remove(const Key& key) = 0;
 		virtual bool Contains(const Key& key) = 0;
+		virtual Value* Find(const Key& key) = 0;
+		virtual bool TryGet(const Key& key, Value*& value) = 0;
 
 		virtual bool TryInsert(const Pair& keyValuePair) = 0;
 		virtual bool TryInsert(const Key& key, const Value& value) = 0;
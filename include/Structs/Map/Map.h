@@ -28,7 +28,9 @@ namespace Structs
 
 		virtual MapIterator& operator++(int) override
 		{
-			return MapIterator(i++);
+			MapIterator temp = *this;
+			++(*this);
+			return temp;
 		}
 
 		virtual bool operator==(const MapIterator& rhs) const override
@@ -63,6 +65,10 @@ namespace Structs
 		using Tree = AVLTree<Key, Pair, KeySelector>;
 		using Iterator = MapIterator<Key, Value>;
 
+	private:
+		template<typename Lookup>
+		using IfLookup = std::enable_if_t<Keys::IsComparable<Key, Lookup>::value>;
+
 	public:
 		Map()
 			: tree()
@@ -109,6 +115,50 @@ namespace Structs
 			return tree.Contains(key);
 		}
 
+		virtual Value* Find(const Key& key) override
+		{
+			Pair* pair = tree.Find(key);
+
+			if (pair == nullptr)
+			{
+				return nullptr;
+			}
+
+			return &pair->second;
+		}
+
+		virtual bool TryGet(const Key& key, Value*& value) override
+		{
+			value = Find(key);
+			return value != nullptr;
+		}
+
+		// A string_view or a literal finds a string key without a temporary copy of it.
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryRemove(const Lookup& key)
+		{
+			return tree.TryRemove(key);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool Contains(const Lookup& key)
+		{
+			return tree.Contains(key);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		Value* Find(const Lookup& key)
+		{
+			Pair* pair = tree.Find(key);
+			return pair == nullptr ? nullptr : &pair->second;
+		}
+
+		Value& operator[](const Key& key)
+		{
+			auto result = tree.FindOrInsert(key, [&key]() { return Pair(key, Value()); });
+			return result.first->second;
+		}
+
 		virtual void Clear() override
 		{
 			tree.Clear();
@@ -0,0 +1,251 @@
+#pragma once
+#include "../HashTable/HashTable.h"
+#include "../HashTable/KeySelectors.h"
+#include "../Memory/EpochDomain.h"
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Structs
+{
+	// A map for data that is read far more often than it changes. Readers look keys up in the
+	// currently published table without taking any lock. Writers are serialized, copy the table,
+	// change the copy and publish it, and the replaced table is reclaimed through the epoch domain
+	// once no reader can still be looking at it. Each write costs a copy of the table, so batch
+	// changes into one Update where possible.
+	template <typename Key, typename Value, typename Engine = Engines::Chained<>, typename Hasher = Hashers::Default<Key>>
+	class ReadMostlyUnorderedMap final
+	{
+	public:
+		using Pair = std::pair<Key, Value>;
+		using KeySelector = Keys::PairSelector<Key, Value>;
+		using Table = HashTable<Key, Pair, KeySelector, Hasher, Engine>;
+		using Guard = Memory::EpochDomain::Guard;
+
+	private:
+		template<typename Lookup>
+		using IfLookup = std::enable_if_t<Hashers::IsTransparent<Hasher>::value && !std::is_same<Lookup, Key>::value>;
+
+	public:
+		ReadMostlyUnorderedMap()
+			: ReadMostlyUnorderedMap(Hasher())
+		{}
+
+		// Every table published by the map hashes with a copy of the hasher.
+		explicit ReadMostlyUnorderedMap(const Hasher& hasher)
+			: table(new Table(hasher)), domain(Memory::EpochDomain::GetDefault()), hasher(hasher)
+		{}
+
+		ReadMostlyUnorderedMap(const ReadMostlyUnorderedMap& map) = delete;
+		ReadMostlyUnorderedMap& operator=(const ReadMostlyUnorderedMap& map) = delete;
+
+		~ReadMostlyUnorderedMap()
+		{
+			delete table.load();
+		}
+
+	public:
+		bool Contains(const Key& key) const
+		{
+			Guard guard(domain);
+			return GetPublished().Contains(key);
+		}
+
+		bool TryGet(const Key& key, Value& value) const
+		{
+			return Visit(key, [&value](const Value& found) { value = found; });
+		}
+
+		// Calls visit with the value of the key in the published table, which stays alive until
+		// visit returns.
+		template<typename Visitor>
+		bool Visit(const Key& key, Visitor visit) const
+		{
+			return VisitKey(key, visit);
+		}
+
+		// A string_view or a literal finds a string key without a temporary copy of it.
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool Contains(const Lookup& key) const
+		{
+			Guard guard(domain);
+			return GetPublished().Contains(key);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryGet(const Lookup& key, Value& value) const
+		{
+			return VisitKey(key, [&value](const Value& found) { value = found; });
+		}
+
+		template<typename Lookup, typename Visitor, typename = IfLookup<Lookup>>
+		bool Visit(const Lookup& key, Visitor visit) const
+		{
+			return VisitKey(key, visit);
+		}
+
+		// Calls read with the whole published table, so several lookups see the same version.
+		template<typename Reader>
+		decltype(auto) Read(Reader read) const
+		{
+			Guard guard(domain);
+			return read(GetPublished());
+		}
+
+		void Insert(const Key& key, const Value& value)
+		{
+			if (!TryInsert(key, value))
+			{
+				throw std::invalid_argument("Already contain value");
+			}
+		}
+
+		bool TryInsert(const Key& key, const Value& value)
+		{
+			bool inserted = false;
+			Update([&](Table& copy) { inserted = copy.TryInsert(Pair(key, value)); });
+
+			return inserted;
+		}
+
+		// Returns whether the key was inserted rather than assigned.
+		bool InsertOrAssign(const Key& key, const Value& value)
+		{
+			bool inserted = false;
+
+			Update([&](Table& copy)
+			{
+				std::pair<Pair*, bool> result = copy.FindOrInsert(key, [&]() { return Pair(key, value); });
+
+				if (!result.second)
+				{
+					result.first->second = value;
+				}
+
+				inserted = result.second;
+			});
+
+			return inserted;
+		}
+
+		void Remove(const Key& key)
+		{
+			if (!TryRemove(key))
+			{
+				throw std::invalid_argument("Doesn't contain value");
+			}
+		}
+
+		bool TryRemove(const Key& key)
+		{
+			return RemoveKey(key);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryRemove(const Lookup& key)
+		{
+			return RemoveKey(key);
+		}
+
+		// Calls edit with a private copy of the published table and publishes the copy afterwards,
+		// so every change made by edit becomes visible to readers at once.
+		template<typename Editor>
+		void Update(Editor edit)
+		{
+			std::lock_guard<std::mutex> lock(writeLock);
+
+			Table* copy = new Table(hasher);
+
+			try
+			{
+				CopyInto(*copy);
+				edit(*copy);
+			}
+			catch (...)
+			{
+				delete copy;
+				throw;
+			}
+
+			Publish(copy);
+		}
+
+		// Replaces the whole content with the given table, for rebuilds that start from scratch.
+		void Assign(Table&& replacement)
+		{
+			std::lock_guard<std::mutex> lock(writeLock);
+			Publish(new Table(std::move(replacement)));
+		}
+
+		void Clear()
+		{
+			Assign(Table(hasher));
+		}
+
+	public:
+		size_t GetSize() const
+		{
+			Guard guard(domain);
+			return GetPublished().GetSize();
+		}
+
+		bool IsEmpty() const { return GetSize() == 0; }
+
+	private:
+		// Readers only ever see the table as const, which keeps engines from doing any work
+		// behind a lookup, such as an incremental migration step.
+		const Table& GetPublished() const
+		{
+			return *table.load();
+		}
+
+		template<typename Lookup>
+		bool RemoveKey(const Lookup& key)
+		{
+			bool removed = false;
+			Update([&](Table& copy) { removed = copy.TryRemove(key); });
+
+			return removed;
+		}
+
+		template<typename Lookup, typename Visitor>
+		bool VisitKey(const Lookup& key, Visitor visit) const
+		{
+			Guard guard(domain);
+			const Pair* pair = GetPublished().Find(key);
+
+			if (pair == nullptr)
+			{
+				return false;
+			}
+
+			visit(pair->second);
+			return true;
+		}
+
+		void CopyInto(Table& copy) const
+		{
+			const Table& published = GetPublished();
+			copy.Reserve(published.GetSize());
+
+			for (const Pair& pair : published)
+			{
+				copy.Insert(pair);
+			}
+		}
+
+		void Publish(Table* replacement)
+		{
+			Table* replaced = table.exchange(replacement);
+			domain.Retire(replaced);
+		}
+
+	private:
+		std::atomic<Table*> table;
+		Memory::EpochDomain& domain;
+		std::mutex writeLock;
+		Hasher hasher;
+	};
+}
@@ -1,22 +1,26 @@
 #pragma once
 #include "../HashTable/HashTable.h"
 #include "IMap.h"
+#include "FrozenUnorderedMap.h"
 #include "../HashTable/KeySelectors.h"
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Structs
 {
-	template <typename Key, typename Value, typename Pair = std::pair<Key, Value>>
-	class UnorderedMapIterator : public IIterator<Pair, UnorderedMapIterator<Key, Value>>
+	template <typename Key, typename Value, typename Engine = Engines::Chained<>, typename Pair = std::pair<Key, Value>>
+	class UnorderedMapIterator : public IIterator<Pair, UnorderedMapIterator<Key, Value, Engine>>
 	{
 	public:
-		using KeySelector = Keys::PairSelector<Key, Value>;
-		using HashTable = HashTable<Key, Pair, KeySelector>;
-		using TreeIterator = HashTableIterator<Pair>;
+		using TableIterator = typename Engine::template Storage<Pair>::Iterator;
 
 	public:
 		UnorderedMapIterator() = delete;
 
-		UnorderedMapIterator(TreeIterator iterator)
+		UnorderedMapIterator(TableIterator iterator)
 			: i(iterator)
 		{}
 
@@ -28,7 +32,9 @@ namespace Structs
 
 		virtual UnorderedMapIterator& operator++(int) override
 		{
-			return UnorderedMapIterator(i++);
+			UnorderedMapIterator temp = *this;
+			++(*this);
+			return temp;
 		}
 
 		virtual bool operator==(const UnorderedMapIterator& rhs) const override
@@ -51,23 +57,31 @@ namespace Structs
 		}
 
 	private:
-		TreeIterator i;
+		TableIterator i;
 	};
 
-	template <typename Key, typename Value>
-	class UnorderedMap final : public IMap<Key, Value, UnorderedMapIterator<Key, Value>>
+	template <typename Key, typename Value, typename Engine = Engines::Chained<>, typename Hasher = Hashers::Default<Key>>
+	class UnorderedMap final : public IMap<Key, Value, UnorderedMapIterator<Key, Value, Engine>>
 	{
 	public:
 		using Pair = std::pair<Key, Value>;
 		using KeySelector = Keys::PairSelector<Key, Value>;
-		using HashTable = HashTable<Key, Pair, KeySelector>;
-		using Iterator = UnorderedMapIterator<Key, Value>;
+		using Table = HashTable<Key, Pair, KeySelector, Hasher, Engine>;
+		using Iterator = UnorderedMapIterator<Key, Value, Engine>;
+
+	private:
+		template<typename Lookup>
+		using IfLookup = std::enable_if_t<Hashers::IsTransparent<Hasher>::value && !std::is_same<Lookup, Key>::value>;
 
 	public:
 		UnorderedMap()
 			: hashTable()
 		{}
 
+		explicit UnorderedMap(const Hasher& hasher)
+			: hashTable(hasher)
+		{}
+
 		~UnorderedMap()
 		{
 			Clear();
@@ -79,9 +93,37 @@ namespace Structs
 			hashTable.Insert(keyValuePair);
 		}
 
+		void Insert(Pair&& keyValuePair)
+		{
+			hashTable.Insert(std::move(keyValuePair));
+		}
+
 		virtual void Insert(const Key& key, const Value& value) override
 		{
-			Insert(Pair(key, value));
+			Emplace(key, value);
+		}
+
+		void Insert(Key&& key, Value&& value)
+		{
+			Emplace(std::move(key), std::move(value));
+		}
+
+		template<typename... Args>
+		void Emplace(const Key& key, Args&&... args)
+		{
+			if (!TryEmplace(key, std::forward<Args>(args)...))
+			{
+				throw std::invalid_argument("Already contain value");
+			}
+		}
+
+		template<typename... Args>
+		void Emplace(Key&& key, Args&&... args)
+		{
+			if (!TryEmplace(std::move(key), std::forward<Args>(args)...))
+			{
+				throw std::invalid_argument("Already contain value");
+			}
 		}
 
 		virtual bool TryInsert(const Pair& keyValuePair) override
@@ -89,9 +131,31 @@ namespace Structs
 			return hashTable.TryInsert(keyValuePair);
 		}
 
+		bool TryInsert(Pair&& keyValuePair)
+		{
+			return hashTable.TryInsert(std::move(keyValuePair));
+		}
+
 		virtual bool TryInsert(const Key& key, const Value& value) override
 		{
-			return TryInsert(Pair(key, value));
+			return TryEmplace(key, value);
+		}
+
+		bool TryInsert(Key&& key, Value&& value)
+		{
+			return TryEmplace(std::move(key), std::move(value));
+		}
+
+		template<typename... Args>
+		bool TryEmplace(const Key& key, Args&&... args)
+		{
+			return FindOrEmplace(key, key, std::forward<Args>(args)...).second;
+		}
+
+		template<typename... Args>
+		bool TryEmplace(Key&& key, Args&&... args)
+		{
+			return FindOrEmplace(key, std::move(key), std::forward<Args>(args)...).second;
 		}
 
 		virtual void Remove(const Key& key) override
@@ -109,14 +173,116 @@ namespace Structs
 			return hashTable.Contains(key);
 		}
 
+		virtual Value* Find(const Key& key) override
+		{
+			Pair* pair = hashTable.Find(key);
+
+			if (pair == nullptr)
+			{
+				return nullptr;
+			}
+
+			return &pair->second;
+		}
+
+		virtual bool TryGet(const Key& key, Value*& value) override
+		{
+			value = Find(key);
+			return value != nullptr;
+		}
+
+		// A string_view or a literal finds a string key without a temporary copy of it.
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryRemove(const Lookup& key)
+		{
+			return hashTable.TryRemove(key);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool Contains(const Lookup& key)
+		{
+			return hashTable.Contains(key);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		Value* Find(const Lookup& key)
+		{
+			Pair* pair = hashTable.Find(key);
+			return pair == nullptr ? nullptr : &pair->second;
+		}
+
+		void ContainsMany(const Key* keys, size_t count, bool* found)
+		{
+			hashTable.ContainsMany(keys, count, found);
+		}
+
+		void FindMany(const Key* keys, size_t count, Value** values)
+		{
+			hashTable.VisitMany(keys, count, [values](size_t index, Pair* pair)
+			{
+				values[index] = pair == nullptr ? nullptr : &pair->second;
+			});
+		}
+
+		Value& operator[](const Key& key)
+		{
+			return FindOrEmplace(key, key).first->second;
+		}
+
 		virtual void Clear() override
 		{
 			hashTable.Clear();
 		}
 
+		// Inserts a random access range of pairs, on all cores when threads is 0, and returns
+		// the positions of the ones left out as duplicates.
+		template<typename RandomAccessIterator>
+		std::vector<size_t> BulkBuild(RandomAccessIterator first, RandomAccessIterator last, size_t threads = 0)
+		{
+			return hashTable.BulkBuild(first, last, threads);
+		}
+
+		void Reserve(size_t count)
+		{
+			hashTable.Reserve(count);
+		}
+
+		void Rehash(size_t capacity)
+		{
+			hashTable.Rehash(capacity);
+		}
+
+		void ShrinkToFit()
+		{
+			hashTable.ShrinkToFit();
+		}
+
+		void SetMaxLoadFactor(float value)
+		{
+			hashTable.SetMaxLoadFactor(value);
+		}
+
+		HashTableStats GetStats() const
+		{
+			return hashTable.GetStats();
+		}
+
+		void DumpDistribution(std::ostream& stream) const
+		{
+			hashTable.DumpDistribution(stream);
+		}
+
+		// Copies the map into an immutable one with single-probe lookups.
+		FrozenUnorderedMap<Key, Value, Hasher> Freeze() const
+		{
+			return FrozenUnorderedMap<Key, Value, Hasher>(hashTable.begin(), hashTable.end(), hashTable.GetHasher());
+		}
+
 	public:
 		virtual size_t GetSize() const override { return hashTable.GetSize(); }
 		virtual bool IsEmpty() const override { return hashTable.IsEmpty(); }
+		size_t GetCapacity() const { return hashTable.GetCapacity(); }
+		float GetMaxLoadFactor() const { return hashTable.GetMaxLoadFactor(); }
 
 	public:
 		virtual Iterator begin() const override
@@ -130,6 +296,19 @@ namespace Structs
 		}
 
 	private:
-		HashTable hashTable;
+		template<typename KeyArg, typename... Args>
+		std::pair<Pair*, bool> FindOrEmplace(const Key& key, KeyArg&& keyArg, Args&&... args)
+		{
+			return hashTable.FindOrInsert(key, [&]()
+			{
+				return Pair(
+					std::piecewise_construct,
+					std::forward_as_tuple(std::forward<KeyArg>(keyArg)),
+					std::forward_as_tuple(std::forward<Args>(args)...));
+			});
+		}
+
+	private:
+		Table hashTable;
 	};
 }
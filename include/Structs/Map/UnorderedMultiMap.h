@@ -0,0 +1,154 @@
+#pragma once
+#include "../HashTable/MultiHashTable.h"
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Structs
+{
+	// A map from every key to any number of values, stored contiguously per key, such as the
+	// postings of the terms of an inverted index.
+	template <typename Key, typename Value, typename Engine = Engines::Chained<>, typename Hasher = Hashers::Default<Key>>
+	class UnorderedMultiMap final : public ICollection
+	{
+	public:
+		using Table = MultiHashTable<Key, Value, Hasher, Engine>;
+
+	private:
+		template<typename Lookup>
+		using IfLookup = std::enable_if_t<Hashers::IsTransparent<Hasher>::value && !std::is_same<Lookup, Key>::value>;
+
+	public:
+		UnorderedMultiMap()
+			: multiTable()
+		{}
+
+		explicit UnorderedMultiMap(const Hasher& hasher)
+			: multiTable(hasher)
+		{}
+
+		UnorderedMultiMap(UnorderedMultiMap&& map) noexcept
+			: multiTable(std::move(map.multiTable))
+		{}
+
+		UnorderedMultiMap& operator=(UnorderedMultiMap&& map) noexcept
+		{
+			multiTable = std::move(map.multiTable);
+			return *this;
+		}
+
+	public:
+		void Insert(const Key& key, const Value& value)
+		{
+			multiTable.Emplace(key, value);
+		}
+
+		void Insert(const Key& key, Value&& value)
+		{
+			multiTable.Emplace(key, std::move(value));
+		}
+
+		template<typename... Args>
+		Value& Emplace(const Key& key, Args&&... args)
+		{
+			return multiTable.Emplace(key, std::forward<Args>(args)...);
+		}
+
+		// Removes every value of the key.
+		void Remove(const Key& key)
+		{
+			if (!TryRemove(key))
+			{
+				throw std::invalid_argument("Doesn't contain value");
+			}
+		}
+
+		bool TryRemove(const Key& key)
+		{
+			return multiTable.TryRemove(key);
+		}
+
+		bool Contains(const Key& key) const
+		{
+			return multiTable.Count(key) != 0;
+		}
+
+		size_t Count(const Key& key) const
+		{
+			return multiTable.Count(key);
+		}
+
+		// The values of the key in the order they were inserted. Inserting or removing values
+		// of any key invalidates the span.
+		Span<Value> EqualRange(const Key& key)
+		{
+			return multiTable.EqualRange(key);
+		}
+
+		Span<const Value> EqualRange(const Key& key) const
+		{
+			return multiTable.EqualRange(key);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryRemove(const Lookup& key)
+		{
+			return multiTable.TryRemove(key);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool Contains(const Lookup& key) const
+		{
+			return multiTable.Count(key) != 0;
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		size_t Count(const Lookup& key) const
+		{
+			return multiTable.Count(key);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		Span<Value> EqualRange(const Lookup& key)
+		{
+			return multiTable.EqualRange(key);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		Span<const Value> EqualRange(const Lookup& key) const
+		{
+			return multiTable.EqualRange(key);
+		}
+
+		// Calls visit(key, values) for every key.
+		template<typename Visit>
+		void ForEach(Visit visit) const
+		{
+			multiTable.ForEach(visit);
+		}
+
+		virtual void Clear() override
+		{
+			multiTable.Clear();
+		}
+
+		void ShrinkToFit()
+		{
+			multiTable.ShrinkToFit();
+		}
+
+		void Reserve(size_t keyCount, size_t valueCount)
+		{
+			multiTable.Reserve(keyCount, valueCount);
+		}
+
+	public:
+		virtual size_t GetSize() const override { return multiTable.GetSize(); }
+		virtual bool IsEmpty() const override { return multiTable.IsEmpty(); }
+		size_t GetAllocatedBytes() const { return multiTable.GetAllocatedBytes(); }
+		size_t GetKeyCount() const { return multiTable.GetKeyCount(); }
+
+	private:
+		Table multiTable;
+	};
+}
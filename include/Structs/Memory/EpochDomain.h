@@ -0,0 +1,232 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace Structs
+{
+	namespace Memory
+	{
+		// Epoch-based reclamation for memory that readers reach through an atomically published
+		// pointer. A reader announces the epoch it entered in its own slot for as long as it holds
+		// a Guard. A writer unpublishes a pointer, then retires it, which tags it with the current
+		// epoch and advances the epoch. The pointer is deleted once no reader is still inside an
+		// epoch at or before that tag, as any later reader can only have seen what replaced it.
+		//
+		// Entering and leaving are a few stores to a slot owned by the thread, so readers never
+		// wait for each other or for writers. All operations are sequentially consistent, which
+		// the argument above relies on.
+		class EpochDomain
+		{
+		public:
+			class Guard
+			{
+			public:
+				explicit Guard(EpochDomain& domain)
+					: domain(domain)
+				{
+					domain.Enter();
+				}
+
+				Guard(const Guard& guard) = delete;
+				Guard& operator=(const Guard& guard) = delete;
+
+				~Guard()
+				{
+					domain.Exit();
+				}
+
+			private:
+				EpochDomain& domain;
+			};
+
+		public:
+			EpochDomain(const EpochDomain& domain) = delete;
+			EpochDomain& operator=(const EpochDomain& domain) = delete;
+
+			~EpochDomain()
+			{
+				for (Retired& retired : retiredList)
+				{
+					retired.destroy(retired.pointer);
+				}
+			}
+
+			// Registration follows threads, so the library uses one domain for every structure.
+			static EpochDomain& GetDefault()
+			{
+				static EpochDomain domain;
+				return domain;
+			}
+
+		public:
+			template<typename T>
+			void Retire(T* pointer)
+			{
+				Retire(pointer, [](void* retired) { delete static_cast<T*>(retired); });
+			}
+
+			void Retire(void* pointer, void (*destroy)(void*))
+			{
+				{
+					std::lock_guard<std::mutex> lock(retiredLock);
+					retiredList.push_back({ pointer, destroy, epoch.fetch_add(1) });
+				}
+
+				Reclaim();
+			}
+
+			// Deletes every retired pointer no reader can still see and returns how many it deleted.
+			size_t Reclaim()
+			{
+				uint64_t oldest = GetOldestActiveEpoch();
+				std::vector<Retired> reclaimable;
+
+				{
+					std::lock_guard<std::mutex> lock(retiredLock);
+					size_t kept = 0;
+
+					for (Retired& retired : retiredList)
+					{
+						if (retired.epoch < oldest)
+						{
+							reclaimable.push_back(retired);
+						}
+						else
+						{
+							retiredList[kept++] = retired;
+						}
+					}
+
+					retiredList.resize(kept);
+				}
+
+				for (Retired& retired : reclaimable)
+				{
+					retired.destroy(retired.pointer);
+				}
+
+				return reclaimable.size();
+			}
+
+		public:
+			size_t GetRetiredCount()
+			{
+				std::lock_guard<std::mutex> lock(retiredLock);
+				return retiredList.size();
+			}
+
+		public:
+			static constexpr size_t MaxThreads = 256;
+			static constexpr size_t CacheLineSize = 64;
+
+		private:
+			static constexpr uint64_t Inactive = 0;
+
+			struct alignas(CacheLineSize) Slot
+			{
+				std::atomic<uint64_t> epoch{ Inactive };
+				std::atomic<bool> owned{ false };
+			};
+
+			struct Retired
+			{
+				void* pointer;
+				void (*destroy)(void*);
+				uint64_t epoch;
+			};
+
+			// The slot a thread announces its epoch in, claimed on its first guard and given back
+			// when the thread exits. Nested guards keep the outermost epoch.
+			struct ThreadSlot
+			{
+			public:
+				explicit ThreadSlot(EpochDomain& domain)
+					: domain(domain), index(domain.ClaimSlot()), depth(0)
+				{}
+
+				~ThreadSlot()
+				{
+					domain.slots[index].owned.store(false);
+				}
+
+			public:
+				EpochDomain& domain;
+				size_t index;
+				size_t depth;
+			};
+
+		private:
+			EpochDomain()
+				: epoch(1)
+			{}
+
+			ThreadSlot& GetThreadSlot()
+			{
+				thread_local ThreadSlot thread(*this);
+				return thread;
+			}
+
+			void Enter()
+			{
+				ThreadSlot& thread = GetThreadSlot();
+
+				if (thread.depth++ == 0)
+				{
+					slots[thread.index].epoch.store(epoch.load());
+				}
+			}
+
+			void Exit()
+			{
+				ThreadSlot& thread = GetThreadSlot();
+
+				if (--thread.depth == 0)
+				{
+					slots[thread.index].epoch.store(Inactive);
+				}
+			}
+
+			size_t ClaimSlot()
+			{
+				for (size_t i = 0; i < MaxThreads; ++i)
+				{
+					bool owned = false;
+
+					if (!slots[i].owned.load() && slots[i].owned.compare_exchange_strong(owned, true))
+					{
+						return i;
+					}
+				}
+
+				throw std::runtime_error("Too many threads use the epoch domain");
+			}
+
+			uint64_t GetOldestActiveEpoch() const
+			{
+				uint64_t oldest = epoch.load();
+
+				for (const Slot& slot : slots)
+				{
+					uint64_t announced = slot.epoch.load();
+
+					if (announced != Inactive && announced < oldest)
+					{
+						oldest = announced;
+					}
+				}
+
+				return oldest;
+			}
+
+		private:
+			alignas(CacheLineSize) std::atomic<uint64_t> epoch;
+			Slot slots[MaxThreads];
+
+			std::mutex retiredLock;
+			std::vector<Retired> retiredList;
+		};
+	}
+}
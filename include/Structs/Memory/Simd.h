@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// The instruction sets the containers use, detected once for every header. Defining
+// STRUCTS_DISABLE_SIMD turns all of them off and leaves the plain loops.
+#if !defined(STRUCTS_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define STRUCTS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if !defined(STRUCTS_DISABLE_SIMD) && defined(__AVX2__)
+#define STRUCTS_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Structs
+{
+	namespace Simd
+	{
+		// The index of the lowest set bit; the mask must not be zero.
+		inline size_t CountTrailingZeros(uint32_t mask)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return index;
+#else
+			return __builtin_ctz(mask);
+#endif
+		}
+	}
+}
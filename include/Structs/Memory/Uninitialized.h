@@ -0,0 +1,178 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Structs
+{
+	namespace Memory
+	{
+		// Types whose objects may be moved to another address by copying their bytes, leaving
+		// nothing behind to destroy. Types that only own memory through plain pointers to it
+		// can opt in by specializing this.
+		template<typename T>
+		struct IsTriviallyRelocatable : std::is_trivially_copyable<T>
+		{};
+
+		// Only types aligned beyond what operator new guarantees take its aligned overload, so
+		// everything else is allocated through the same operator new as the rest of the program.
+		template<typename T>
+		struct IsOverAligned : std::integral_constant<bool, (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)>
+		{};
+
+		// Aligned storage for count objects, none of which is constructed.
+		template<typename T>
+		T* Allocate(size_t count)
+		{
+			if (count == 0)
+			{
+				return nullptr;
+			}
+
+			if (count > static_cast<size_t>(-1) / sizeof(T))
+			{
+				throw std::bad_array_new_length();
+			}
+
+			void* elements = IsOverAligned<T>::value
+				? ::operator new(count * sizeof(T), std::align_val_t(alignof(T)))
+				: ::operator new(count * sizeof(T));
+
+			return static_cast<T*>(elements);
+		}
+
+		template<typename T>
+		void Deallocate(T* elements)
+		{
+			if (IsOverAligned<T>::value)
+			{
+				::operator delete(elements, std::align_val_t(alignof(T)));
+			}
+			else
+			{
+				::operator delete(elements);
+			}
+		}
+
+		template<typename T>
+		void Destroy(T* elements, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				elements[i].~T();
+			}
+		}
+
+		template<typename T>
+		void Relocate(T* from, size_t count, T* to, std::true_type)
+		{
+			if (count != 0)
+			{
+				std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+			}
+		}
+
+		// Types that might throw while moving are copied, so that the originals are still
+		// intact if one of them does.
+		template<typename T>
+		void Relocate(T* from, size_t count, T* to, std::false_type)
+		{
+			size_t i = 0;
+
+			try
+			{
+				for (; i < count; ++i)
+				{
+					new (&to[i]) T(std::move_if_noexcept(from[i]));
+				}
+			}
+			catch (...)
+			{
+				Destroy(to, i);
+				throw;
+			}
+
+			Destroy(from, count);
+		}
+
+		// Moves count objects into uninitialized memory that does not overlap theirs, and ends
+		// the lifetime of the originals.
+		template<typename T>
+		void Relocate(T* from, size_t count, T* to)
+		{
+			Relocate(from, count, to, IsTriviallyRelocatable<T>());
+		}
+
+		template<typename T>
+		void RelocateOverlapping(T* from, size_t count, T* to, std::true_type)
+		{
+			if (count != 0)
+			{
+				std::memmove(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+			}
+		}
+
+		template<typename T>
+		void RelocateOverlapping(T* from, size_t count, T* to, std::false_type)
+		{
+			if (to > from)
+			{
+				for (size_t i = count; i-- > 0;)
+				{
+					new (&to[i]) T(std::move(from[i]));
+					from[i].~T();
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					new (&to[i]) T(std::move(from[i]));
+					from[i].~T();
+				}
+			}
+		}
+
+		// Moves count objects within the same storage, such as the tail of an array to open or
+		// close a gap, leaving the slots they no longer cover uninitialized. Moves must not throw.
+		template<typename T>
+		void RelocateOverlapping(T* from, size_t count, T* to)
+		{
+			RelocateOverlapping(from, count, to, IsTriviallyRelocatable<T>());
+		}
+
+		// Moves count objects into new storage for capacity of them and constructs one more
+		// from args behind them, before the originals move, as args may refer to one of them.
+		// Returns the new storage; the old one is left for the caller to free.
+		template<typename T, typename... Args>
+		T* RelocateAndEmplace(T* elements, size_t count, size_t capacity, Args&&... args)
+		{
+			T* newElements = Allocate<T>(capacity);
+
+			try
+			{
+				new (&newElements[count]) T(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				Deallocate(newElements);
+				throw;
+			}
+
+			try
+			{
+				Relocate(elements, count, newElements);
+			}
+			catch (...)
+			{
+				newElements[count].~T();
+				Deallocate(newElements);
+				throw;
+			}
+
+			return newElements;
+		}
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "../HashTable/FrozenHashTable.h"
+#include <array>
+
+namespace Structs
+{
+	// An immutable set built once, usually by UnorderedSet::Freeze, whose lookups take a single
+	// probe into a table with one slot per value.
+	template <typename T, typename Hasher = Hashers::Default<T>>
+	class FrozenUnorderedSet final
+	{
+	public:
+		using Table = FrozenHashTable<T, T, Keys::NoSelector<T>, Hasher>;
+
+	public:
+		FrozenUnorderedSet()
+			: table()
+		{}
+
+		template<typename Iterator>
+		FrozenUnorderedSet(Iterator first, Iterator last)
+			: table(first, last)
+		{}
+
+		template<typename Iterator>
+		FrozenUnorderedSet(Iterator first, Iterator last, const Hasher& hasher)
+			: table(first, last, hasher)
+		{}
+
+	public:
+		bool Contains(const T& value) const
+		{
+			return table.Contains(value);
+		}
+
+	public:
+		size_t GetSize() const { return table.GetSize(); }
+		bool IsEmpty() const { return table.IsEmpty(); }
+		size_t GetAllocatedBytes() const { return table.GetAllocatedBytes(); }
+
+	public:
+		const T* begin() const
+		{
+			return table.begin();
+		}
+
+		const T* end() const
+		{
+			return table.end();
+		}
+
+	private:
+		Table table;
+	};
+
+	template <typename T, size_t Size, typename Hasher = PerfectHash::ConstexprHash<T>>
+	class StaticFrozenUnorderedSet final
+	{
+	public:
+		using Table = StaticFrozenHashTable<T, T, Size, Keys::NoSelector<T>, Hasher>;
+
+	public:
+		constexpr explicit StaticFrozenUnorderedSet(const std::array<T, Size>& values)
+			: table(values)
+		{}
+
+	public:
+		constexpr bool Contains(const T& value) const
+		{
+			return table.Contains(value);
+		}
+
+	public:
+		constexpr size_t GetSize() const { return Size; }
+		constexpr bool IsEmpty() const { return false; }
+
+	public:
+		constexpr const T* begin() const
+		{
+			return table.begin();
+		}
+
+		constexpr const T* end() const
+		{
+			return table.end();
+		}
+
+	private:
+		Table table;
+	};
+
+	// Builds a set of literal values at compile time:
+	// constexpr auto set = MakeFrozenUnorderedSet<int>({ 2, 3, 5, 7 });
+	template <typename T, size_t Size>
+	constexpr StaticFrozenUnorderedSet<T, Size> MakeFrozenUnorderedSet(const T (&values)[Size])
+	{
+		return StaticFrozenUnorderedSet<T, Size>(PerfectHash::ToArray(values));
+	}
+}
@@ -26,7 +26,9 @@ namespace Structs
 
 		virtual SetIterator& operator++(int) override
 		{
-			return SetIterator(i++);
+			SetIterator temp = *this;
+			++(*this);
+			return temp;
 		}
 
 		virtual bool operator==(const SetIterator& rhs) const override
@@ -58,6 +60,10 @@ namespace Structs
 	public:
 		using Iterator = SetIterator<T>;
 
+	private:
+		template<typename Lookup>
+		using IfLookup = std::enable_if_t<Keys::IsComparable<T, Lookup>::value>;
+
 	public:
 		Set()
 			: tree()
@@ -94,6 +100,19 @@ namespace Structs
 			return tree.Contains(value);
 		}
 
+		// A string_view or a literal finds a string without a temporary copy of it.
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryRemove(const Lookup& value)
+		{
+			return tree.TryRemove(value);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool Contains(const Lookup& value)
+		{
+			return tree.Contains(value);
+		}
+
 		virtual void Clear() override
 		{
 			tree.Clear();
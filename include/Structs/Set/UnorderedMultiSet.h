@@ -0,0 +1,123 @@
+#pragma once
+#include "../HashTable/MultiHashTable.h"
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Structs
+{
+	// A set that keeps every copy of a value inserted more than once, with the copies of each
+	// value stored next to each other.
+	template <typename T, typename Engine = Engines::Chained<>, typename Hasher = Hashers::Default<T>>
+	class UnorderedMultiSet final : public ICollection
+	{
+	public:
+		using Table = MultiHashTable<T, T, Hasher, Engine>;
+
+	private:
+		template<typename Lookup>
+		using IfLookup = std::enable_if_t<Hashers::IsTransparent<Hasher>::value && !std::is_same<Lookup, T>::value>;
+
+	public:
+		UnorderedMultiSet()
+			: multiTable()
+		{}
+
+		explicit UnorderedMultiSet(const Hasher& hasher)
+			: multiTable(hasher)
+		{}
+
+		UnorderedMultiSet(UnorderedMultiSet&& set) noexcept
+			: multiTable(std::move(set.multiTable))
+		{}
+
+		UnorderedMultiSet& operator=(UnorderedMultiSet&& set) noexcept
+		{
+			multiTable = std::move(set.multiTable);
+			return *this;
+		}
+
+	public:
+		void Insert(const T& value)
+		{
+			multiTable.Emplace(value, value);
+		}
+
+		// Removes every copy of the value.
+		void Remove(const T& value)
+		{
+			if (!TryRemove(value))
+			{
+				throw std::invalid_argument("Doesn't contain value");
+			}
+		}
+
+		bool TryRemove(const T& value)
+		{
+			return multiTable.TryRemove(value);
+		}
+
+		bool Contains(const T& value) const
+		{
+			return multiTable.Count(value) != 0;
+		}
+
+		size_t Count(const T& value) const
+		{
+			return multiTable.Count(value);
+		}
+
+		Span<const T> EqualRange(const T& value) const
+		{
+			return multiTable.EqualRange(value);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryRemove(const Lookup& value)
+		{
+			return multiTable.TryRemove(value);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool Contains(const Lookup& value) const
+		{
+			return multiTable.Count(value) != 0;
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		size_t Count(const Lookup& value) const
+		{
+			return multiTable.Count(value);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		Span<const T> EqualRange(const Lookup& value) const
+		{
+			return multiTable.EqualRange(value);
+		}
+
+		virtual void Clear() override
+		{
+			multiTable.Clear();
+		}
+
+		void ShrinkToFit()
+		{
+			multiTable.ShrinkToFit();
+		}
+
+		void Reserve(size_t valueCount)
+		{
+			multiTable.Reserve(valueCount, valueCount);
+		}
+
+	public:
+		virtual size_t GetSize() const override { return multiTable.GetSize(); }
+		virtual bool IsEmpty() const override { return multiTable.IsEmpty(); }
+		size_t GetAllocatedBytes() const { return multiTable.GetAllocatedBytes(); }
+		size_t GetDistinctCount() const { return multiTable.GetKeyCount(); }
+
+	private:
+		Table multiTable;
+	};
+}
@@ -2,20 +2,21 @@
 #include "ISet.h"
 #include <stdexcept>
 #include "../HashTable/HashTable.h"
+#include "FrozenUnorderedSet.h"
+#include <vector>
 
 namespace Structs
 {
-	template <typename T>
-	class UnorderedSetIterator : public IIterator<T, UnorderedSetIterator<T>>
+	template <typename T, typename Engine = Engines::Chained<>>
+	class UnorderedSetIterator : public IIterator<T, UnorderedSetIterator<T, Engine>>
 	{
 	public:
-		using HashTable = HashTable<T>;
-		using HashTableIterator = HashTableIterator<T>;
+		using TableIterator = typename Engine::template Storage<T>::Iterator;
 
 	public:
 		UnorderedSetIterator() = delete;
 
-		UnorderedSetIterator(HashTableIterator iterator)
+		UnorderedSetIterator(TableIterator iterator)
 			: i(iterator)
 		{}
 
@@ -27,7 +28,9 @@ namespace Structs
 
 		virtual UnorderedSetIterator& operator++(int) override
 		{
-			return UnorderedSetIterator(i++);
+			UnorderedSetIterator temp = *this;
+			++(*this);
+			return temp;
 		}
 
 		virtual bool operator==(const UnorderedSetIterator& rhs) const override
@@ -50,23 +53,31 @@ namespace Structs
 		}
 
 	private:
-		HashTableIterator i;
+		TableIterator i;
 	};
 
 
 
-	template <typename T>
-	class UnorderedSet final : public ISet<T, UnorderedSetIterator<T>>
+	template <typename T, typename Engine = Engines::Chained<>, typename Hasher = Hashers::Default<T>>
+	class UnorderedSet final : public ISet<T, UnorderedSetIterator<T, Engine>>
 	{
 	public:
-		using Iterator = UnorderedSetIterator<T>;
-		using HashTable = HashTable<T>;
+		using Iterator = UnorderedSetIterator<T, Engine>;
+		using Table = HashTable<T, T, Keys::NoSelector<T>, Hasher, Engine>;
+
+	private:
+		template<typename Lookup>
+		using IfLookup = std::enable_if_t<Hashers::IsTransparent<Hasher>::value && !std::is_same<Lookup, T>::value>;
 
 	public:
 		UnorderedSet()
 			: hashTable()
 		{}
 
+		explicit UnorderedSet(const Hasher& hasher)
+			: hashTable(hasher)
+		{}
+
 		UnorderedSet(UnorderedSet&& set) noexcept
 			: hashTable(std::move(set.hashTable))
 		{}
@@ -74,6 +85,7 @@ namespace Structs
 		UnorderedSet& operator=(UnorderedSet&& set) noexcept
 		{
 			hashTable = std::move(set.hashTable);
+			return *this;
 		}
 
 		~UnorderedSet()
@@ -87,11 +99,33 @@ namespace Structs
 			hashTable.Insert(value);
 		}
 
+		void Insert(T&& value)
+		{
+			hashTable.Insert(std::move(value));
+		}
+
+		template<typename... Args>
+		void Emplace(Args&&... args)
+		{
+			hashTable.Insert(T(std::forward<Args>(args)...));
+		}
+
 		virtual bool TryInsert(const T& value) override
 		{
 			return hashTable.TryInsert(value);
 		}
 
+		bool TryInsert(T&& value)
+		{
+			return hashTable.TryInsert(std::move(value));
+		}
+
+		template<typename... Args>
+		bool TryEmplace(Args&&... args)
+		{
+			return hashTable.TryInsert(T(std::forward<Args>(args)...));
+		}
+
 		virtual void Remove(const T& value) override
 		{
 			hashTable.Remove(value);
@@ -107,14 +141,78 @@ namespace Structs
 			return hashTable.Contains(value);
 		}
 
+		// A string_view or a literal finds a string without a temporary copy of it.
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryRemove(const Lookup& value)
+		{
+			return hashTable.TryRemove(value);
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool Contains(const Lookup& value)
+		{
+			return hashTable.Contains(value);
+		}
+
+		void ContainsMany(const T* values, size_t count, bool* found)
+		{
+			hashTable.ContainsMany(values, count, found);
+		}
+
 		virtual void Clear() override
 		{
 			hashTable.Clear();
 		}
 
+		// Inserts a random access range of values, on all cores when threads is 0, and returns
+		// the positions of the ones left out as duplicates.
+		template<typename RandomAccessIterator>
+		std::vector<size_t> BulkBuild(RandomAccessIterator first, RandomAccessIterator last, size_t threads = 0)
+		{
+			return hashTable.BulkBuild(first, last, threads);
+		}
+
+		void Reserve(size_t count)
+		{
+			hashTable.Reserve(count);
+		}
+
+		void Rehash(size_t capacity)
+		{
+			hashTable.Rehash(capacity);
+		}
+
+		void ShrinkToFit()
+		{
+			hashTable.ShrinkToFit();
+		}
+
+		void SetMaxLoadFactor(float value)
+		{
+			hashTable.SetMaxLoadFactor(value);
+		}
+
+		HashTableStats GetStats() const
+		{
+			return hashTable.GetStats();
+		}
+
+		void DumpDistribution(std::ostream& stream) const
+		{
+			hashTable.DumpDistribution(stream);
+		}
+
+		// Copies the set into an immutable one with single-probe lookups.
+		FrozenUnorderedSet<T, Hasher> Freeze() const
+		{
+			return FrozenUnorderedSet<T, Hasher>(hashTable.begin(), hashTable.end(), hashTable.GetHasher());
+		}
+
 	public:
 		virtual size_t GetSize() const override { return hashTable.GetSize(); }
 		virtual bool IsEmpty() const override { return hashTable.IsEmpty(); }
+		size_t GetCapacity() const { return hashTable.GetCapacity(); }
+		float GetMaxLoadFactor() const { return hashTable.GetMaxLoadFactor(); }
 
 	public:
 		virtual Iterator begin() const override
@@ -128,9 +226,6 @@ namespace Structs
 		}
 
 	private:
-		const static float fillValue;
-
-	private:
-		HashTable hashTable;
+		Table hashTable;
 	};
 }
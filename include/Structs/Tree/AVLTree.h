@@ -6,6 +6,7 @@
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 namespace Structs
 {
@@ -15,7 +16,12 @@ namespace Structs
 	class AVLTree final : public IIterable<Value, BinaryTreeInorderIterator<Value>>, public ICollection
 	{
 	private:
-		static_assert(std::is_base_of<Keys::Selector<Key, Value>, KeySelector>::value, "KeySelector mast be derivied from Structs::Keys::Selector");
+		static_assert(Keys::IsSelector<KeySelector, Key, Value>::value, "KeySelector must return const Key& for a const Value&");
+
+		// Keys of other types that order against Key, such as a string_view for string keys,
+		// are compared as they are instead of being converted to a temporary key.
+		template<typename Lookup>
+		using IfLookup = std::enable_if_t<Keys::IsComparable<Key, Lookup>::value>;
 
 	public:
 		using Node = BinaryTreeNode<Value>;
@@ -61,7 +67,7 @@ namespace Structs
 		void Insert(const Value& value)
 		{
 			Node* newRoot = nullptr;
-			Key key = keySelector(value);
+			const Key& key = keySelector(value);
 
 			try
 			{
@@ -78,7 +84,7 @@ namespace Structs
 		bool TryInsert(const Value& value)
 		{
 			Node* newRoot = nullptr;
-			Key key = keySelector(value);
+			const Key& key = keySelector(value);
 
 			try
 			{
@@ -95,47 +101,71 @@ namespace Structs
 
 		void Remove(const Key& key)
 		{
-			Node* newRoot = nullptr;
-
-			try
+			if (!TryRemove(key))
 			{
-				newRoot = RemoveRecursive(root, key);
-			}
-			catch (std::invalid_argument error)
-			{
-				throw error;
+				throw ::std::invalid_argument("Doesn't contain value with key = " + key);
 			}
-
-			root = newRoot;
 		}
 
 		bool TryRemove(const Key& key)
 		{
-			Node* newRoot = nullptr;
+			bool removed = false;
+			root = RemoveRecursive(root, key, removed);
+			return removed;
+		}
 
-			try
-			{
-				newRoot = RemoveRecursive(root, key);
-			}
-			catch (std::invalid_argument error)
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool TryRemove(const Lookup& key)
+		{
+			bool removed = false;
+			root = RemoveRecursive(root, key, removed);
+			return removed;
+		}
+
+		bool Contains(const Key& key) const
+		{
+			return SearchRecursive(root, key) != nullptr;
+		}
+
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		bool Contains(const Lookup& key) const
+		{
+			return SearchRecursive(root, key) != nullptr;
+		}
+
+		Value* Find(const Key& key) const
+		{
+			Node* node = SearchRecursive(root, key);
+
+			if (node == nullptr)
 			{
-				return false;
+				return nullptr;
 			}
 
-			root = newRoot;
-			return true;
+			return &node->value;
 		}
 
-		bool Contains(const Key& key) const
+		template<typename Lookup, typename = IfLookup<Lookup>>
+		Value* Find(const Lookup& key) const
 		{
 			Node* node = SearchRecursive(root, key);
 
 			if (node == nullptr)
 			{
-				return false;
+				return nullptr;
 			}
 
-			return true;
+			return &node->value;
+		}
+
+		template<typename Create>
+		std::pair<Value*, bool> FindOrInsert(const Key& key, Create create)
+		{
+			Node* node = nullptr;
+			bool inserted = false;
+
+			root = FindOrInsertRecursive(root, key, create, node, inserted);
+			return { &node->value, inserted };
 		}
 
 		virtual void Clear() override
@@ -154,7 +184,7 @@ namespace Structs
 				return new Node(value);
 			}
 
-			Key nodeKey = keySelector(node->value);
+			const Key& nodeKey = keySelector(node->value);
 
 			if (nodeKey > key)
 			{
@@ -174,41 +204,81 @@ namespace Structs
 			return BalanceNode(node, key);
 		}
 
-		Node* RemoveRecursive(Node* node, const Key& key)
+		template<typename Create>
+		Node* FindOrInsertRecursive(Node* node, const Key& key, Create& create, Node*& result, bool& inserted)
 		{
 			if (node == nullptr)
 			{
-				throw ::std::invalid_argument("Doesn't contain value with key = " + key);
+				++size;
+				inserted = true;
+				result = new Node(create());
+				return result;
+			}
+
+			const Key& nodeKey = keySelector(node->value);
+
+			if (nodeKey > key)
+			{
+				node->left = FindOrInsertRecursive(node->left, key, create, result, inserted);
+			}
+			else if (nodeKey < key)
+			{
+				node->right = FindOrInsertRecursive(node->right, key, create, result, inserted);
+			}
+			else
+			{
+				result = node;
+				return node;
 			}
 
-			Key nodeKey = keySelector(node->value);
+			if (!inserted)
+			{
+				return node;
+			}
+
+			return BalanceNode(node, key);
+		}
+
+		// Leaves the subtree as it was when no key matches, so that a failed removal neither
+		// throws nor rebalances.
+		template<typename Lookup>
+		Node* RemoveRecursive(Node* node, const Lookup& key, bool& removed)
+		{
+			if (node == nullptr)
+			{
+				return node;
+			}
+
+			const Key& nodeKey = keySelector(node->value);
 
 			if (nodeKey > key)
 			{
-				Node* newLeft = RemoveRecursive(node->left, key);
+				Node* newLeft = RemoveRecursive(node->left, key, removed);
 				node->left = newLeft;
 			}
 			else if (nodeKey < key)
 			{
-				Node* newRight = RemoveRecursive(node->right, key);
+				Node* newRight = RemoveRecursive(node->right, key, removed);
 				node->right = newRight;
 			}
 			else
 			{
+				removed = true;
 				return RemoveNode(node);
 			}
 
-			return BalanceNode(node);
+			return removed ? BalanceNode(node) : node;
 		}
 
-		Node* SearchRecursive(Node* node, const Key& key) const
+		template<typename Lookup>
+		Node* SearchRecursive(Node* node, const Lookup& key) const
 		{
 			if (node == nullptr)
 			{
 				return node;
 			}
 
-			Key nodeKey = keySelector(node->value);
+			const Key& nodeKey = keySelector(node->value);
 
 			if (nodeKey > key)
 			{
@@ -253,10 +323,13 @@ namespace Structs
 			}
 			else
 			{
+				// The removed value takes the successor's place, where it is the smallest
+				// key of the right subtree, so swapping moves both without copying them.
 				Node* temp = GetMostLeftChildOf(node->right);
-				node->value = temp->value;
-				node->right = RemoveRecursive(node->right, keySelector(temp->value));
-				return node;
+				std::swap(node->value, temp->value);
+				bool removed = false;
+				node->right = RemoveRecursive(node->right, keySelector(temp->value), removed);
+				return BalanceNode(node);
 			}
 		}
 
@@ -266,7 +339,7 @@ namespace Structs
 
 			if (bf > 1)
 			{
-				size_t bfLeft = GetBalanceFactorOf(node->left);
+				int bfLeft = GetBalanceFactorOf(node->left);
 
 				// Left Left Case  
 				if (bfLeft >= 0)
@@ -284,7 +357,7 @@ namespace Structs
 
 			if (bf < -1)
 			{
-				size_t bfRight = GetBalanceFactorOf(node->right);
+				int bfRight = GetBalanceFactorOf(node->right);
 
 				// Right Right Case  
 				if (bfRight <= 0)
@@ -309,7 +382,7 @@ namespace Structs
 
 			if (bf > 1)
 			{
-				Key lKey = keySelector(node->left->value);
+				const Key& lKey = keySelector(node->left->value);
 
 				// Left Left Case  
 				if (newKey <= lKey)
@@ -327,7 +400,7 @@ namespace Structs
 
 			if (bf < -1)
 			{
-				Key rKey = keySelector(node->right->value);
+				const Key& rKey = keySelector(node->right->value);
 
 				// Right Right Case  
 				if (newKey >= rKey)
@@ -101,7 +101,7 @@ namespace Structs
 			if (parent == nullptr)
 			{
 				root = newNode;
-				return;
+				return true;
 			}
 
 			bool isRightChild = parent->value <= value;
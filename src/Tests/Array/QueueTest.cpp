@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 #include "Array/Queue.h"
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 
 class QueueTest : public testing::Test
@@ -218,4 +220,59 @@ TEST_P(QueueParametrizedTestWithMultipleValues, QueueEnqueueMultipleValuesThrows
 			Queue.Enqueue(value);
 		);
 	}
-}
\ No newline at end of file
+}
+TEST(QueueScanTest, QueueScansWrappedAroundElements)
+{
+	Structs::Queue<int> queue;
+	std::vector<int> values;
+
+	// Dequeuing from the front and enqueuing behind it walks the elements around the buffer,
+	// so they are split in two at every offset.
+	for (int i = 0; i < 40; ++i)
+	{
+		queue.Enqueue(i);
+		values.push_back(i);
+	}
+
+	for (int step = 0; step < 200; ++step)
+	{
+		queue.Dequeue();
+		values.erase(values.begin());
+
+		int value = step % 3 == 0 ? -step : 40 + step;
+		queue.Enqueue(value);
+		values.push_back(value);
+
+		int min = values[0];
+		int max = values[0];
+		int sum = 0;
+
+		for (int element : values)
+		{
+			min = std::min(min, element);
+			max = std::max(max, element);
+			sum += element;
+		}
+
+		ASSERT_EQ(queue.Min(), min);
+		ASSERT_EQ(queue.Max(), max);
+		ASSERT_EQ(queue.Sum(), sum);
+		ASSERT_EQ(queue.IndexOf(value), values.size() - 1);
+		ASSERT_EQ(queue.IndexOf(values[0]), 0);
+		ASSERT_EQ(queue.Count(value), 1);
+		ASSERT_EQ(queue.Contains(-100000), false);
+	}
+}
+
+TEST(QueueScanTest, QueueEnqueueAfterDrainingKeepsOrder)
+{
+	Structs::Queue<int> queue;
+	queue.Enqueue(1);
+	queue.Dequeue();
+	queue.Enqueue(2);
+	queue.Enqueue(3);
+
+	ASSERT_EQ(queue.Peek(), 2);
+	ASSERT_EQ(queue.IndexOf(3), 1);
+	ASSERT_THROW(Structs::Queue<double>().Min(), std::out_of_range);
+}
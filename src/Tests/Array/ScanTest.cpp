@@ -0,0 +1,180 @@
+#include "gtest/gtest.h"
+#include "Array/Scan.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+template<typename T>
+class ScanTest : public testing::Test
+{
+public:
+	// Lengths around every multiple of the widest step, so each kernel runs with and without a
+	// tail and the tail runs with and without a full block before it.
+	static std::vector<size_t> GetLengths()
+	{
+		std::vector<size_t> lengths;
+
+		for (size_t length = 0; length <= 70; ++length)
+		{
+			lengths.push_back(length);
+		}
+
+		lengths.push_back(1000);
+		lengths.push_back(1001);
+		return lengths;
+	}
+
+	static std::vector<T> MakeElements(size_t count)
+	{
+		std::vector<T> elements(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			elements[i] = static_cast<T>(static_cast<int>(i * 7 % 101) - 50);
+		}
+
+		return elements;
+	}
+
+	static Structs::Span<const T> ToSpan(const std::vector<T>& elements)
+	{
+		return Structs::Span<const T>(elements.data(), elements.size());
+	}
+};
+
+using ScanTypes = testing::Types<int32_t, int64_t, float, double>;
+TYPED_TEST_CASE(ScanTest, ScanTypes);
+
+TYPED_TEST(ScanTest, ScanIndexOfFindsFirstMatchAtEveryPosition)
+{
+	for (size_t length : TestFixture::GetLengths())
+	{
+		for (size_t position = 0; position < length; ++position)
+		{
+			std::vector<TypeParam> elements(length, TypeParam(1));
+			elements[position] = TypeParam(2);
+
+			if (position + 1 < length)
+			{
+				elements[length - 1] = TypeParam(2);
+			}
+
+			ASSERT_EQ(Structs::Scan::IndexOf(TestFixture::ToSpan(elements), TypeParam(2)), position);
+			ASSERT_EQ(Structs::Scan::Contains(TestFixture::ToSpan(elements), TypeParam(2)), true);
+		}
+
+		std::vector<TypeParam> elements(length, TypeParam(1));
+
+		ASSERT_EQ(Structs::Scan::IndexOf(TestFixture::ToSpan(elements), TypeParam(2)), Structs::Scan::NotFound);
+		ASSERT_EQ(Structs::Scan::Contains(TestFixture::ToSpan(elements), TypeParam(2)), false);
+	}
+}
+
+TYPED_TEST(ScanTest, ScanCountMatchesLoop)
+{
+	for (size_t length : TestFixture::GetLengths())
+	{
+		std::vector<TypeParam> elements = TestFixture::MakeElements(length);
+
+		for (int value = -50; value <= 50; value += 7)
+		{
+			size_t expected = 0;
+
+			for (TypeParam element : elements)
+			{
+				expected += element == TypeParam(value) ? 1 : 0;
+			}
+
+			ASSERT_EQ(Structs::Scan::Count(TestFixture::ToSpan(elements), TypeParam(value)), expected);
+		}
+	}
+}
+
+TYPED_TEST(ScanTest, ScanMinMaxSumMatchLoop)
+{
+	for (size_t length : TestFixture::GetLengths())
+	{
+		if (length == 0)
+		{
+			continue;
+		}
+
+		std::vector<TypeParam> elements = TestFixture::MakeElements(length);
+		TypeParam min = elements[0];
+		TypeParam max = elements[0];
+		TypeParam sum = TypeParam();
+
+		for (TypeParam element : elements)
+		{
+			min = element < min ? element : min;
+			max = max < element ? element : max;
+			sum += element;
+		}
+
+		ASSERT_EQ(Structs::Scan::Min(TestFixture::ToSpan(elements)), min);
+		ASSERT_EQ(Structs::Scan::Max(TestFixture::ToSpan(elements)), max);
+		ASSERT_EQ(Structs::Scan::Sum(TestFixture::ToSpan(elements)), sum);
+	}
+}
+
+TYPED_TEST(ScanTest, ScanFindsExtremesAtEveryPosition)
+{
+	for (size_t position = 0; position < 67; ++position)
+	{
+		std::vector<TypeParam> elements = TestFixture::MakeElements(67);
+		elements[position] = std::numeric_limits<TypeParam>::lowest();
+
+		ASSERT_EQ(Structs::Scan::Min(TestFixture::ToSpan(elements)), std::numeric_limits<TypeParam>::lowest());
+
+		elements[position] = std::numeric_limits<TypeParam>::max();
+
+		ASSERT_EQ(Structs::Scan::Max(TestFixture::ToSpan(elements)), std::numeric_limits<TypeParam>::max());
+	}
+}
+
+TYPED_TEST(ScanTest, ScanMinMaxOfEmptySpanThrowsException)
+{
+	Structs::Span<const TypeParam> span;
+
+	ASSERT_THROW(Structs::Scan::Min(span), std::out_of_range);
+	ASSERT_THROW(Structs::Scan::Max(span), std::out_of_range);
+	ASSERT_EQ(Structs::Scan::Sum(span), TypeParam());
+}
+
+TEST(ScanIntegerTest, ScanSumWrapsAroundOnOverflow)
+{
+	std::vector<int32_t> elements(100, std::numeric_limits<int32_t>::max());
+	int64_t expected = static_cast<int64_t>(std::numeric_limits<int32_t>::max()) * 100;
+
+	ASSERT_EQ(Structs::Scan::Sum(Structs::Span<const int32_t>(elements.data(), elements.size())), static_cast<int32_t>(static_cast<uint32_t>(expected)));
+}
+
+TEST(ScanFloatingPointTest, ScanNaNEqualsNothing)
+{
+	std::vector<double> elements(40, std::numeric_limits<double>::quiet_NaN());
+	Structs::Span<const double> span(elements.data(), elements.size());
+
+	ASSERT_EQ(Structs::Scan::Contains(span, std::numeric_limits<double>::quiet_NaN()), false);
+	ASSERT_EQ(Structs::Scan::Count(span, std::numeric_limits<double>::quiet_NaN()), 0);
+}
+
+TEST(ScanFloatingPointTest, ScanNegativeZeroEqualsZero)
+{
+	std::vector<float> elements(40, 1.0f);
+	elements[37] = -0.0f;
+
+	ASSERT_EQ(Structs::Scan::IndexOf(Structs::Span<const float>(elements.data(), elements.size()), 0.0f), 37);
+}
+
+TEST(ScanFallbackTest, ScanWorksOnAnyComparableType)
+{
+	std::vector<std::string> elements = { "b", "a", "c", "a" };
+	Structs::Span<std::string> span(elements.data(), elements.size());
+
+	ASSERT_EQ(Structs::Scan::IndexOf(span, "a"), 1);
+	ASSERT_EQ(Structs::Scan::Count(span, "a"), 2);
+	ASSERT_EQ(Structs::Scan::Min(span), "a");
+	ASSERT_EQ(Structs::Scan::Max(span), "c");
+	ASSERT_EQ(Structs::Scan::Sum(span), "baca");
+}
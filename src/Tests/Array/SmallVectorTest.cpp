@@ -0,0 +1,182 @@
+#include "gtest/gtest.h"
+#include "Array/SmallVector.h"
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+	std::string MakeLongString(int i)
+	{
+		return std::to_string(i) + " is too long for the small string buffer";
+	}
+
+	size_t CountElements(const Structs::VectorBase<std::string>& vector)
+	{
+		size_t count = 0;
+
+		for (const std::string& value : vector)
+		{
+			count += value.empty() ? 0 : 1;
+		}
+
+		return count;
+	}
+
+	// Its move may throw, so relocating it copies, and copies throw once armed.
+	struct ThrowingCopy
+	{
+		static inline bool throwOnCopy = false;
+		int value;
+
+		explicit ThrowingCopy(int value)
+			: value(value)
+		{}
+
+		ThrowingCopy(const ThrowingCopy& other)
+			: value(other.value)
+		{
+			if (throwOnCopy)
+			{
+				throw std::runtime_error("Copy failed");
+			}
+		}
+
+		ThrowingCopy(ThrowingCopy&& other)
+			: value(other.value)
+		{}
+	};
+}
+
+TEST(SmallVectorTest, SmallVectorKeepsElementsInlineUpToCapacity)
+{
+	Structs::SmallVector<std::string, 4> vector;
+
+	ASSERT_EQ(vector.GetCapacity(), 4);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		vector.Add(MakeLongString(i));
+	}
+
+	ASSERT_EQ(vector.IsInline(), true);
+
+	vector.Add(MakeLongString(4));
+
+	ASSERT_EQ(vector.IsInline(), false);
+	ASSERT_EQ(vector.GetSize(), 5);
+
+	for (int i = 0; i < 5; ++i)
+	{
+		ASSERT_EQ(vector[i], MakeLongString(i));
+	}
+}
+
+TEST(SmallVectorTest, SmallVectorShrinkToFitMovesBackInline)
+{
+	Structs::SmallVector<std::string, 4> vector;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		vector.Add(MakeLongString(i));
+	}
+
+	vector.Resize(3);
+	vector.ShrinkToFit();
+
+	ASSERT_EQ(vector.IsInline(), true);
+	ASSERT_EQ(vector.GetCapacity(), 4);
+	ASSERT_EQ(vector[2], MakeLongString(2));
+}
+
+TEST(SmallVectorTest, SmallVectorMoveOfInlineElementsMovesThem)
+{
+	Structs::SmallVector<std::string, 4> vector;
+	vector.Add(MakeLongString(0));
+	vector.Add(MakeLongString(1));
+
+	Structs::SmallVector<std::string, 4> moved(std::move(vector));
+
+	ASSERT_EQ(moved.IsInline(), true);
+	ASSERT_EQ(moved.GetSize(), 2);
+	ASSERT_EQ(moved[1], MakeLongString(1));
+	ASSERT_EQ(vector.IsEmpty(), true);
+
+	vector.Add(MakeLongString(2));
+	vector = std::move(moved);
+
+	ASSERT_EQ(vector.GetSize(), 2);
+	ASSERT_EQ(vector[0], MakeLongString(0));
+}
+
+TEST(SmallVectorTest, SmallVectorMoveOfHeapElementsTakesStorage)
+{
+	Structs::SmallVector<std::string, 2> vector;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		vector.Add(MakeLongString(i));
+	}
+
+	const std::string* first = &vector[0];
+	Structs::SmallVector<std::string, 2> moved(std::move(vector));
+
+	ASSERT_EQ(&moved[0], first);
+	ASSERT_EQ(vector.IsInline(), true);
+	ASSERT_EQ(vector.GetCapacity(), 2);
+
+	vector.Add(MakeLongString(10));
+
+	ASSERT_EQ(vector.GetSize(), 1);
+}
+
+TEST(SmallVectorTest, SmallVectorWorksAsVectorBase)
+{
+	Structs::SmallVector<std::string, 4> small;
+	Structs::Vector<std::string> vector;
+
+	for (int i = 0; i < 6; ++i)
+	{
+		small.Add(MakeLongString(i));
+		vector.Add(MakeLongString(i));
+	}
+
+	ASSERT_EQ(CountElements(small), 6);
+	ASSERT_EQ(CountElements(vector), 6);
+}
+
+TEST(SmallVectorTest, SmallVectorInsertRangeSpillsOnce)
+{
+	Structs::SmallVector<int, 8> vector;
+	int values[] = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+
+	vector.Add(0);
+	vector.Add(1);
+	vector.InsertRange(1, values, values + 10);
+
+	ASSERT_EQ(vector.GetSize(), 12);
+	ASSERT_EQ(vector.GetCapacity(), 16);
+	ASSERT_EQ(vector[0], 0);
+	ASSERT_EQ(vector[10], 19);
+	ASSERT_EQ(vector[11], 1);
+}
+
+TEST(SmallVectorTest, SmallVectorMoveOfThrowingInlineElementsThrows)
+{
+	using Small = Structs::SmallVector<ThrowingCopy, 4>;
+
+	static_assert(std::is_nothrow_move_constructible<Structs::SmallVector<std::string, 4>>::value, "Strings move without throwing");
+	static_assert(!std::is_nothrow_move_constructible<Small>::value, "Copies of inline elements may throw");
+
+	Small vector;
+	vector.Add(ThrowingCopy(1));
+	vector.Add(ThrowingCopy(2));
+
+	ThrowingCopy::throwOnCopy = true;
+	ASSERT_THROW(Small moved(std::move(vector)), std::runtime_error);
+	ThrowingCopy::throwOnCopy = false;
+
+	ASSERT_EQ(vector.GetSize(), 2);
+	ASSERT_EQ(vector[1].value, 2);
+}
@@ -1,5 +1,8 @@
 #include "gtest/gtest.h"
 #include "Array/Stack.h"
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
 class StackTest : public testing::Test
@@ -218,4 +221,72 @@ TEST_P(StackParametrizedTestWithMultipleValues, StackInsertMultipleValuesThrowsN
 			Stack.Push(value);
 		);
 	}
-}
\ No newline at end of file
+}
+
+TEST(StackStorageTest, StackPopMovesValueOut)
+{
+	Structs::Stack<std::string> stack;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		stack.Push(std::to_string(i) + " is too long for the small string buffer");
+	}
+
+	for (int i = 99; i >= 0; --i)
+	{
+		ASSERT_EQ(stack.Pop(), std::to_string(i) + " is too long for the small string buffer");
+	}
+
+	ASSERT_EQ(stack.IsEmpty(), true);
+}
+
+TEST(StackStorageTest, StackGrowingKeepsSharedOwnership)
+{
+	std::shared_ptr<int> shared = std::make_shared<int>(1);
+
+	{
+		Structs::Stack<std::shared_ptr<int>> stack;
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			stack.Push(shared);
+		}
+
+		ASSERT_EQ(shared.use_count(), 1001);
+
+		stack.Reserve(5000);
+		stack.Pop();
+
+		ASSERT_EQ(stack.GetCapacity(), 5000);
+		ASSERT_EQ(shared.use_count(), 1000);
+
+		stack.ShrinkToFit();
+
+		ASSERT_EQ(stack.GetCapacity(), 999);
+		ASSERT_EQ(stack.Peek(), shared);
+	}
+
+	ASSERT_EQ(shared.use_count(), 1);
+}
+
+TEST(StackScanTest, StackScansMatchElementLoop)
+{
+	Structs::Stack<int64_t> stack;
+
+	for (int64_t i = 0; i < 1000; ++i)
+	{
+		stack.Push(i % 4 == 0 ? -i : i);
+	}
+
+	ASSERT_EQ(stack.Contains(-996), true);
+	ASSERT_EQ(stack.IndexOf(-8), 8);
+	ASSERT_EQ(stack.IndexOf(-9), Structs::Stack<int64_t>::NotFound);
+	ASSERT_EQ(stack.Count(0), 1);
+	ASSERT_EQ(stack.Min(), -996);
+	ASSERT_EQ(stack.Max(), 999);
+	ASSERT_EQ(stack.Sum(), 999 * 1000 / 2 - 2 * (996 * 250 / 2));
+
+	stack.Clear();
+
+	ASSERT_THROW(stack.Min(), std::out_of_range);
+}
@@ -1,7 +1,75 @@
 #include "gtest/gtest.h"
 #include "Array/Vector.h"
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+struct TrackedElement
+{
+	int value;
+
+	static int defaultConstructions;
+	static int copies;
+	static int live;
+
+	TrackedElement()
+		: value(0)
+	{
+		++defaultConstructions;
+		++live;
+	}
+
+	TrackedElement(int value)
+		: value(value)
+	{
+		++live;
+	}
+
+	TrackedElement(const TrackedElement& element)
+		: value(element.value)
+	{
+		++copies;
+		++live;
+	}
+
+	TrackedElement(TrackedElement&& element) noexcept
+		: value(element.value)
+	{
+		++live;
+	}
+
+	TrackedElement& operator=(const TrackedElement& element)
+	{
+		value = element.value;
+		++copies;
+		return *this;
+	}
+
+	TrackedElement& operator=(TrackedElement&& element) noexcept
+	{
+		value = element.value;
+		return *this;
+	}
+
+	~TrackedElement()
+	{
+		--live;
+	}
+
+	static void Reset()
+	{
+		defaultConstructions = 0;
+		copies = 0;
+		live = 0;
+	}
+};
+
+int TrackedElement::defaultConstructions = 0;
+int TrackedElement::copies = 0;
+int TrackedElement::live = 0;
+
 class VectorTest : public testing::Test
 {
 public:
@@ -191,4 +259,500 @@ TEST_P(VectorParametrizedTestWithMultipleValues, VectorInsertMultipleValuesThrow
 			Vector.Add(value);
 		);
 	}
-}
\ No newline at end of file
+}
+
+TEST(VectorStorageTest, VectorGrowingMovesElementsWithoutConstructingFreeSlots)
+{
+	TrackedElement::Reset();
+
+	{
+		Structs::Vector<TrackedElement> vector;
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			TrackedElement element(i);
+			vector.Add(element);
+		}
+
+		ASSERT_EQ(TrackedElement::defaultConstructions, 0);
+		ASSERT_EQ(TrackedElement::copies, 1000);
+		ASSERT_EQ(TrackedElement::live, 1000);
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			ASSERT_EQ(vector[i].value, i);
+		}
+	}
+
+	ASSERT_EQ(TrackedElement::live, 0);
+}
+
+TEST(VectorStorageTest, VectorReserveKeepsElementsInPlace)
+{
+	Structs::Vector<std::string> vector;
+	vector.Reserve(1000);
+
+	ASSERT_EQ(vector.GetCapacity(), 1000);
+
+	vector.Add("first");
+	const std::string* first = &vector[0];
+
+	for (int i = 1; i < 1000; ++i)
+	{
+		vector.Add(std::to_string(i));
+	}
+
+	ASSERT_EQ(&vector[0], first);
+	ASSERT_EQ(vector.GetCapacity(), 1000);
+}
+
+TEST(VectorStorageTest, VectorShrinkToFitReleasesSpareCapacity)
+{
+	Structs::Vector<std::string> vector;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		vector.Add(std::to_string(i) + " is too long for the small string buffer");
+	}
+
+	vector.ShrinkToFit();
+
+	ASSERT_EQ(vector.GetCapacity(), 100);
+	ASSERT_EQ(vector[99], "99 is too long for the small string buffer");
+
+	vector.Clear();
+	vector.ShrinkToFit();
+
+	ASSERT_EQ(vector.GetCapacity(), 0);
+
+	vector.Add("again");
+
+	ASSERT_EQ(vector.GetSize(), 1);
+}
+
+TEST(VectorStorageTest, VectorResizeAddsAndRemovesElements)
+{
+	Structs::Vector<std::string> vector;
+	vector.Add("a");
+	vector.Resize(10);
+
+	ASSERT_EQ(vector.GetSize(), 10);
+	ASSERT_EQ(vector[0], "a");
+	ASSERT_EQ(vector[9], "");
+
+	vector.Resize(20, vector[0]);
+
+	ASSERT_EQ(vector.GetSize(), 20);
+	ASSERT_EQ(vector[19], "a");
+
+	vector.Resize(2);
+
+	ASSERT_EQ(vector.GetSize(), 2);
+	ASSERT_EQ(vector.Contains(""), true);
+	ASSERT_EQ(vector.Contains("a"), true);
+}
+
+TEST(VectorStorageTest, VectorAddOwnElementWhileGrowing)
+{
+	Structs::Vector<std::string> vector;
+	vector.ShrinkToFit();
+	vector.Add("element long enough to live on the heap");
+
+	for (int i = 0; i < 10; ++i)
+	{
+		vector.Add(vector[0]);
+		vector.Insert(vector[0], 0);
+	}
+
+	ASSERT_EQ(vector.GetSize(), 21);
+
+	for (const std::string& value : vector)
+	{
+		ASSERT_EQ(value, "element long enough to live on the heap");
+	}
+}
+
+TEST(VectorStorageTest, VectorInsertAtFrontShiftsElements)
+{
+	Structs::Vector<int> vector;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		vector.Insert(i, 0);
+	}
+
+	for (int i = 0; i < 10; ++i)
+	{
+		ASSERT_EQ(vector[i], 9 - i);
+	}
+}
+
+TEST(VectorRangeTest, VectorAddRvalueMovesValue)
+{
+	TrackedElement::Reset();
+
+	{
+		Structs::Vector<TrackedElement> vector;
+
+		for (int i = 0; i < 100; ++i)
+		{
+			vector.Add(TrackedElement(i));
+		}
+
+		TrackedElement& last = vector.EmplaceBack(100);
+
+		ASSERT_EQ(&last, &vector[100]);
+		ASSERT_EQ(last.value, 100);
+		ASSERT_EQ(TrackedElement::copies, 0);
+	}
+
+	ASSERT_EQ(TrackedElement::live, 0);
+}
+
+TEST(VectorRangeTest, VectorAddRangeGrowsOnce)
+{
+	std::vector<std::string> values;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		values.push_back(std::to_string(i));
+	}
+
+	Structs::Vector<std::string> vector;
+	vector.Add("first");
+	vector.AddRange(values.begin(), values.end());
+
+	ASSERT_EQ(vector.GetSize(), 101);
+	ASSERT_EQ(vector.GetCapacity(), 101);
+	ASSERT_EQ(vector[0], "first");
+	ASSERT_EQ(vector[100], "99");
+
+	vector.AddRange(values.begin(), values.begin() + 1);
+
+	ASSERT_EQ(vector.GetCapacity(), 202);
+}
+
+TEST(VectorRangeTest, VectorAddRangeOfSinglePassIterators)
+{
+	std::istringstream stream("1 2 3 4 5 6 7");
+	Structs::Vector<int> vector;
+	vector.AddRange(std::istream_iterator<int>(stream), std::istream_iterator<int>());
+
+	ASSERT_EQ(vector.GetSize(), 7);
+	ASSERT_EQ(vector[6], 7);
+}
+
+TEST(VectorRangeTest, VectorInsertRangeShiftsTail)
+{
+	Structs::Vector<int> vector;
+	std::vector<int> values = { 100, 101, 102 };
+
+	for (int i = 0; i < 5; ++i)
+	{
+		vector.Add(i);
+	}
+
+	vector.InsertRange(0, values.begin(), values.end());
+	vector.InsertRange(5, values.begin(), values.end());
+	vector.InsertRange(vector.GetSize(), values.begin(), values.end());
+
+	std::vector<int> expected = { 100, 101, 102, 0, 1, 100, 101, 102, 2, 3, 4, 100, 101, 102 };
+
+	ASSERT_EQ(vector.GetSize(), expected.size());
+
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		ASSERT_EQ(vector[i], expected[i]);
+	}
+
+	ASSERT_THROW(vector.InsertRange(15, values.begin(), values.end()), std::out_of_range);
+}
+
+TEST(VectorRangeTest, VectorInsertRangeMovesNonTrivialTail)
+{
+	Structs::Vector<std::string> vector;
+	std::vector<std::string> values;
+
+	for (int i = 0; i < 20; ++i)
+	{
+		vector.Add("old " + std::to_string(i) + " is too long for the small string buffer");
+		values.push_back("new " + std::to_string(i) + " is too long for the small string buffer");
+	}
+
+	vector.InsertRange(10, values.begin(), values.end());
+
+	ASSERT_EQ(vector.GetSize(), 40);
+	ASSERT_EQ(vector[9], "old 9 is too long for the small string buffer");
+	ASSERT_EQ(vector[10], "new 0 is too long for the small string buffer");
+	ASSERT_EQ(vector[29], "new 19 is too long for the small string buffer");
+	ASSERT_EQ(vector[30], "old 10 is too long for the small string buffer");
+	ASSERT_EQ(vector[39], "old 19 is too long for the small string buffer");
+}
+
+struct ThrowingCopyElement
+{
+	int value;
+
+	static int throwOn;
+
+	ThrowingCopyElement(int value)
+		: value(value)
+	{}
+
+	ThrowingCopyElement(const ThrowingCopyElement& element)
+		: value(element.value)
+	{
+		if (value == throwOn)
+		{
+			throw std::runtime_error("Copy failed");
+		}
+	}
+
+	ThrowingCopyElement(ThrowingCopyElement&& element) noexcept
+		: value(element.value)
+	{}
+
+	ThrowingCopyElement& operator=(ThrowingCopyElement&& element) noexcept
+	{
+		value = element.value;
+		return *this;
+	}
+};
+
+int ThrowingCopyElement::throwOn = -1;
+
+TEST(VectorRangeTest, VectorInsertRangeThrowingCopyLeavesVectorUnchanged)
+{
+	Structs::Vector<ThrowingCopyElement> vector;
+	std::vector<ThrowingCopyElement> values;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		vector.EmplaceBack(i);
+		values.emplace_back(100 + i);
+	}
+
+	ThrowingCopyElement::throwOn = 105;
+
+	ASSERT_THROW(vector.InsertRange(3, values.begin(), values.end()), std::runtime_error);
+	ASSERT_THROW(vector.AddRange(values.begin(), values.end()), std::runtime_error);
+
+	ThrowingCopyElement::throwOn = -1;
+
+	ASSERT_EQ(vector.GetSize(), 10);
+
+	for (int i = 0; i < 10; ++i)
+	{
+		ASSERT_EQ(vector[i].value, i);
+	}
+}
+
+TEST(VectorScanTest, VectorScansMatchElementLoop)
+{
+	Structs::Vector<int> vector;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		vector.Add(i % 10 == 3 ? -i : i);
+	}
+
+	ASSERT_EQ(vector.Contains(-993), true);
+	ASSERT_EQ(vector.Contains(993), false);
+	ASSERT_EQ(vector.IndexOf(-13), 13);
+	ASSERT_EQ(vector.IndexOf(1000), Structs::Vector<int>::NotFound);
+	ASSERT_EQ(vector.Count(-3), 1);
+	ASSERT_EQ(vector.Count(3), 0);
+	ASSERT_EQ(vector.Min(), -993);
+	ASSERT_EQ(vector.Max(), 999);
+
+	int sum = 0;
+
+	for (int value : vector)
+	{
+		sum += value;
+	}
+
+	ASSERT_EQ(vector.Sum(), sum);
+}
+
+TEST(VectorScanTest, VectorMinMaxOfEmptyVectorThrowsException)
+{
+	Structs::Vector<double> vector;
+
+	ASSERT_THROW(vector.Min(), std::out_of_range);
+	ASSERT_THROW(vector.Max(), std::out_of_range);
+	ASSERT_EQ(vector.Sum(), 0.0);
+	ASSERT_EQ(vector.Contains(0.0), false);
+}
+
+TEST(VectorScanTest, VectorScansElementsOfOtherTypes)
+{
+	Structs::Vector<std::string> vector;
+	vector.Add("b");
+	vector.Add("a");
+	vector.Add("b");
+
+	ASSERT_EQ(vector.IndexOf("b"), 0);
+	ASSERT_EQ(vector.Count("b"), 2);
+	ASSERT_EQ(vector.Min(), "a");
+}
+
+namespace
+{
+	Structs::Vector<std::string> MakeStrings(int count)
+	{
+		Structs::Vector<std::string> vector;
+
+		for (int i = 0; i < count; ++i)
+		{
+			vector.Add(std::to_string(i) + " is too long for the small string buffer");
+		}
+
+		return vector;
+	}
+
+	std::vector<int> ToInts(const Structs::Vector<std::string>& vector)
+	{
+		std::vector<int> values;
+
+		for (const std::string& value : vector)
+		{
+			values.push_back(std::stoi(value));
+		}
+
+		return values;
+	}
+}
+
+TEST(VectorRemoveTest, VectorRemoveIfKeepsOrderOfSurvivors)
+{
+	Structs::Vector<std::string> vector = MakeStrings(100);
+
+	size_t removed = vector.RemoveIf([](const std::string& value) { return std::stoi(value) % 3 != 1; });
+
+	ASSERT_EQ(removed, 67);
+	ASSERT_EQ(vector.GetSize(), 33);
+
+	std::vector<int> values = ToInts(vector);
+
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		ASSERT_EQ(values[i], static_cast<int>(i) * 3 + 1);
+	}
+}
+
+TEST(VectorRemoveTest, VectorRemoveIfDestroysRemovedElements)
+{
+	TrackedElement::live = 0;
+
+	{
+		Structs::Vector<TrackedElement> vector;
+
+		for (int i = 0; i < 50; ++i)
+		{
+			vector.EmplaceBack(i);
+		}
+
+		ASSERT_EQ(vector.RemoveIf([](const TrackedElement& element) { return element.value < 10 || element.value >= 45; }), 15);
+		ASSERT_EQ(TrackedElement::live, 35);
+		ASSERT_EQ(vector[0].value, 10);
+		ASSERT_EQ(vector[34].value, 44);
+		ASSERT_EQ(vector.RemoveIf([](const TrackedElement&) { return false; }), 0);
+		ASSERT_EQ(vector.RemoveIf([](const TrackedElement&) { return true; }), 35);
+		ASSERT_EQ(vector.IsEmpty(), true);
+	}
+
+	ASSERT_EQ(TrackedElement::live, 0);
+}
+
+TEST(VectorRemoveTest, VectorRemoveIfThrowingPredicateKeepsUnvisitedElements)
+{
+	Structs::Vector<std::string> vector = MakeStrings(20);
+	int visited = 0;
+
+	ASSERT_THROW(vector.RemoveIf([&visited](const std::string& value)
+	{
+		if (++visited > 10)
+		{
+			throw std::runtime_error("predicate");
+		}
+
+		return std::stoi(value) % 2 == 0;
+	}), std::runtime_error);
+
+	std::vector<int> expected = { 1, 3, 5, 7, 9 };
+
+	for (int i = 10; i < 20; ++i)
+	{
+		expected.push_back(i);
+	}
+
+	ASSERT_EQ(ToInts(vector), expected);
+}
+
+TEST(VectorRemoveTest, VectorRemoveAllRemovesEveryMatch)
+{
+	Structs::Vector<int> vector;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		vector.Add(i % 7);
+	}
+
+	ASSERT_EQ(vector.RemoveAll(3), 143);
+	ASSERT_EQ(vector.RemoveAll(3), 0);
+	ASSERT_EQ(vector.GetSize(), 857);
+	ASSERT_EQ(vector.Contains(3), false);
+	ASSERT_EQ(vector[3], 4);
+}
+
+TEST(VectorRemoveTest, VectorRemoveAllOfOwnElement)
+{
+	Structs::Vector<std::string> vector;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		vector.Add(i % 2 == 0 ? "a string too long for the small string buffer" : "b");
+	}
+
+	ASSERT_EQ(vector.RemoveAll(vector[0]), 5);
+	ASSERT_EQ(vector.GetSize(), 5);
+	ASSERT_EQ(vector.Count("b"), 5);
+}
+
+TEST(VectorRemoveTest, VectorRemoveAtIndicesRemovesListedPositions)
+{
+	Structs::Vector<std::string> vector = MakeStrings(10);
+	std::vector<size_t> indices = { 0, 3, 3, 4, 9 };
+
+	ASSERT_EQ(vector.RemoveAtIndices(Structs::Span<const size_t>(indices.data(), indices.size())), 4);
+	ASSERT_EQ(ToInts(vector), (std::vector<int> { 1, 2, 5, 6, 7, 8 }));
+	ASSERT_EQ(vector.RemoveAtIndices(Structs::Span<const size_t>()), 0);
+	ASSERT_EQ(vector.GetSize(), 6);
+}
+
+TEST(VectorRemoveTest, VectorRemoveAtInvalidIndicesThrowsAndKeepsElements)
+{
+	Structs::Vector<std::string> vector = MakeStrings(10);
+	std::vector<size_t> unsorted = { 1, 5, 2 };
+	std::vector<size_t> outOfRange = { 1, 5, 10 };
+
+	ASSERT_THROW(vector.RemoveAtIndices(Structs::Span<const size_t>(unsorted.data(), unsorted.size())), std::invalid_argument);
+	ASSERT_THROW(vector.RemoveAtIndices(Structs::Span<const size_t>(outOfRange.data(), outOfRange.size())), std::out_of_range);
+	ASSERT_EQ(vector.GetSize(), 10);
+	ASSERT_EQ(ToInts(vector)[9], 9);
+}
+
+TEST(VectorRemoveTest, VectorSwapRemoveAtMovesLastElementIntoPlace)
+{
+	Structs::Vector<std::string> vector = MakeStrings(5);
+
+	vector.SwapRemoveAt(1);
+
+	ASSERT_EQ(ToInts(vector), (std::vector<int> { 0, 4, 2, 3 }));
+
+	vector.SwapRemoveAt(3);
+
+	ASSERT_EQ(ToInts(vector), (std::vector<int> { 0, 4, 2 }));
+	ASSERT_THROW(vector.SwapRemoveAt(3), std::out_of_range);
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Benchmarks live in the test target as DISABLED_ tests so that ctest stays fast.
+// Run them with: Tests --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+namespace Benchmarks
+{
+	class Stopwatch
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+	public:
+		Stopwatch()
+			: start(Clock::now())
+		{}
+
+	public:
+		void Restart() { start = Clock::now(); }
+
+		double GetElapsedNanoseconds() const
+		{
+			return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+		}
+
+		double GetElapsedMilliseconds() const
+		{
+			return GetElapsedNanoseconds() / 1e6;
+		}
+
+	private:
+		Clock::time_point start;
+	};
+
+	inline size_t GetResidentSetSize()
+	{
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS counters;
+		GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+		return counters.WorkingSetSize;
+#else
+		long pages = 0;
+		long residentPages = 0;
+		FILE* file = fopen("/proc/self/statm", "r");
+
+		if (file == nullptr)
+		{
+			return 0;
+		}
+
+		if (fscanf(file, "%ld %ld", &pages, &residentPages) != 2)
+		{
+			residentPages = 0;
+		}
+
+		fclose(file);
+		return static_cast<size_t>(residentPages) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+	}
+
+	// The time stamp counter, which ticks at the processor's nominal frequency. Zero where
+	// there is none, so callers can leave out per-cycle figures.
+	inline uint64_t ReadCycleCounter()
+	{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return 0;
+#endif
+	}
+
+	// Kept at namespace scope so that storing to it counts as a use.
+	template<typename T>
+	inline volatile T Sink;
+
+	template<typename T>
+	void DoNotOptimize(T value)
+	{
+		Sink<T> = value;
+	}
+}
@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+#include "Map/ConcurrentUnorderedMap.h"
+#include "Map/UnorderedMap.h"
+#include "BenchmarkUtils.h"
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr int Keys = 1 << 16;
+	constexpr size_t OperationsPerThread = 1 << 18;
+	constexpr int MaxThreads = 64;
+
+	// What the striped map replaces: a single map behind one global lock.
+	class GloballyLockedMap
+	{
+	public:
+		bool Contains(int key)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			return map.Contains(key);
+		}
+
+		void InsertOrAssign(int key, int value)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			map[key] = value;
+		}
+
+	private:
+		std::mutex mutex;
+		Structs::UnorderedMap<int, int> map;
+	};
+
+	// Runs 90% lookups and 10% writes over the key range and returns millions of operations per second.
+	template<typename Map>
+	double RunMix(Map& map, int threadCount)
+	{
+		std::atomic<bool> start(false);
+		std::atomic<size_t> found(0);
+		std::vector<std::thread> threads;
+
+		for (int thread = 0; thread < threadCount; ++thread)
+		{
+			threads.emplace_back([&map, &start, &found, thread]()
+			{
+				std::mt19937 random(thread);
+				size_t hits = 0;
+
+				while (!start.load())
+				{
+					std::this_thread::yield();
+				}
+
+				for (size_t i = 0; i < OperationsPerThread; ++i)
+				{
+					uint32_t draw = random();
+					int key = static_cast<int>(draw % Keys);
+
+					if ((draw >> 16) % 10 == 0)
+					{
+						map.InsertOrAssign(key, static_cast<int>(i));
+					}
+					else
+					{
+						hits += map.Contains(key);
+					}
+				}
+
+				found += hits;
+			});
+		}
+
+		Benchmarks::Stopwatch stopwatch;
+		start = true;
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		double seconds = stopwatch.GetElapsedNanoseconds() / 1e9;
+		Benchmarks::DoNotOptimize(found.load());
+
+		return OperationsPerThread * threadCount / seconds / 1e6;
+	}
+}
+
+TEST(ConcurrentUnorderedMapBenchmark, DISABLED_StripedLocksScaleWithThreads)
+{
+	unsigned cores = std::thread::hardware_concurrency();
+	double global = 0;
+	double striped = 0;
+
+	std::cout << cores << " hardware threads, " << Keys << " keys, 90% reads" << std::endl;
+	std::cout << "threads\tglobal mutex Mops/s\tstriped Mops/s" << std::endl;
+
+	for (int threadCount = 1; threadCount <= MaxThreads; threadCount *= 2)
+	{
+		GloballyLockedMap globalMap;
+		Structs::ConcurrentUnorderedMap<int, int> stripedMap;
+
+		for (int key = 0; key < Keys; key += 2)
+		{
+			globalMap.InsertOrAssign(key, key);
+			stripedMap.InsertOrAssign(key, key);
+		}
+
+		global = RunMix(globalMap, threadCount);
+		striped = RunMix(stripedMap, threadCount);
+
+		std::cout << threadCount << '\t' << global << '\t' << striped << std::endl;
+	}
+
+	// Contention only shows once threads actually run in parallel.
+	if (cores >= 4)
+	{
+		ASSERT_GT(striped, global * 2);
+	}
+}
@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include "HashTable/HashTable.h"
+#include "BenchmarkUtils.h"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Far larger than any last-level cache, so almost every lookup misses.
+	constexpr int64_t Keys = 1 << 24;
+	constexpr size_t Lookups = 1 << 24;
+	constexpr size_t Batch = 256;
+
+	// Where the out-of-order window already overlaps the misses of consecutive lookups, the
+	// prefetching can only keep up with them, so the batch is only required not to fall behind.
+	constexpr double Tolerance = 1.5;
+
+	struct Report
+	{
+		double single;
+		double batched;
+	};
+
+	template<typename Engine>
+	Report RunLookups(const char* name)
+	{
+		Structs::HashTable<int64_t, int64_t, Structs::Keys::NoSelector<int64_t>, std::hash<int64_t>, Engine> table;
+		table.Reserve(Keys);
+
+		for (int64_t i = 0; i < Keys; ++i)
+		{
+			table.Insert(i);
+		}
+
+		std::mt19937_64 random(1);
+		std::vector<int64_t> keys(Lookups);
+
+		for (int64_t& key : keys)
+		{
+			key = static_cast<int64_t>(random() % (2 * Keys));
+		}
+
+		size_t found = 0;
+		Benchmarks::Stopwatch stopwatch;
+
+		for (int64_t key : keys)
+		{
+			found += table.Contains(key);
+		}
+
+		Report report;
+		report.single = stopwatch.GetElapsedNanoseconds() / Lookups;
+
+		bool results[Batch];
+		size_t batchedFound = 0;
+		stopwatch.Restart();
+
+		for (size_t first = 0; first < Lookups; first += Batch)
+		{
+			table.ContainsMany(keys.data() + first, Batch, results);
+
+			for (bool result : results)
+			{
+				batchedFound += result;
+			}
+		}
+
+		report.batched = stopwatch.GetElapsedNanoseconds() / Lookups;
+		EXPECT_EQ(found, batchedFound);
+
+		std::cout << name << ": Contains " << report.single << " ns/key, ContainsMany(" << Batch << ") "
+			<< report.batched << " ns/key" << std::endl;
+
+		return report;
+	}
+}
+
+TEST(HashTableBatchLookupBenchmark, DISABLED_ChainedEngineContainsManyOverlapsCacheMisses)
+{
+	Report report = RunLookups<Structs::Engines::Chained<>>("Chained");
+	ASSERT_LT(report.batched, report.single * Tolerance);
+}
+
+TEST(HashTableBatchLookupBenchmark, DISABLED_SwissEngineContainsManyOverlapsCacheMisses)
+{
+	Report report = RunLookups<Structs::Engines::Swiss>("Swiss");
+	ASSERT_LT(report.batched, report.single * Tolerance);
+}
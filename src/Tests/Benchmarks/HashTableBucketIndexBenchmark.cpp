@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+#include "HashTable/HashTable.h"
+#include "BenchmarkUtils.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Keys = 1 << 20;
+	constexpr int64_t Stride = 64;
+
+	// What a bare mask over a power-of-two capacity would do, to show why the mix is needed.
+	struct IdentityMask
+	{
+	public:
+		static size_t GetInitialCapacity() { return 8; }
+		static size_t GetNextCapacity(size_t capacity) { return capacity * 2; }
+		static size_t GetIndex(size_t hash, size_t capacity) { return hash & (capacity - 1); }
+	};
+
+	enum class Pattern
+	{
+		Sequential,
+		Strided,
+		Random
+	};
+
+	const char* GetName(Pattern pattern)
+	{
+		switch (pattern)
+		{
+		case Pattern::Sequential: return "sequential";
+		case Pattern::Strided: return "strided";
+		default: return "random";
+		}
+	}
+
+	std::vector<int64_t> MakeKeys(Pattern pattern, size_t count, uint64_t seed)
+	{
+		std::vector<int64_t> keys(count);
+		std::mt19937_64 random(seed);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			switch (pattern)
+			{
+			case Pattern::Sequential: keys[i] = static_cast<int64_t>(i); break;
+			case Pattern::Strided: keys[i] = static_cast<int64_t>(i) * Stride; break;
+			case Pattern::Random: keys[i] = static_cast<int64_t>(random() >> 1); break;
+			}
+		}
+
+		return keys;
+	}
+
+	struct Report
+	{
+		double insert;
+		double hit;
+		double miss;
+	};
+
+	template<typename BucketIndex>
+	Report Run(const char* name, Pattern pattern)
+	{
+		using Table = Structs::HashTable<int64_t, int64_t, Structs::Keys::NoSelector<int64_t>, std::hash<int64_t>, Structs::Engines::Chained<BucketIndex>>;
+		Table table;
+
+		std::vector<int64_t> keys = MakeKeys(pattern, Keys, 1);
+		std::vector<int64_t> missing = MakeKeys(pattern, 2 * Keys, 2);
+		missing.erase(missing.begin(), missing.begin() + Keys);
+
+		if (pattern == Pattern::Random)
+		{
+			for (int64_t& key : missing)
+			{
+				key |= 1;
+				key = -key;
+			}
+		}
+
+		Benchmarks::Stopwatch stopwatch;
+
+		for (int64_t key : keys)
+		{
+			table.Insert(key);
+		}
+
+		Report report;
+		report.insert = stopwatch.GetElapsedNanoseconds() / Keys;
+
+		std::shuffle(keys.begin(), keys.end(), std::mt19937_64(3));
+		size_t found = 0;
+		stopwatch.Restart();
+
+		for (int64_t key : keys)
+		{
+			found += table.Contains(key);
+		}
+
+		report.hit = stopwatch.GetElapsedNanoseconds() / Keys;
+		stopwatch.Restart();
+
+		for (int64_t key : missing)
+		{
+			found += table.Contains(key);
+		}
+
+		report.miss = stopwatch.GetElapsedNanoseconds() / Keys;
+		Benchmarks::DoNotOptimize(found);
+
+		std::cout << name << '\t' << GetName(pattern) << '\t' << report.insert << '\t' << report.hit << '\t' << report.miss << std::endl;
+		return report;
+	}
+
+	template<typename BucketIndex>
+	void RunPatterns(const char* name, Report* reports)
+	{
+		reports[0] = Run<BucketIndex>(name, Pattern::Sequential);
+		reports[1] = Run<BucketIndex>(name, Pattern::Strided);
+		reports[2] = Run<BucketIndex>(name, Pattern::Random);
+	}
+}
+
+TEST(HashTableBucketIndexBenchmark, DISABLED_FibonacciBucketIndexKeepsStridedKeysAsFastAsSequential)
+{
+	Report fibonacci[3];
+	Report prime[3];
+	Report identity[3];
+
+	std::cout << Keys << " int64 keys, strided keys are " << Stride << " apart" << std::endl;
+	std::cout << "policy\tkeys\tinsert ns/op\thit ns/op\tmiss ns/op" << std::endl;
+
+	RunPatterns<Structs::Buckets::Fibonacci>("Fibonacci", fibonacci);
+	RunPatterns<Structs::Buckets::PrimeModulo>("PrimeModulo", prime);
+	RunPatterns<IdentityMask>("IdentityMask", identity);
+
+	ASSERT_LT(fibonacci[1].hit, fibonacci[0].hit * 2);
+	ASSERT_LT(fibonacci[1].hit * 10, identity[1].hit);
+}
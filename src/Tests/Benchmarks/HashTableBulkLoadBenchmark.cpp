@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include "HashTable/HashTable.h"
+#include "BenchmarkUtils.h"
+#include <cstdint>
+#include <iostream>
+
+namespace
+{
+	constexpr int64_t Keys = 10'000'000;
+
+	struct Report
+	{
+		double milliseconds;
+		size_t rehashes;
+	};
+
+	template<typename Engine>
+	Report RunBulkLoad(const char* name, bool reserve)
+	{
+		Structs::HashTable<int64_t, int64_t, Structs::Keys::NoSelector<int64_t>, std::hash<int64_t>, Engine> table;
+		Benchmarks::Stopwatch stopwatch;
+
+		if (reserve)
+		{
+			table.Reserve(Keys);
+		}
+
+		size_t capacity = table.GetCapacity();
+		size_t rehashes = 0;
+
+		for (int64_t i = 0; i < Keys; ++i)
+		{
+			table.Insert(i);
+
+			if (table.GetCapacity() != capacity)
+			{
+				capacity = table.GetCapacity();
+				++rehashes;
+			}
+		}
+
+		Report report{ stopwatch.GetElapsedMilliseconds(), rehashes };
+		std::cout << name << (reserve ? " with Reserve" : "") << ": " << report.milliseconds << " ms, "
+			<< report.rehashes << " rehashes, capacity " << capacity << std::endl;
+
+		return report;
+	}
+
+	template<typename Engine>
+	void RunEngine(const char* name)
+	{
+		Report grown = RunBulkLoad<Engine>(name, false);
+		Report reserved = RunBulkLoad<Engine>(name, true);
+
+		ASSERT_EQ(reserved.rehashes, 0);
+		ASSERT_LT(reserved.milliseconds, grown.milliseconds * 1.1);
+	}
+}
+
+TEST(HashTableBulkLoadBenchmark, DISABLED_ChainedEngineReserveAvoidsRehashes)
+{
+	RunEngine<Structs::Engines::Chained<>>("Chained");
+}
+
+TEST(HashTableBulkLoadBenchmark, DISABLED_SwissEngineReserveAvoidsRehashes)
+{
+	RunEngine<Structs::Engines::Swiss>("Swiss");
+}
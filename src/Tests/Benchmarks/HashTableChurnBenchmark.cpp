@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "HashTable/HashTable.h"
+#include "BenchmarkUtils.h"
+#include <cstdint>
+#include <iostream>
+
+namespace
+{
+	struct CountedKey
+	{
+		int64_t value;
+
+		static size_t comparisons;
+
+		bool operator==(const CountedKey& rhs) const
+		{
+			++comparisons;
+			return value == rhs.value;
+		}
+
+		bool operator!=(const CountedKey& rhs) const
+		{
+			return !(*this == rhs);
+		}
+	};
+
+	size_t CountedKey::comparisons = 0;
+
+	struct CountedKeyHasher
+	{
+		size_t operator()(const CountedKey& key) const
+		{
+			return std::hash<int64_t>()(key.value);
+		}
+	};
+
+	constexpr int64_t LiveKeys = 1 << 20;
+	constexpr int64_t Cycles = 100'000'000;
+	constexpr int64_t Window = 10'000'000;
+
+	template<typename Engine>
+	void RunChurn(const char* name)
+	{
+		using Table = Structs::HashTable<CountedKey, CountedKey, Structs::Keys::NoSelector<CountedKey>, CountedKeyHasher, Engine>;
+		Table table;
+
+		for (int64_t i = 0; i < LiveKeys; ++i)
+		{
+			table.Insert(CountedKey{ i });
+		}
+
+		std::cout << name << ": " << LiveKeys << " live keys, " << Cycles << " remove/insert cycles" << std::endl;
+		std::cout << "cycles\tcompares/op\tns/op\tcapacity\tRSS MiB" << std::endl;
+
+		double firstCompares = 0;
+		size_t firstCapacity = 0;
+		size_t firstRss = 0;
+
+		for (int64_t windowStart = 0; windowStart < Cycles; windowStart += Window)
+		{
+			CountedKey::comparisons = 0;
+			Benchmarks::Stopwatch stopwatch;
+
+			for (int64_t cycle = windowStart; cycle < windowStart + Window; ++cycle)
+			{
+				bool removed = table.TryRemove(CountedKey{ cycle });
+				bool inserted = table.TryInsert(CountedKey{ cycle + LiveKeys });
+				Benchmarks::DoNotOptimize(removed && inserted);
+			}
+
+			double nanoseconds = stopwatch.GetElapsedNanoseconds() / (2.0 * Window);
+			double compares = static_cast<double>(CountedKey::comparisons) / (2.0 * Window);
+			size_t rss = Benchmarks::GetResidentSetSize();
+
+			std::cout << windowStart + Window << '\t' << compares << '\t' << nanoseconds << '\t'
+				<< table.GetCapacity() << '\t' << rss / (1024 * 1024) << std::endl;
+
+			if (windowStart == 0)
+			{
+				firstCompares = compares;
+				firstCapacity = table.GetCapacity();
+				firstRss = rss;
+				continue;
+			}
+
+			ASSERT_EQ(table.GetSize(), static_cast<size_t>(LiveKeys));
+			ASSERT_LE(compares, firstCompares * 1.25);
+			ASSERT_EQ(table.GetCapacity(), firstCapacity);
+			ASSERT_LE(rss, firstRss + firstRss / 10);
+		}
+	}
+}
+
+TEST(HashTableChurnBenchmark, DISABLED_ChainedEngineChurnKeepsProbeLengthAndMemoryFlat)
+{
+	RunChurn<Structs::Engines::Chained<>>("Chained");
+}
+
+TEST(HashTableChurnBenchmark, DISABLED_SwissEngineChurnKeepsProbeLengthAndMemoryFlat)
+{
+	RunChurn<Structs::Engines::Swiss>("Swiss");
+}
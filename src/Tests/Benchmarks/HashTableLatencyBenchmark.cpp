@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "HashTable/HashTable.h"
+#include "BenchmarkUtils.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	constexpr int Inserts = 1 << 22;
+	constexpr size_t HistogramBins = 32;
+
+	struct LatencyReport
+	{
+		double p50;
+		double p999;
+		double max;
+	};
+
+	template<typename Engine>
+	LatencyReport RunInsertLatency(const char* name)
+	{
+		Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, std::hash<int>, Engine> table;
+		std::vector<double> latencies(Inserts);
+		size_t histogram[HistogramBins] = {};
+
+		for (int i = 0; i < Inserts; ++i)
+		{
+			Benchmarks::Stopwatch stopwatch;
+			table.Insert(i);
+			latencies[i] = stopwatch.GetElapsedNanoseconds();
+
+			size_t bin = 0;
+
+			for (double bound = 32; bound < latencies[i] && bin + 1 < HistogramBins; bound *= 2)
+			{
+				++bin;
+			}
+
+			++histogram[bin];
+		}
+
+		std::cout << name << ": " << Inserts << " inserts" << std::endl;
+		std::cout << "latency <=\tcount" << std::endl;
+
+		double bound = 32;
+
+		for (size_t bin = 0; bin < HistogramBins; ++bin, bound *= 2)
+		{
+			if (histogram[bin] != 0)
+			{
+				std::cout << bound << " ns\t" << histogram[bin] << std::endl;
+			}
+		}
+
+		std::sort(latencies.begin(), latencies.end());
+
+		LatencyReport report{ latencies[Inserts / 2], latencies[Inserts - Inserts / 1000], latencies.back() };
+		std::cout << "p50 " << report.p50 << " ns, p99.9 " << report.p999 << " ns, max " << report.max << " ns" << std::endl;
+
+		return report;
+	}
+}
+
+TEST(HashTableLatencyBenchmark, DISABLED_IncrementalChainedEngineBoundsWorstCaseInsert)
+{
+	LatencyReport immediate = RunInsertLatency<Structs::Engines::Chained<>>("Chained");
+	LatencyReport incremental = RunInsertLatency<Structs::Engines::IncrementalChained<>>("IncrementalChained<4>");
+
+	ASSERT_LT(incremental.max * 10, immediate.max);
+}
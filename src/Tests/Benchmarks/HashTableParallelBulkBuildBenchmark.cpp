@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+#include "HashTable/HashTable.h"
+#include "BenchmarkUtils.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Keys = 1 << 24;
+
+	using Table = Structs::HashTable<uint64_t, uint64_t, Structs::Keys::NoSelector<uint64_t>, std::hash<uint64_t>, Structs::Engines::Chained<>>;
+
+	// One key in sixteen repeats an earlier one, as in a rebuild from a log with updates.
+	std::vector<uint64_t> MakeKeys()
+	{
+		std::mt19937_64 random(1);
+		std::vector<uint64_t> keys(Keys);
+
+		for (size_t i = 0; i < Keys; ++i)
+		{
+			keys[i] = i % 16 == 15 ? keys[random() % i] : random();
+		}
+
+		return keys;
+	}
+
+	double MeasureSerial(const std::vector<uint64_t>& keys, size_t& size)
+	{
+		Table table;
+		Benchmarks::Stopwatch stopwatch;
+		table.Reserve(keys.size());
+
+		for (uint64_t key : keys)
+		{
+			table.TryInsert(key);
+		}
+
+		double milliseconds = stopwatch.GetElapsedMilliseconds();
+		size = table.GetSize();
+
+		return milliseconds;
+	}
+
+	double MeasureBulkBuild(const std::vector<uint64_t>& keys, size_t threads, size_t& size)
+	{
+		Table table;
+		Benchmarks::Stopwatch stopwatch;
+		std::vector<size_t> duplicates = table.BulkBuild(keys.begin(), keys.end(), threads);
+
+		double milliseconds = stopwatch.GetElapsedMilliseconds();
+		size = table.GetSize();
+		Benchmarks::DoNotOptimize(duplicates.size());
+
+		return milliseconds;
+	}
+}
+
+TEST(HashTableParallelBulkBuildBenchmark, DISABLED_BulkBuildScalesWithThreads)
+{
+	std::vector<uint64_t> keys = MakeKeys();
+	size_t cores = std::max(1u, std::thread::hardware_concurrency());
+
+	std::cout << cores << " hardware threads, " << Keys << " keys" << std::endl;
+	std::cout << "build\tms\tspeedup" << std::endl;
+
+	size_t serialSize = 0;
+	double serial = MeasureSerial(keys, serialSize);
+	double fastest = serial;
+
+	std::cout << "TryInsert\t" << serial << "\t1" << std::endl;
+
+	for (size_t threads = 1; threads <= cores; threads *= 2)
+	{
+		size_t size = 0;
+		double milliseconds = MeasureBulkBuild(keys, threads, size);
+		fastest = std::min(fastest, milliseconds);
+
+		std::cout << "BulkBuild x" << threads << '\t' << milliseconds << '\t' << serial / milliseconds << std::endl;
+		ASSERT_EQ(size, serialSize);
+	}
+
+	// Partitioning costs a pass over the keys that only pays off once threads run in parallel.
+	if (cores >= 4)
+	{
+		ASSERT_LT(fastest, serial / 2);
+	}
+}
@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+#include "HashTable/HashTable.h"
+#include "BenchmarkUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Capacity = 1 << 20;
+	constexpr float LoadFactor = 0.9f;
+
+	struct Probes
+	{
+		double mean;
+		double deviation;
+		size_t max;
+	};
+
+	struct Report
+	{
+		Probes hit;
+		Probes miss;
+		double hitNanoseconds;
+		double missNanoseconds;
+		size_t capacity;
+	};
+
+	auto EqualTo(int64_t key)
+	{
+		return [key](int64_t value) { return value == key; };
+	}
+
+	template<typename Storage>
+	Probes MeasureProbes(const Storage& storage, const std::vector<int64_t>& keys)
+	{
+		double total = 0;
+		double squares = 0;
+		size_t max = 0;
+
+		for (int64_t key : keys)
+		{
+			size_t length = storage.GetProbeLength(std::hash<int64_t>()(key), EqualTo(key));
+			total += length;
+			squares += static_cast<double>(length) * length;
+			max = std::max(max, length);
+		}
+
+		double mean = total / keys.size();
+		return { mean, std::sqrt(squares / keys.size() - mean * mean), max };
+	}
+
+	template<typename Storage>
+	double MeasureLookups(const Storage& storage, const std::vector<int64_t>& keys)
+	{
+		size_t found = 0;
+		Benchmarks::Stopwatch stopwatch;
+
+		for (int64_t key : keys)
+		{
+			found += storage.Find(std::hash<int64_t>()(key), EqualTo(key)) != nullptr;
+		}
+
+		double nanoseconds = stopwatch.GetElapsedNanoseconds() / keys.size();
+		Benchmarks::DoNotOptimize(found);
+
+		return nanoseconds;
+	}
+
+	template<typename Storage>
+	Report RunProbes(const char* name, float loadFactor = LoadFactor)
+	{
+		Storage storage;
+		storage.SetMaxLoadFactor(loadFactor);
+		storage.Rehash(Capacity);
+
+		size_t count = static_cast<size_t>(Capacity * loadFactor);
+
+		std::mt19937_64 random(1);
+		std::vector<int64_t> keys(count);
+		std::vector<int64_t> missing(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			keys[i] = static_cast<int64_t>(random() >> 1);
+			missing[i] = -keys[i] - 1;
+		}
+
+		for (int64_t key : keys)
+		{
+			storage.FindOrInsert(std::hash<int64_t>()(key), EqualTo(key), [key]() { return key; });
+		}
+
+		Report report;
+		report.hit = MeasureProbes(storage, keys);
+		report.miss = MeasureProbes(storage, missing);
+		report.hitNanoseconds = MeasureLookups(storage, keys);
+		report.missNanoseconds = MeasureLookups(storage, missing);
+		report.capacity = storage.GetCapacity();
+
+		std::cout << name << '\t' << storage.GetSize() << '/' << storage.GetCapacity() << '\t'
+			<< report.hit.mean << '\t' << report.hit.deviation << '\t' << report.hit.max << '\t'
+			<< report.miss.mean << '\t' << report.miss.deviation << '\t' << report.miss.max << '\t'
+			<< report.hitNanoseconds << '\t' << report.missNanoseconds << std::endl;
+
+		return report;
+	}
+}
+
+TEST(HashTableProbeLengthBenchmark, DISABLED_RobinHoodEngineKeepsProbesShortAtHighLoad)
+{
+	std::cout << "engine\tsize/capacity\thit mean\thit stddev\thit max\tmiss mean\tmiss stddev\tmiss max\thit ns/op\tmiss ns/op" << std::endl;
+
+	Report chained = RunProbes<Structs::ChainedStorage<int64_t>>("Chained");
+	Report robinHood = RunProbes<Structs::RobinHoodStorage<int64_t>>("RobinHood");
+
+	// Plain linear probing at this load averages about 50 probes per miss; the early exit
+	// keeps misses as short as hits, and displacing richer elements keeps the longest probe
+	// within a small multiple of the longest chain.
+	ASSERT_LT(robinHood.miss.mean, robinHood.hit.mean * 2);
+	ASSERT_LT(robinHood.hit.max, chained.hit.max * 8);
+}
+
+TEST(HashTableProbeLengthBenchmark, DISABLED_CuckooEngineReadsTwoBucketsAtNinetyFivePercentLoad)
+{
+	constexpr float HighLoadFactor = 0.95f;
+
+	std::cout << "Cuckoo probes count buckets of " << Structs::Control::BucketWidth << " slots, the others single slots" << std::endl;
+	std::cout << "engine\tsize/capacity\thit mean\thit stddev\thit max\tmiss mean\tmiss stddev\tmiss max\thit ns/op\tmiss ns/op" << std::endl;
+
+	RunProbes<Structs::RobinHoodStorage<int64_t>>("RobinHood", HighLoadFactor);
+	Report cuckoo = RunProbes<Structs::CuckooStorage<int64_t>>("Cuckoo", HighLoadFactor);
+
+	// Filling to the load factor must not double the table, and no lookup may read more than
+	// its two buckets and the stash.
+	ASSERT_EQ(cuckoo.capacity, Capacity);
+	ASSERT_LE(cuckoo.hit.max, 3);
+	ASSERT_LE(cuckoo.miss.max, 3);
+}
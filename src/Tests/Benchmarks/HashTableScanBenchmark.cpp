@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include "Map/UnorderedMap.h"
+#include "BenchmarkUtils.h"
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	constexpr int64_t Entries = 10'000'000;
+	constexpr int Passes = 10;
+
+	template<typename Container>
+	double MeasureScan(const char* name, const Container& container)
+	{
+		int64_t sum = 0;
+		Benchmarks::Stopwatch stopwatch;
+
+		for (int pass = 0; pass < Passes; ++pass)
+		{
+			for (const auto& pair : container)
+			{
+				sum += pair.second;
+			}
+		}
+
+		double nanoseconds = stopwatch.GetElapsedNanoseconds();
+		Benchmarks::DoNotOptimize(sum);
+
+		double bytes = static_cast<double>(Entries) * Passes * sizeof(std::pair<int64_t, int64_t>);
+		double bandwidth = bytes / nanoseconds;
+		std::cout << name << ": " << nanoseconds / (Entries * Passes) << " ns/entry, " << bandwidth << " GB/s" << std::endl;
+
+		return bandwidth;
+	}
+}
+
+TEST(HashTableScanBenchmark, DISABLED_UnorderedMapScanRunsAtArrayBandwidth)
+{
+	std::vector<std::pair<int64_t, int64_t>> array;
+	Structs::UnorderedMap<int64_t, int64_t> map;
+
+	array.reserve(Entries);
+	map.Reserve(Entries);
+
+	for (int64_t i = 0; i < Entries; ++i)
+	{
+		array.emplace_back(i, i);
+		map.Insert(i, i);
+	}
+
+	for (int64_t i = 0; i < Entries; i += 4)
+	{
+		map.Remove(i);
+		map.Insert(i + Entries, i);
+	}
+
+	double arrayBandwidth = MeasureScan("std::vector", array);
+	double mapBandwidth = MeasureScan("UnorderedMap", map);
+
+	ASSERT_GT(mapBandwidth * 2, arrayBandwidth);
+}
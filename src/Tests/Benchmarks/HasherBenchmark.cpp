@@ -0,0 +1,145 @@
+#include "gtest/gtest.h"
+#include "HashTable/HashTable.h"
+#include "BenchmarkUtils.h"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	constexpr size_t BytesPerRun = 1 << 26;
+	constexpr size_t Keys = 20000;
+
+	struct Throughput
+	{
+		double bytesPerNanosecond;
+		double bytesPerCycle;
+	};
+
+	template<typename Hash>
+	Throughput MeasureThroughput(const std::string& text, size_t length)
+	{
+		Hash hash;
+		size_t runs = BytesPerRun / length;
+		size_t sink = 0;
+
+		Benchmarks::Stopwatch stopwatch;
+		uint64_t startCycles = Benchmarks::ReadCycleCounter();
+
+		// Every run starts one byte further, so no two runs hash the same bytes.
+		for (size_t i = 0; i < runs; ++i)
+		{
+			sink += hash(std::string_view(text.data() + (i & 63), length));
+		}
+
+		uint64_t cycles = Benchmarks::ReadCycleCounter() - startCycles;
+		double nanoseconds = stopwatch.GetElapsedNanoseconds();
+		Benchmarks::DoNotOptimize(sink);
+
+		double bytes = static_cast<double>(runs) * length;
+		return { bytes / nanoseconds, cycles == 0 ? 0 : bytes / cycles };
+	}
+
+	// The longest chain and the mean probe length over all keys of a chained table.
+	template<typename Key, typename Hash, typename BucketIndex>
+	Structs::HashTableStats MeasureChains(const std::vector<Key>& keys)
+	{
+		Structs::HashTable<Key, Key, Structs::Keys::NoSelector<Key>, Hash, Structs::Engines::Instrumented<Structs::Engines::Chained<BucketIndex>>> table;
+
+		for (const Key& key : keys)
+		{
+			table.Insert(key);
+		}
+
+		return table.GetStats();
+	}
+
+	template<typename Key, typename BucketIndex = Structs::Buckets::Fibonacci>
+	size_t ReportChains(const char* name, const std::vector<Key>& keys)
+	{
+		Structs::HashTableStats standard = MeasureChains<Key, std::hash<Key>, BucketIndex>(keys);
+		Structs::HashTableStats wy = MeasureChains<Key, Structs::Hashers::WyHash<Key>, BucketIndex>(keys);
+		Structs::HashTableStats sip = MeasureChains<Key, Structs::Hashers::SipHash<Key>, BucketIndex>(keys);
+
+		std::cout << name
+			<< '\t' << standard.GetMeanProbeLength() << '/' << standard.maxProbeLength
+			<< '\t' << wy.GetMeanProbeLength() << '/' << wy.maxProbeLength
+			<< '\t' << sip.GetMeanProbeLength() << '/' << sip.maxProbeLength << std::endl;
+
+		EXPECT_LE(wy.maxProbeLength, 12) << name;
+		EXPECT_LE(sip.maxProbeLength, 12) << name;
+
+		return standard.maxProbeLength;
+	}
+}
+
+TEST(HasherBenchmark, DISABLED_HasherThroughputByKeyLength)
+{
+	std::mt19937_64 random(1);
+	std::string text(16384 + 64, '\0');
+
+	for (char& c : text)
+	{
+		c = static_cast<char>(random());
+	}
+
+	std::cout << "bytes\tstd::hash B/ns\tB/cycle\tWyHash B/ns\tB/cycle\tSipHash B/ns\tB/cycle" << std::endl;
+
+	for (size_t length : { 8, 16, 64, 256, 1024, 16384 })
+	{
+		Throughput standard = MeasureThroughput<std::hash<std::string_view>>(text, length);
+		Throughput wy = MeasureThroughput<Structs::Hashers::WyHash<std::string_view>>(text, length);
+		Throughput sip = MeasureThroughput<Structs::Hashers::SipHash<std::string_view>>(text, length);
+
+		std::cout << length
+			<< '\t' << standard.bytesPerNanosecond << '\t' << standard.bytesPerCycle
+			<< '\t' << wy.bytesPerNanosecond << '\t' << wy.bytesPerCycle
+			<< '\t' << sip.bytesPerNanosecond << '\t' << sip.bytesPerCycle << std::endl;
+
+		if (length >= 64)
+		{
+			ASSERT_GT(wy.bytesPerNanosecond, sip.bytesPerNanosecond);
+		}
+	}
+}
+
+TEST(HasherBenchmark, DISABLED_HasherChainLengthsAgainstStdHash)
+{
+	std::mt19937_64 random(1);
+	std::vector<uint64_t> sequential(Keys);
+	std::vector<uint64_t> strided(Keys);
+	std::vector<uint64_t> flood(Keys);
+	std::vector<std::string> numbered(Keys);
+	std::vector<std::string> randomText(Keys);
+
+	// Multiples of the prime a table of this many keys ends up with collide in bucket zero
+	// when the hash is the identity.
+	Structs::ChainedStorage<uint64_t, Structs::Buckets::PrimeModulo> sized;
+	sized.Reserve(Keys);
+	uint64_t prime = sized.GetCapacity();
+
+	for (size_t i = 0; i < Keys; ++i)
+	{
+		sequential[i] = i;
+		strided[i] = static_cast<uint64_t>(i) << 32;
+		flood[i] = static_cast<uint64_t>(i) * prime;
+		numbered[i] = "user:" + std::to_string(i);
+		randomText[i] = std::to_string(random());
+	}
+
+	std::cout << Keys << " keys, mean/max probe length of a chained table" << std::endl;
+	std::cout << "keys\tstd::hash\tWyHash\tSipHash" << std::endl;
+
+	ReportChains("sequential", sequential);
+	ReportChains("strided 2^32", strided);
+	ReportChains<uint64_t, Structs::Buckets::PrimeModulo>("prime multiples, modulo buckets", flood);
+	ReportChains<uint64_t, Structs::Buckets::PrimeModulo>("sequential, modulo buckets", sequential);
+	ReportChains("numbered strings", numbered);
+	ReportChains("random strings", randomText);
+
+	size_t flooded = MeasureChains<uint64_t, std::hash<uint64_t>, Structs::Buckets::PrimeModulo>(flood).maxProbeLength;
+	ASSERT_GT(flooded, Keys / 2);
+}
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+#include "Map/ConcurrentUnorderedMap.h"
+#include "Map/ReadMostlyUnorderedMap.h"
+#include "BenchmarkUtils.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr int Keys = 1 << 14;
+	constexpr size_t LookupsPerThread = 1 << 20;
+	constexpr int MaxThreads = 64;
+	constexpr auto RebuildInterval = std::chrono::milliseconds(20);
+
+	template<typename Map>
+	void Rebuild(Map& map, int version)
+	{
+		for (int key = 0; key < Keys; key += 64)
+		{
+			map.InsertOrAssign(key, version);
+		}
+	}
+
+	void Rebuild(Structs::ReadMostlyUnorderedMap<int, int>& map, int version)
+	{
+		map.Update([version](auto& table)
+		{
+			for (int key = 0; key < Keys; key += 64)
+			{
+				table.Find(key)->second = version;
+			}
+		});
+	}
+
+	// Readers look up random keys while one writer rebuilds part of the map at a fixed interval.
+	// Returns millions of lookups per second over all readers.
+	template<typename Map>
+	double RunReaders(Map& map, int readerCount)
+	{
+		std::atomic<bool> start(false);
+		std::atomic<int> running(readerCount);
+		std::atomic<size_t> found(0);
+		std::vector<std::thread> readers;
+
+		for (int reader = 0; reader < readerCount; ++reader)
+		{
+			readers.emplace_back([&map, &start, &running, &found, reader]()
+			{
+				std::mt19937 random(reader);
+				size_t hits = 0;
+
+				while (!start.load())
+				{
+					std::this_thread::yield();
+				}
+
+				for (size_t i = 0; i < LookupsPerThread; ++i)
+				{
+					hits += map.Contains(static_cast<int>(random() % Keys));
+				}
+
+				found += hits;
+				--running;
+			});
+		}
+
+		Benchmarks::Stopwatch stopwatch;
+		start = true;
+
+		for (int version = 1; running.load() != 0; ++version)
+		{
+			Rebuild(map, version);
+			std::this_thread::sleep_for(RebuildInterval);
+		}
+
+		for (std::thread& reader : readers)
+		{
+			reader.join();
+		}
+
+		double seconds = stopwatch.GetElapsedNanoseconds() / 1e9;
+		Benchmarks::DoNotOptimize(found.load());
+
+		return LookupsPerThread * readerCount / seconds / 1e6;
+	}
+}
+
+TEST(ReadMostlyUnorderedMapBenchmark, DISABLED_EpochProtectedReadersScaleWithThreads)
+{
+	unsigned cores = std::thread::hardware_concurrency();
+	double locked = 0;
+	double epoch = 0;
+
+	std::cout << cores << " hardware threads, " << Keys << " keys, rebuilt every " << RebuildInterval.count() << " ms" << std::endl;
+	std::cout << "readers\tstriped shared_mutex Mops/s\tepoch Mops/s" << std::endl;
+
+	for (int readerCount = 1; readerCount <= MaxThreads; readerCount *= 2)
+	{
+		Structs::ConcurrentUnorderedMap<int, int> lockedMap;
+		Structs::ReadMostlyUnorderedMap<int, int> epochMap;
+
+		epochMap.Update([](auto& table)
+		{
+			for (int key = 0; key < Keys; ++key)
+			{
+				table.Insert({ key, 0 });
+			}
+		});
+
+		for (int key = 0; key < Keys; ++key)
+		{
+			lockedMap.Insert(key, 0);
+		}
+
+		locked = RunReaders(lockedMap, readerCount);
+		epoch = RunReaders(epochMap, readerCount);
+
+		std::cout << readerCount << '\t' << locked << '\t' << epoch << std::endl;
+	}
+
+	// Cache lines only bounce between cores when readers actually run in parallel.
+	if (cores >= 4)
+	{
+		ASSERT_GT(epoch, locked);
+	}
+}
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+#include "Map/UnorderedMap.h"
+#include "Map/UnorderedMultiMap.h"
+#include "BenchmarkUtils.h"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Terms = 1 << 17;
+	constexpr size_t Postings = 1 << 23;
+	constexpr size_t Scans = 1 << 18;
+
+	struct Report
+	{
+		double buildMilliseconds;
+		double scanMilliseconds;
+		double bytesPerPosting;
+	};
+
+	// Most terms are rare and a few are common, as in text.
+	std::vector<int> MakeTerms()
+	{
+		std::mt19937 random(1);
+		std::vector<int> terms(Postings);
+
+		for (int& term : terms)
+		{
+			term = static_cast<int>((static_cast<uint64_t>(random() % Terms) * (random() % Terms)) / Terms);
+		}
+
+		return terms;
+	}
+
+	template<typename Build, typename Scan, typename Bytes>
+	Report Measure(const char* name, Build build, Scan scan, Bytes bytes)
+	{
+		Benchmarks::Stopwatch stopwatch;
+		build();
+		double buildMilliseconds = stopwatch.GetElapsedMilliseconds();
+
+		std::mt19937 random(2);
+		int64_t sum = 0;
+		stopwatch.Restart();
+
+		for (size_t i = 0; i < Scans; ++i)
+		{
+			sum += scan(static_cast<int>(random() % Terms));
+		}
+
+		Report report{ buildMilliseconds, stopwatch.GetElapsedMilliseconds(), static_cast<double>(bytes()) / Postings };
+		Benchmarks::DoNotOptimize(sum);
+
+		std::cout << name << '\t' << report.buildMilliseconds << '\t' << report.scanMilliseconds << '\t' << report.bytesPerPosting << std::endl;
+		return report;
+	}
+}
+
+TEST(UnorderedMultiMapBenchmark, DISABLED_InvertedIndexWithoutVectorPerTerm)
+{
+	std::vector<int> terms = MakeTerms();
+
+	std::cout << Terms << " terms, " << Postings << " postings, " << Scans << " posting list scans" << std::endl;
+	std::cout << "index\tbuild ms\tscan ms\tbytes/posting" << std::endl;
+
+	Structs::UnorderedMap<int, std::vector<int>> vectors;
+	Report vectorReport = Measure("UnorderedMap<vector>", [&]()
+	{
+		for (size_t i = 0; i < terms.size(); ++i)
+		{
+			vectors[terms[i]].push_back(static_cast<int>(i));
+		}
+	}, [&](int term)
+	{
+		int64_t sum = 0;
+		std::vector<int>* postings = vectors.Find(term);
+
+		if (postings != nullptr)
+		{
+			for (int posting : *postings)
+			{
+				sum += posting;
+			}
+		}
+
+		return sum;
+	}, [&]()
+	{
+		// Leaves out the allocator's own header of every vector, so it undercounts.
+		size_t bytes = 0;
+
+		for (auto& pair : vectors)
+		{
+			bytes += sizeof(pair) + pair.second.capacity() * sizeof(int);
+		}
+
+		return bytes;
+	});
+
+	Structs::UnorderedMultiMap<int, int> multiMap;
+	Report multiMapReport = Measure("UnorderedMultiMap", [&]()
+	{
+		for (size_t i = 0; i < terms.size(); ++i)
+		{
+			multiMap.Insert(terms[i], static_cast<int>(i));
+		}
+
+		multiMap.ShrinkToFit();
+	}, [&](int term)
+	{
+		int64_t sum = 0;
+
+		for (int posting : multiMap.EqualRange(term))
+		{
+			sum += posting;
+		}
+
+		return sum;
+	}, [&]()
+	{
+		return multiMap.GetAllocatedBytes();
+	});
+
+	// The multimap makes a few dozen allocations where the vectors make one per growth of
+	// every term, and it packs tighter than the undercounted vectors even with its table.
+	ASSERT_LT(multiMapReport.buildMilliseconds, vectorReport.buildMilliseconds * 1.25);
+	ASSERT_LT(multiMapReport.bytesPerPosting, vectorReport.bytesPerPosting);
+}
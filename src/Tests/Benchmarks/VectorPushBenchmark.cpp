@@ -0,0 +1,145 @@
+#include "gtest/gtest.h"
+#include "Array/SmallVector.h"
+#include "Array/Stack.h"
+#include "Array/Vector.h"
+#include "BenchmarkUtils.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Pushes = 1 << 23;
+	constexpr int Runs = 3;
+
+	// The best of a few runs, as the allocator's state after the previous run adds noise.
+	template<typename Push>
+	double MeasureMillionPushesPerSecond(const char* name, Push push, size_t pushes = Pushes)
+	{
+		double throughput = 0;
+
+		for (int run = 0; run < Runs; ++run)
+		{
+			Benchmarks::Stopwatch stopwatch;
+			push();
+			throughput = std::max(throughput, pushes / (stopwatch.GetElapsedNanoseconds() / 1e3));
+		}
+
+		std::cout << name << '\t' << throughput << std::endl;
+		return throughput;
+	}
+
+	constexpr size_t Requests = 1 << 22;
+	constexpr int ElementsPerRequest = 6;
+
+	// A short-lived vector per request that holds a handful of elements.
+	template<typename VectorType>
+	double MeasureRequests(const char* name)
+	{
+		return MeasureMillionPushesPerSecond(name, []()
+		{
+			int64_t sum = 0;
+
+			for (size_t request = 0; request < Requests; ++request)
+			{
+				VectorType vector;
+
+				for (int i = 0; i < ElementsPerRequest; ++i)
+				{
+					vector.Add(static_cast<int>(request) + i);
+				}
+
+				for (int value : vector)
+				{
+					sum += value;
+				}
+			}
+
+			Benchmarks::DoNotOptimize(sum);
+		}, Requests * ElementsPerRequest);
+	}
+
+	template<typename T>
+	void RunPushes(const char* type, const T& value)
+	{
+		std::cout << type << " x " << Pushes << "\tMpush/s" << std::endl;
+
+		double standard = MeasureMillionPushesPerSecond("std::vector", [&value]()
+		{
+			std::vector<T> vector;
+
+			for (size_t i = 0; i < Pushes; ++i)
+			{
+				vector.push_back(value);
+			}
+
+			Benchmarks::DoNotOptimize(vector.data());
+		});
+
+		double grown = MeasureMillionPushesPerSecond("Vector", [&value]()
+		{
+			Structs::Vector<T> vector;
+
+			for (size_t i = 0; i < Pushes; ++i)
+			{
+				vector.Add(value);
+			}
+
+			Benchmarks::DoNotOptimize(&vector[0]);
+		});
+
+		double reserved = MeasureMillionPushesPerSecond("Vector with Reserve", [&value]()
+		{
+			Structs::Vector<T> vector;
+			vector.Reserve(Pushes);
+
+			for (size_t i = 0; i < Pushes; ++i)
+			{
+				vector.Add(value);
+			}
+
+			Benchmarks::DoNotOptimize(&vector[0]);
+		});
+
+		double stack = MeasureMillionPushesPerSecond("Stack", [&value]()
+		{
+			Structs::Stack<T> stack;
+
+			for (size_t i = 0; i < Pushes; ++i)
+			{
+				stack.Push(value);
+			}
+
+			Benchmarks::DoNotOptimize(&stack.Peek());
+		});
+
+		// Growing relocates with memcpy or moves, never constructing the free slots or copying
+		// the elements again, so it keeps up with std::vector.
+		ASSERT_GT(grown, standard * 0.75);
+		ASSERT_GT(stack, standard * 0.75);
+		ASSERT_GT(reserved, grown * 0.9);
+	}
+}
+
+TEST(VectorPushBenchmark, DISABLED_PushIntegers)
+{
+	RunPushes<int>("int", 42);
+}
+
+TEST(VectorPushBenchmark, DISABLED_PushStrings)
+{
+	RunPushes<std::string>("std::string", std::string("a string too long for the small string buffer"));
+}
+
+TEST(VectorPushBenchmark, DISABLED_SmallVectorsPerRequest)
+{
+	std::cout << Requests << " requests of " << ElementsPerRequest << " ints\tMpush/s" << std::endl;
+
+	double heap = MeasureRequests<Structs::Vector<int>>("Vector");
+	double small = MeasureRequests<Structs::SmallVector<int, 8>>("SmallVector<8>");
+
+	// No allocation at all where the vector makes one per request.
+	ASSERT_GT(small, heap * 1.5);
+}
@@ -0,0 +1,139 @@
+#include "gtest/gtest.h"
+#include "Array/Vector.h"
+#include "BenchmarkUtils.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	constexpr size_t BatchSize = 4096;
+	constexpr size_t AppendTicks = 256;
+	constexpr size_t InsertTicks = 16;
+	constexpr int Runs = 3;
+
+	struct Record
+	{
+		int64_t id;
+		double value;
+		int32_t flags;
+	};
+
+	std::vector<Record> MakeBatch()
+	{
+		std::vector<Record> batch(BatchSize);
+
+		for (size_t i = 0; i < BatchSize; ++i)
+		{
+			batch[i] = { static_cast<int64_t>(i), i * 0.5, static_cast<int32_t>(i % 7) };
+		}
+
+		return batch;
+	}
+
+	template<typename Run>
+	double MeasureBestMilliseconds(const char* name, Run run)
+	{
+		double best = 0;
+
+		for (int i = 0; i < Runs; ++i)
+		{
+			Benchmarks::Stopwatch stopwatch;
+			run();
+			double milliseconds = stopwatch.GetElapsedMilliseconds();
+			best = i == 0 ? milliseconds : std::min(best, milliseconds);
+		}
+
+		std::cout << name << '\t' << best << std::endl;
+		return best;
+	}
+}
+
+TEST(VectorRangeBenchmark, DISABLED_AppendBatchesOfRecords)
+{
+	std::vector<Record> batch = MakeBatch();
+
+	std::cout << AppendTicks << " batches of " << BatchSize << " records" << std::endl;
+	std::cout << "append\tms" << std::endl;
+
+	double perElement = MeasureBestMilliseconds("Add per record", [&batch]()
+	{
+		Structs::Vector<Record> vector;
+
+		for (size_t tick = 0; tick < AppendTicks; ++tick)
+		{
+			for (const Record& record : batch)
+			{
+				vector.Add(record);
+			}
+		}
+
+		Benchmarks::DoNotOptimize(&vector[0]);
+	});
+
+	double range = MeasureBestMilliseconds("AddRange", [&batch]()
+	{
+		Structs::Vector<Record> vector;
+
+		for (size_t tick = 0; tick < AppendTicks; ++tick)
+		{
+			vector.AddRange(batch.begin(), batch.end());
+		}
+
+		Benchmarks::DoNotOptimize(&vector[0]);
+	});
+
+	// One capacity check and one block copy per batch instead of one per record.
+	ASSERT_LT(range * 2, perElement);
+}
+
+TEST(VectorRangeBenchmark, DISABLED_InsertBatchesOfRecordsInTheMiddle)
+{
+	std::vector<Record> batch = MakeBatch();
+
+	std::cout << InsertTicks << " batches of " << BatchSize << " records into the middle of " << BatchSize * 4 << std::endl;
+	std::cout << "insert\tms" << std::endl;
+
+	auto fill = [&batch](Structs::Vector<Record>& vector)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			vector.AddRange(batch.begin(), batch.end());
+		}
+	};
+
+	double perElement = MeasureBestMilliseconds("Insert per record", [&]()
+	{
+		Structs::Vector<Record> vector;
+		fill(vector);
+
+		for (size_t tick = 0; tick < InsertTicks; ++tick)
+		{
+			size_t index = vector.GetSize() / 2;
+
+			for (size_t i = 0; i < BatchSize; ++i)
+			{
+				vector.Insert(batch[i], index + i);
+			}
+		}
+
+		Benchmarks::DoNotOptimize(&vector[0]);
+	});
+
+	double range = MeasureBestMilliseconds("InsertRange", [&]()
+	{
+		Structs::Vector<Record> vector;
+		fill(vector);
+
+		for (size_t tick = 0; tick < InsertTicks; ++tick)
+		{
+			vector.InsertRange(vector.GetSize() / 2, batch.begin(), batch.end());
+		}
+
+		Benchmarks::DoNotOptimize(&vector[0]);
+	});
+
+	// One memmove of the tail per batch instead of one per record.
+	ASSERT_LT(range * 100, perElement);
+}
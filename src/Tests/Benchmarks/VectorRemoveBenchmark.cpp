@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+#include "Array/Vector.h"
+#include "BenchmarkUtils.h"
+#include <cstdint>
+#include <iostream>
+
+namespace
+{
+	// Removing one at a time moves the whole tail per removal, so the sweep it is compared with
+	// stays small enough to finish.
+	constexpr size_t Entries = 1 << 17;
+	constexpr size_t LargeEntries = 1 << 20;
+	constexpr uint64_t ExpiredEvery = 64;
+
+	struct Session
+	{
+		uint64_t id;
+		uint64_t expiry;
+		double score;
+	};
+
+	bool IsExpired(const Session& session)
+	{
+		return session.expiry % ExpiredEvery == 0;
+	}
+
+	Structs::Vector<Session> MakeSessions(size_t count)
+	{
+		Structs::Vector<Session> sessions;
+		sessions.Reserve(count);
+
+		for (uint64_t i = 0; i < count; ++i)
+		{
+			sessions.Add({ i, i * 7919 % count, i * 0.5 });
+		}
+
+		return sessions;
+	}
+
+	template<typename Sweep>
+	double MeasureMilliseconds(size_t count, Sweep sweep, size_t& left)
+	{
+		Structs::Vector<Session> sessions = MakeSessions(count);
+		Benchmarks::Stopwatch stopwatch;
+		sweep(sessions);
+
+		double milliseconds = stopwatch.GetElapsedMilliseconds();
+		left = sessions.GetSize();
+
+		return milliseconds;
+	}
+}
+
+TEST(VectorRemoveBenchmark, DISABLED_ExpirySweep)
+{
+	std::cout << "one session in " << ExpiredEvery << " expired" << std::endl;
+	std::cout << "sweep\tsessions\tms" << std::endl;
+
+	size_t oneByOneLeft = 0;
+	double oneByOne = MeasureMilliseconds(Entries, [](Structs::Vector<Session>& sessions)
+	{
+		for (size_t i = 0; i < sessions.GetSize();)
+		{
+			if (IsExpired(sessions[i]))
+			{
+				sessions.RemoveAt(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}, oneByOneLeft);
+
+	std::cout << "RemoveAt\t" << Entries << '\t' << oneByOne << std::endl;
+
+	size_t swapLeft = 0;
+	double swap = MeasureMilliseconds(Entries, [](Structs::Vector<Session>& sessions)
+	{
+		for (size_t i = 0; i < sessions.GetSize();)
+		{
+			if (IsExpired(sessions[i]))
+			{
+				sessions.SwapRemoveAt(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}, swapLeft);
+
+	std::cout << "SwapRemoveAt\t" << Entries << '\t' << swap << std::endl;
+
+	size_t compactedLeft = 0;
+	double compacted = MeasureMilliseconds(Entries, [](Structs::Vector<Session>& sessions)
+	{
+		sessions.RemoveIf(IsExpired);
+	}, compactedLeft);
+
+	std::cout << "RemoveIf\t" << Entries << '\t' << compacted << std::endl;
+
+	size_t largeLeft = 0;
+	double large = MeasureMilliseconds(LargeEntries, [](Structs::Vector<Session>& sessions)
+	{
+		sessions.RemoveIf(IsExpired);
+	}, largeLeft);
+
+	std::cout << "RemoveIf\t" << LargeEntries << '\t' << large << std::endl;
+
+	ASSERT_EQ(swapLeft, oneByOneLeft);
+	ASSERT_EQ(compactedLeft, oneByOneLeft);
+	ASSERT_EQ(largeLeft, LargeEntries - LargeEntries / ExpiredEvery);
+
+	// One pass over the survivors instead of one move of the tail per expired session.
+	ASSERT_LT(compacted * 20, oneByOne);
+	ASSERT_LT(swap * 20, oneByOne);
+}
@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include "Array/Scan.h"
+#include "Array/Vector.h"
+#include "BenchmarkUtils.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+namespace
+{
+	constexpr size_t Elements = 100000;
+	constexpr size_t Requests = 2000;
+	constexpr int Runs = 3;
+
+	template<typename Scan>
+	double MeasureBestMilliseconds(Scan scan)
+	{
+		double best = 0;
+
+		for (int i = 0; i < Runs; ++i)
+		{
+			Benchmarks::Stopwatch stopwatch;
+
+			for (size_t request = 0; request < Requests; ++request)
+			{
+				scan(request);
+			}
+
+			double milliseconds = stopwatch.GetElapsedMilliseconds();
+			best = i == 0 ? milliseconds : std::min(best, milliseconds);
+		}
+
+		return best;
+	}
+
+	// A dedupe filter: every request looks for a key that is usually not there, so the whole
+	// vector is scanned. The loop is the kernel that element types without lanes take.
+	template<typename T>
+	void RunScans(const char* type, double minimumSpeedup)
+	{
+		Structs::Vector<T> vector;
+
+		for (size_t i = 0; i < Elements; ++i)
+		{
+			vector.Add(static_cast<T>(i % 1000));
+		}
+
+		const T* elements = &vector[0];
+
+		std::cout << type << " x " << Elements << ", " << Requests << " scans\tloop ms\tvector ms\tspeedup" << std::endl;
+
+		double loop = MeasureBestMilliseconds([elements](size_t request)
+		{
+			Benchmarks::DoNotOptimize(Structs::Scan::IndexOf(elements, Elements, static_cast<T>(1000 + request % 2), std::false_type()));
+		});
+
+		double lanes = MeasureBestMilliseconds([&vector](size_t request)
+		{
+			Benchmarks::DoNotOptimize(vector.IndexOf(static_cast<T>(1000 + request % 2)));
+		});
+
+		std::cout << "IndexOf\t" << loop << '\t' << lanes << '\t' << loop / lanes << std::endl;
+
+		double countLoop = MeasureBestMilliseconds([elements](size_t request)
+		{
+			Benchmarks::DoNotOptimize(Structs::Scan::Count(elements, Elements, static_cast<T>(request % 1000), std::false_type()));
+		});
+
+		double countLanes = MeasureBestMilliseconds([&vector](size_t request)
+		{
+			Benchmarks::DoNotOptimize(vector.Count(static_cast<T>(request % 1000)));
+		});
+
+		std::cout << "Count\t" << countLoop << '\t' << countLanes << '\t' << countLoop / countLanes << std::endl;
+
+		double minLoop = MeasureBestMilliseconds([elements](size_t)
+		{
+			Benchmarks::DoNotOptimize(Structs::Scan::Fold<Structs::Scan::Smallest>(elements, Elements, std::false_type()));
+		});
+
+		double minLanes = MeasureBestMilliseconds([&vector](size_t)
+		{
+			Benchmarks::DoNotOptimize(vector.Min());
+		});
+
+		std::cout << "Min\t" << minLoop << '\t' << minLanes << '\t' << minLoop / minLanes << std::endl;
+
+		double sumLoop = MeasureBestMilliseconds([elements](size_t)
+		{
+			Benchmarks::DoNotOptimize(Structs::Scan::Fold<Structs::Scan::Total>(elements, Elements, std::false_type()));
+		});
+
+		double sumLanes = MeasureBestMilliseconds([&vector](size_t)
+		{
+			Benchmarks::DoNotOptimize(vector.Sum());
+		});
+
+		std::cout << "Sum\t" << sumLoop << '\t' << sumLanes << '\t' << sumLoop / sumLanes << std::endl;
+
+		// The early exit keeps compilers from vectorizing the loop themselves, unlike the folds,
+		// so the search is where the lanes are guaranteed to pay off.
+		ASSERT_GT(loop / lanes, minimumSpeedup);
+	}
+}
+
+TEST(VectorScanBenchmark, DISABLED_ScanInt32)
+{
+	RunScans<int32_t>("int32_t", 2);
+}
+
+TEST(VectorScanBenchmark, DISABLED_ScanInt64)
+{
+	RunScans<int64_t>("int64_t", 1.2);
+}
+
+TEST(VectorScanBenchmark, DISABLED_ScanFloat)
+{
+	RunScans<float>("float", 2);
+}
+
+TEST(VectorScanBenchmark, DISABLED_ScanDouble)
+{
+	RunScans<double>("double", 1.2);
+}
@@ -0,0 +1,311 @@
+#include "gtest/gtest.h"
+#include "Array/SmallVector.h"
+#include "Array/Vector.h"
+#include "Set/UnorderedSet.h"
+#include "Map/UnorderedMap.h"
+#include "Map/Map.h"
+#include "Map/UnorderedMultiMap.h"
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	size_t allocations = 0;
+}
+
+void* operator new(size_t size)
+{
+	++allocations;
+	void* memory = std::malloc(size == 0 ? 1 : size);
+
+	if (memory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+template <typename Engine>
+class HashTableAllocationTest : public testing::Test
+{
+public:
+	static constexpr int Count = 1000;
+
+	// Strings longer than any small-string buffer, so every copy allocates.
+	std::vector<std::string> strings;
+
+	HashTableAllocationTest()
+	{
+		for (int i = 0; i < Count; ++i)
+		{
+			strings.push_back(std::string(64, 'x') + std::to_string(i));
+		}
+	}
+
+	template<typename Action>
+	static size_t CountAllocations(Action action)
+	{
+		size_t before = allocations;
+		action();
+		return allocations - before;
+	}
+
+	// The same inserts into a table of ints, which only allocates when the table grows.
+	static size_t CountGrowthAllocations()
+	{
+		Structs::UnorderedMap<int, int, Engine> map;
+
+		return CountAllocations([&map]()
+		{
+			for (int i = 0; i < Count; ++i)
+			{
+				map.TryEmplace(i, i);
+			}
+		});
+	}
+};
+
+using AllocationEngines = testing::Types<
+	Structs::Engines::Chained<>,
+	Structs::Engines::IncrementalChained<>,
+	Structs::Engines::Swiss,
+	Structs::Engines::RobinHood,
+	Structs::Engines::Cuckoo>;
+TYPED_TEST_CASE(HashTableAllocationTest, AllocationEngines);
+
+TYPED_TEST(HashTableAllocationTest, UnorderedSetInsertCopiedStringAllocatesOncePerValue)
+{
+	Structs::UnorderedSet<std::string, TypeParam> set;
+	auto& strings = this->strings;
+
+	size_t count = this->CountAllocations([&set, &strings]()
+	{
+		for (const std::string& value : strings)
+		{
+			set.Insert(value);
+		}
+	});
+
+	ASSERT_EQ(count, this->Count + this->CountGrowthAllocations());
+}
+
+TYPED_TEST(HashTableAllocationTest, UnorderedSetInsertMovedStringAllocatesOnlyOnGrowth)
+{
+	Structs::UnorderedSet<std::string, TypeParam> set;
+	std::vector<std::string> strings = this->strings;
+
+	size_t count = this->CountAllocations([&set, &strings]()
+	{
+		for (std::string& value : strings)
+		{
+			set.Insert(std::move(value));
+		}
+	});
+
+	ASSERT_EQ(count, this->CountGrowthAllocations());
+	ASSERT_EQ(set.Contains(this->strings[0]), true);
+}
+
+TYPED_TEST(HashTableAllocationTest, UnorderedMapInsertStringAllocatesOncePerValue)
+{
+	Structs::UnorderedMap<int, std::string, TypeParam> map;
+	auto& strings = this->strings;
+
+	size_t count = this->CountAllocations([&map, &strings]()
+	{
+		for (int i = 0; i < static_cast<int>(strings.size()); ++i)
+		{
+			map.Insert(i, strings[i]);
+		}
+	});
+
+	ASSERT_EQ(count, this->Count + this->CountGrowthAllocations());
+}
+
+TYPED_TEST(HashTableAllocationTest, UnorderedMapTryEmplaceStringAllocatesOncePerValue)
+{
+	Structs::UnorderedMap<int, std::string, TypeParam> map;
+
+	size_t count = this->CountAllocations([&map]()
+	{
+		for (int i = 0; i < TestFixture::Count; ++i)
+		{
+			map.TryEmplace(i, 100, 'x');
+		}
+	});
+
+	ASSERT_EQ(count, this->Count + this->CountGrowthAllocations());
+	ASSERT_EQ(*map.Find(0), std::string(100, 'x'));
+}
+
+TYPED_TEST(HashTableAllocationTest, UnorderedMapTryEmplaceAlreadyContainingKeyAllocatesNothing)
+{
+	Structs::UnorderedMap<int, std::string, TypeParam> map;
+
+	for (int i = 0; i < this->Count; ++i)
+	{
+		map.TryEmplace(i, 100, 'x');
+	}
+
+	size_t count = this->CountAllocations([&map]()
+	{
+		for (int i = 0; i < TestFixture::Count; ++i)
+		{
+			map.TryEmplace(i, 100, 'y');
+			map[i].size();
+		}
+	});
+
+	ASSERT_EQ(count, 0);
+	ASSERT_EQ(map.GetSize(), this->Count);
+}
+
+TYPED_TEST(HashTableAllocationTest, UnorderedMapInsertAfterReserveAllocatesNothing)
+{
+	Structs::UnorderedMap<int, int, TypeParam> map;
+	map.Reserve(this->Count);
+
+	size_t count = this->CountAllocations([&map]()
+	{
+		for (int i = 0; i < TestFixture::Count; ++i)
+		{
+			map.TryEmplace(i, i);
+		}
+	});
+
+	ASSERT_EQ(count, 0);
+	ASSERT_EQ(map.GetSize(), this->Count);
+}
+
+TYPED_TEST(HashTableAllocationTest, UnorderedMapStringViewLookupAllocatesNothing)
+{
+	Structs::UnorderedMap<std::string, int, TypeParam> map;
+
+	for (int i = 0; i < this->Count; ++i)
+	{
+		map.Insert(this->strings[i], i);
+	}
+
+	std::vector<std::string_view> views(this->strings.begin(), this->strings.end());
+
+	size_t count = this->CountAllocations([&map, &views]()
+	{
+		for (std::string_view view : views)
+		{
+			ASSERT_EQ(map.Contains(view), true);
+			ASSERT_NE(map.Find(view), nullptr);
+			ASSERT_EQ(map.TryRemove(view), true);
+		}
+	});
+
+	ASSERT_EQ(count, 0);
+	ASSERT_EQ(map.IsEmpty(), true);
+}
+
+TYPED_TEST(HashTableAllocationTest, UnorderedMultiMapInsertAfterReserveAllocatesNothing)
+{
+	Structs::UnorderedMultiMap<int, int, TypeParam> map;
+	map.Reserve(this->Count, this->Count * 10);
+
+	size_t count = this->CountAllocations([&map]()
+	{
+		for (int i = 0; i < TestFixture::Count * 10; ++i)
+		{
+			map.Insert(i / 10, i);
+		}
+	});
+
+	ASSERT_EQ(count, 0);
+	ASSERT_EQ(map.EqualRange(7).GetSize(), 10);
+	ASSERT_EQ(map.EqualRange(7)[0], 70);
+}
+
+TYPED_TEST(HashTableAllocationTest, UnorderedMultiMapAllocatesNothingPerKey)
+{
+	Structs::UnorderedMultiMap<int, int, TypeParam> map;
+
+	size_t count = this->CountAllocations([&map]()
+	{
+		for (int i = 0; i < TestFixture::Count * 10; ++i)
+		{
+			map.Insert(i % TestFixture::Count, i);
+		}
+	});
+
+	// The table and the arena grow by doubling, a few dozen times in all.
+	ASSERT_LT(count, this->CountGrowthAllocations() + 64);
+}
+
+TEST(TreeAllocationTest, MapStringViewLookupAllocatesNothing)
+{
+	Structs::Map<std::string, int> map;
+	std::vector<std::string> strings;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		strings.push_back(std::string(64, 'x') + std::to_string(i));
+		map.Insert(strings.back(), i);
+	}
+
+	size_t before = allocations;
+
+	for (const std::string& value : strings)
+	{
+		std::string_view view = value;
+		ASSERT_EQ(map.Contains(view), true);
+		ASSERT_NE(map.Find(view), nullptr);
+		ASSERT_EQ(map.TryRemove(view), true);
+	}
+
+	ASSERT_EQ(allocations, before);
+	ASSERT_EQ(map.IsEmpty(), true);
+}
+
+TEST(VectorAllocationTest, EmptyVectorAllocatesNothing)
+{
+	size_t before = allocations;
+
+	{
+		Structs::Vector<int> vector;
+		Structs::Vector<int> moved(std::move(vector));
+		moved.Clear();
+	}
+
+	ASSERT_EQ(allocations, before);
+}
+
+TEST(VectorAllocationTest, SmallVectorAllocatesOnlyPastInlineCapacity)
+{
+	size_t before = allocations;
+
+	{
+		Structs::SmallVector<int, 8> vector;
+
+		for (int i = 0; i < 8; ++i)
+		{
+			vector.Add(i);
+		}
+
+		Structs::SmallVector<int, 8> moved(std::move(vector));
+
+		ASSERT_EQ(allocations, before);
+
+		moved.Add(8);
+
+		ASSERT_EQ(allocations, before + 1);
+	}
+}
@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include "HashTable/HashTable.h"
+#include "Map/UnorderedMap.h"
+#include "Set/UnorderedSet.h"
+#include <numeric>
+#include <sstream>
+#include <string>
+
+template <typename Engine>
+class HashTableStatsTest : public testing::Test
+{
+public:
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, std::hash<int>, Structs::Engines::Instrumented<Engine>> table;
+
+	void FillWithNumbers(int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			table.Insert(i);
+		}
+	}
+};
+
+using InstrumentedEngines = testing::Types<
+	Structs::Engines::Chained<>,
+	Structs::Engines::IncrementalChained<>,
+	Structs::Engines::Swiss,
+	Structs::Engines::RobinHood,
+	Structs::Engines::Cuckoo>;
+TYPED_TEST_CASE(HashTableStatsTest, InstrumentedEngines);
+
+TYPED_TEST(HashTableStatsTest, HashTableStatsEmptyTableReportsNothing)
+{
+	Structs::HashTableStats stats = this->table.GetStats();
+
+	ASSERT_EQ(stats.size, 0);
+	ASSERT_EQ(stats.capacity, 0);
+	ASSERT_EQ(stats.allocatedBytes, 0);
+	ASSERT_EQ(stats.rehashCount, 0);
+	ASSERT_EQ(stats.maxProbeLength, 0);
+	ASSERT_EQ(stats.probeLengths.empty(), true);
+}
+
+TYPED_TEST(HashTableStatsTest, HashTableStatsProbeLengthsCoverEveryValue)
+{
+	this->FillWithNumbers(1000);
+	Structs::HashTableStats stats = this->table.GetStats();
+
+	ASSERT_EQ(stats.size, 1000);
+	ASSERT_EQ(stats.capacity, this->table.GetCapacity());
+	ASSERT_EQ(std::accumulate(stats.probeLengths.begin(), stats.probeLengths.end(), size_t(0)), 1000);
+	ASSERT_EQ(stats.probeLengths.size(), stats.maxProbeLength + 1);
+	ASSERT_NE(stats.probeLengths.back(), 0);
+	ASSERT_GE(stats.GetMeanProbeLength(), 1);
+	ASSERT_GE(stats.allocatedBytes, 1000 * sizeof(int));
+}
+
+TYPED_TEST(HashTableStatsTest, HashTableStatsCountsEveryGrowth)
+{
+	size_t growths = 0;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		size_t capacity = this->table.GetCapacity();
+		this->table.Insert(i);
+		growths += this->table.GetCapacity() != capacity;
+	}
+
+	ASSERT_GT(growths, 0);
+	ASSERT_EQ(this->table.GetStats().rehashCount, growths);
+}
+
+TYPED_TEST(HashTableStatsTest, HashTableStatsReserveCountsOneRehash)
+{
+	this->table.Reserve(1000);
+	this->table.Reserve(10);
+	this->FillWithNumbers(1000);
+
+	ASSERT_EQ(this->table.GetStats().rehashCount, 1);
+}
+
+TEST(HashTableStatsTest, HashTableStatsSwissEngineCountsTombstones)
+{
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, std::hash<int>, Structs::Engines::Instrumented<Structs::Engines::Swiss>> table;
+
+	// Only removals from groups that have been full leave a tombstone, so the table is filled
+	// to its load limit first.
+	table.Rehash(1024);
+	int count = static_cast<int>(1024 * table.GetMaxLoadFactor());
+
+	for (int i = 0; i < count; ++i)
+	{
+		table.Insert(i);
+	}
+
+	for (int i = 0; i < count; i += 2)
+	{
+		table.Remove(i);
+	}
+
+	Structs::HashTableStats stats = table.GetStats();
+
+	ASSERT_EQ(stats.capacity, 1024);
+	ASSERT_GT(stats.tombstoneCount, 0);
+	ASSERT_LE(stats.tombstoneCount, static_cast<size_t>(count / 2));
+	ASSERT_DOUBLE_EQ(stats.GetTombstoneRatio(), static_cast<double>(stats.tombstoneCount) / stats.capacity);
+}
+
+struct ModuloHasher
+{
+	size_t operator()(int value) const
+	{
+		return static_cast<size_t>(value % 8);
+	}
+};
+
+TEST(HashTableStatsTest, HashTableStatsShowLongChainsOfBadHasher)
+{
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, ModuloHasher, Structs::Engines::Instrumented<Structs::Engines::Chained<>>> table;
+
+	for (int i = 0; i < 800; ++i)
+	{
+		table.Insert(i);
+	}
+
+	Structs::HashTableStats stats = table.GetStats();
+
+	ASSERT_EQ(stats.maxProbeLength, 100);
+
+	for (size_t length = 1; length <= 100; ++length)
+	{
+		ASSERT_EQ(stats.probeLengths[length], 8);
+	}
+}
+
+TEST(HashTableStatsTest, HashTableStatsDumpDistributionWritesHistogram)
+{
+	Structs::UnorderedMap<int, std::string, Structs::Engines::Instrumented<Structs::Engines::Chained<>>> map;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		map.Insert(i, std::to_string(i));
+	}
+
+	std::ostringstream stream;
+	map.DumpDistribution(stream);
+	std::string dump = stream.str();
+
+	ASSERT_NE(dump.find("size 100"), std::string::npos);
+	ASSERT_NE(dump.find("probes\tvalues\n1\t"), std::string::npos);
+}
+
+TEST(HashTableStatsTest, UnorderedSetStatsMatchTable)
+{
+	Structs::UnorderedSet<int, Structs::Engines::Instrumented<Structs::Engines::Swiss>> set;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		set.Insert(i);
+	}
+
+	Structs::HashTableStats stats = set.GetStats();
+
+	ASSERT_EQ(stats.size, 100);
+	ASSERT_EQ(stats.capacity, set.GetCapacity());
+}
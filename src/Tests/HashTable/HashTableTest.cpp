@@ -0,0 +1,911 @@
+#include "gtest/gtest.h"
+#include "HashTable/HashTable.h"
+#include "Set/UnorderedSet.h"
+#include "Map/UnorderedMap.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+
+struct CountingHasher
+{
+	static size_t calls;
+
+	size_t operator()(int value) const
+	{
+		++calls;
+		return std::hash<int>()(value);
+	}
+};
+
+size_t CountingHasher::calls = 0;
+
+struct ComparedKey
+{
+	int value;
+
+	static size_t comparisons;
+
+	bool operator==(const ComparedKey& rhs) const
+	{
+		++comparisons;
+		return value == rhs.value;
+	}
+};
+
+size_t ComparedKey::comparisons = 0;
+
+struct ComparedKeyHasher
+{
+	size_t operator()(const ComparedKey& key) const
+	{
+		return std::hash<int>()(key.value);
+	}
+};
+
+template <typename Engine>
+class HashTableTest : public testing::Test
+{
+public:
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, std::hash<int>, Engine> table;
+
+	void FillWithNumbers(int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			table.Insert(i);
+		}
+	}
+};
+
+using HashTableEngines = testing::Types<
+	Structs::Engines::Chained<>,
+	Structs::Engines::Chained<Structs::Buckets::PrimeModulo>,
+	Structs::Engines::IncrementalChained<>,
+	Structs::Engines::IncrementalChained<1>,
+	Structs::Engines::Swiss,
+	Structs::Engines::RobinHood,
+	Structs::Engines::Cuckoo>;
+TYPED_TEST_CASE(HashTableTest, HashTableEngines);
+
+TYPED_TEST(HashTableTest, HashTableInsertManyValuesInsertsAllValues)
+{
+	this->FillWithNumbers(1000);
+
+	ASSERT_EQ(this->table.GetSize(), 1000);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(this->table.Contains(i), true);
+	}
+
+	ASSERT_EQ(this->table.Contains(1000), false);
+}
+
+TYPED_TEST(HashTableTest, HashTableTryInsertAlreadyContainingValueReturnsFalse)
+{
+	this->FillWithNumbers(100);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		ASSERT_EQ(this->table.TryInsert(i), false);
+	}
+
+	ASSERT_EQ(this->table.GetSize(), 100);
+}
+
+TYPED_TEST(HashTableTest, HashTableRemoveValueDoesntRemoveOtherValues)
+{
+	this->FillWithNumbers(100);
+
+	for (int i = 0; i < 100; i += 2)
+	{
+		ASSERT_EQ(this->table.TryRemove(i), true);
+	}
+
+	for (int i = 0; i < 100; ++i)
+	{
+		ASSERT_EQ(this->table.Contains(i), i % 2 == 1);
+	}
+}
+
+TYPED_TEST(HashTableTest, HashTableRemoveValueDecrementsSize)
+{
+	this->FillWithNumbers(100);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		this->table.Remove(i);
+		ASSERT_EQ(this->table.GetSize(), 99 - i);
+	}
+
+	ASSERT_EQ(this->table.IsEmpty(), true);
+}
+
+TYPED_TEST(HashTableTest, HashTableInsertRemoveChurnKeepsCapacityBounded)
+{
+	this->FillWithNumbers(100);
+	size_t capacity = this->table.GetCapacity();
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		ASSERT_EQ(this->table.TryRemove(i), true);
+		ASSERT_EQ(this->table.TryInsert(i + 100), true);
+	}
+
+	ASSERT_EQ(this->table.GetSize(), 100);
+	ASSERT_EQ(this->table.GetCapacity(), capacity);
+
+	for (int i = 10000; i < 10100; ++i)
+	{
+		ASSERT_EQ(this->table.Contains(i), true);
+	}
+}
+
+TYPED_TEST(HashTableTest, HashTableIteratorVisitsEveryValueOnce)
+{
+	this->FillWithNumbers(100);
+	std::vector<int> visits(100, 0);
+
+	for (int value : this->table)
+	{
+		++visits[value];
+	}
+
+	for (int count : visits)
+	{
+		ASSERT_EQ(count, 1);
+	}
+}
+
+TYPED_TEST(HashTableTest, HashTableIteratorOnEmptyTableVisitsNothing)
+{
+	ASSERT_EQ(this->table.begin() == this->table.end(), true);
+
+	this->FillWithNumbers(100);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		this->table.Remove(i);
+	}
+
+	ASSERT_EQ(this->table.begin() == this->table.end(), true);
+}
+
+TYPED_TEST(HashTableTest, HashTableFindOrInsertHashesKeyOnce)
+{
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, CountingHasher, TypeParam> table;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		CountingHasher::calls = 0;
+		auto inserted = table.FindOrInsert(i, [i]() { return i; });
+
+		ASSERT_EQ(inserted.second, true);
+		ASSERT_EQ(*inserted.first, i);
+		ASSERT_EQ(CountingHasher::calls, 1);
+	}
+
+	for (int i = 0; i < 100; ++i)
+	{
+		CountingHasher::calls = 0;
+		auto found = table.FindOrInsert(i, [i]() { return i; });
+
+		ASSERT_EQ(found.second, false);
+		ASSERT_EQ(*found.first, i);
+		ASSERT_EQ(CountingHasher::calls, 1);
+	}
+}
+
+TYPED_TEST(HashTableTest, HashTableFindComparesKeysOnlyWhenStoredHashMatches)
+{
+	Structs::HashTable<ComparedKey, ComparedKey, Structs::Keys::NoSelector<ComparedKey>, ComparedKeyHasher, TypeParam> table;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		table.Insert(ComparedKey{ i });
+	}
+
+	ComparedKey::comparisons = 0;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(table.Contains(ComparedKey{ i }), true);
+	}
+
+	ASSERT_EQ(ComparedKey::comparisons, 1000);
+	ComparedKey::comparisons = 0;
+
+	for (int i = 1000; i < 2000; ++i)
+	{
+		ASSERT_EQ(table.Contains(ComparedKey{ i }), false);
+	}
+
+	ASSERT_EQ(ComparedKey::comparisons, 0);
+}
+
+TYPED_TEST(HashTableTest, HashTableReserveThenInsertKeepsCapacity)
+{
+	this->table.Reserve(1000);
+	size_t capacity = this->table.GetCapacity();
+
+	this->FillWithNumbers(1000);
+
+	ASSERT_EQ(this->table.GetCapacity(), capacity);
+	ASSERT_EQ(this->table.GetSize(), 1000);
+}
+
+TYPED_TEST(HashTableTest, HashTableRehashKeepsValues)
+{
+	this->FillWithNumbers(100);
+	this->table.Rehash(5000);
+
+	ASSERT_GE(this->table.GetCapacity(), 5000);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		ASSERT_EQ(this->table.Contains(i), true);
+	}
+}
+
+TYPED_TEST(HashTableTest, HashTableShrinkToFitAfterRemoveReducesCapacityAndKeepsValues)
+{
+	this->FillWithNumbers(1000);
+	size_t capacity = this->table.GetCapacity();
+
+	for (int i = 10; i < 1000; ++i)
+	{
+		this->table.Remove(i);
+	}
+
+	this->table.ShrinkToFit();
+
+	ASSERT_LT(this->table.GetCapacity(), capacity);
+	ASSERT_EQ(this->table.GetSize(), 10);
+
+	for (int i = 0; i < 10; ++i)
+	{
+		ASSERT_EQ(this->table.Contains(i), true);
+	}
+}
+
+TYPED_TEST(HashTableTest, HashTableShrinkToFitOnEmptyReleasesStorage)
+{
+	this->FillWithNumbers(100);
+	this->table.Clear();
+	this->table.ShrinkToFit();
+
+	ASSERT_EQ(this->table.GetCapacity(), 0);
+	ASSERT_EQ(this->table.TryInsert(1), true);
+}
+
+TYPED_TEST(HashTableTest, HashTableMaxLoadFactorBoundsSize)
+{
+	this->table.SetMaxLoadFactor(0.5f);
+	this->FillWithNumbers(1000);
+
+	ASSERT_EQ(this->table.GetMaxLoadFactor(), 0.5f);
+	ASSERT_LE(this->table.GetSize(), this->table.GetCapacity() / 2);
+}
+
+TYPED_TEST(HashTableTest, HashTableSetMaxLoadFactorOnFilledTableKeepsValues)
+{
+	this->FillWithNumbers(1000);
+	this->table.SetMaxLoadFactor(0.25f);
+
+	ASSERT_LE(this->table.GetSize(), this->table.GetCapacity() / 4);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(this->table.Contains(i), true);
+	}
+}
+
+TYPED_TEST(HashTableTest, HashTableSetNonPositiveMaxLoadFactorThrowsException)
+{
+	ASSERT_THROW(this->table.SetMaxLoadFactor(0), std::invalid_argument);
+}
+
+TYPED_TEST(HashTableTest, HashTableContainsManyMatchesContains)
+{
+	this->FillWithNumbers(1000);
+	std::vector<int> keys;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		keys.push_back(i * 17 - 200);
+	}
+
+	bool found[100];
+	int* values[100];
+	this->table.ContainsMany(keys.data(), keys.size(), found);
+	this->table.FindMany(keys.data(), keys.size(), values);
+
+	const auto& table = this->table;
+
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		ASSERT_EQ(found[i], table.Contains(keys[i]));
+		ASSERT_EQ(values[i], table.Find(keys[i]));
+	}
+}
+
+TEST(HashTableChainedEngineTest, HashTableChainedEngineIteratesInInsertionOrder)
+{
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, std::hash<int>, Structs::Engines::Chained<>> table;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		table.Insert(999 - i);
+	}
+
+	int expected = 999;
+
+	for (int value : table)
+	{
+		ASSERT_EQ(value, expected--);
+	}
+
+	ASSERT_EQ(expected, -1);
+}
+
+TEST(HashTableChainedEngineTest, HashTableChainedEngineRemoveKeepsValuesContiguous)
+{
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, std::hash<int>, Structs::Engines::Chained<>> table;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		table.Insert(i);
+	}
+
+	for (int i = 0; i < 1000; i += 3)
+	{
+		table.Remove(i);
+	}
+
+	const int* first = &*table.begin();
+	size_t count = 0;
+
+	for (const int& value : table)
+	{
+		ASSERT_EQ(&value, first + count);
+		ASSERT_NE(value % 3, 0);
+		++count;
+	}
+
+	ASSERT_EQ(count, table.GetSize());
+}
+
+TEST(HashTableKeySelectorTest, KeySelectorsAreResolvedAtCompileTime)
+{
+	ASSERT_EQ(std::is_polymorphic<Structs::Keys::NoSelector<std::string>>::value, false);
+	ASSERT_EQ((std::is_polymorphic<Structs::Keys::PairSelector<std::string, int>>::value), false);
+	ASSERT_EQ((Structs::Keys::IsSelector<Structs::Keys::PairSelector<std::string, int>, std::string, std::pair<std::string, int>>::value), true);
+}
+
+TEST(HashTableSwissEngineTest, HashTableSwissEngineReinsertAfterRemoveKeepsValues)
+{
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, std::hash<int>, Structs::Engines::Swiss> table;
+
+	for (int round = 0; round < 10; ++round)
+	{
+		for (int i = 0; i < 500; ++i)
+		{
+			ASSERT_EQ(table.TryInsert(round * 500 + i), true);
+		}
+
+		for (int i = 0; i < 500; ++i)
+		{
+			ASSERT_EQ(table.TryRemove(round * 500 + i), true);
+		}
+	}
+
+	ASSERT_EQ(table.IsEmpty(), true);
+	ASSERT_EQ(table.Contains(0), false);
+}
+
+TYPED_TEST(HashTableTest, HashTableIteratorAfterRemoveVisitsOnlyRemainingValues)
+{
+	this->FillWithNumbers(100);
+
+	for (int i = 0; i < 100; i += 3)
+	{
+		this->table.Remove(i);
+	}
+
+	size_t count = 0;
+
+	for (int value : this->table)
+	{
+		ASSERT_NE(value % 3, 0);
+		++count;
+	}
+
+	ASSERT_EQ(count, this->table.GetSize());
+}
+
+TYPED_TEST(HashTableTest, UnorderedMapEmplaceCopyOfStoredValueAcrossGrowthKeepsIt)
+{
+	const std::string expected(64, 'x');
+	Structs::UnorderedMap<int, std::string, TypeParam> map;
+	map.Insert(0, expected);
+
+	for (int i = 1; i < 1000; ++i)
+	{
+		map.Emplace(i, *map.Find(i / 2));
+	}
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(*map.Find(i), expected);
+	}
+}
+
+TEST(HashTableSwissEngineTest, UnorderedSetWithSwissEngineContainsInsertedValues)
+{
+	Structs::UnorderedSet<std::string, Structs::Engines::Swiss> set;
+
+	for (int i = 0; i < 200; ++i)
+	{
+		set.Insert(std::to_string(i));
+	}
+
+	ASSERT_EQ(set.Contains("199"), true);
+	ASSERT_EQ(set.Contains("200"), false);
+}
+
+TEST(HashTableSwissEngineTest, UnorderedMapWithSwissEngineContainsInsertedValues)
+{
+	Structs::UnorderedMap<int, std::string, Structs::Engines::Swiss> map;
+
+	for (int i = 0; i < 200; ++i)
+	{
+		map.Insert(i, std::to_string(i));
+	}
+
+	size_t count = 0;
+
+	for (auto& pair : map)
+	{
+		ASSERT_EQ(pair.second, std::to_string(pair.first));
+		++count;
+	}
+
+	ASSERT_EQ(count, 200);
+}
+
+struct CollidingHasher
+{
+	size_t operator()(int value) const
+	{
+		return static_cast<size_t>(value % 4);
+	}
+};
+
+TEST(HashTableRobinHoodEngineTest, HashTableRobinHoodEngineRemoveFromCollidingRunKeepsOtherValues)
+{
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, CollidingHasher, Structs::Engines::RobinHood> table;
+
+	for (int i = 0; i < 200; ++i)
+	{
+		table.Insert(i);
+	}
+
+	for (int i = 0; i < 200; i += 3)
+	{
+		table.Remove(i);
+	}
+
+	for (int i = 0; i < 200; ++i)
+	{
+		ASSERT_EQ(table.Contains(i), i % 3 != 0);
+	}
+
+	ASSERT_EQ(table.TryInsert(0), true);
+	ASSERT_EQ(table.Contains(0), true);
+}
+
+TEST(HashTableRobinHoodEngineTest, HashTableRobinHoodEngineMissStopsAtRicherSlot)
+{
+	Structs::RobinHoodStorage<int> storage;
+	auto equalTo = [](int key) { return [key](int value) { return value == key; }; };
+
+	for (int i = 0; i < 900; ++i)
+	{
+		storage.FindOrInsert(std::hash<int>()(i), equalTo(i), [i]() { return i; });
+	}
+
+	size_t longest = 0;
+
+	for (int i = 1000; i < 2000; ++i)
+	{
+		longest = std::max(longest, storage.GetProbeLength(std::hash<int>()(i), equalTo(i)));
+	}
+
+	ASSERT_LT(longest, storage.GetSize() / 10);
+}
+
+TEST(HashTableCuckooEngineTest, HashTableCuckooEngineFillsNinetyFivePercentWithoutGrowing)
+{
+	Structs::CuckooStorage<int64_t> storage;
+	auto equalTo = [](int64_t key) { return [key](int64_t value) { return value == key; }; };
+
+	storage.Rehash(1 << 14);
+	size_t capacity = storage.GetCapacity();
+	size_t count = capacity * 95 / 100;
+	std::mt19937_64 random(1);
+	std::vector<int64_t> keys(count);
+
+	for (int64_t& key : keys)
+	{
+		key = static_cast<int64_t>(random());
+		storage.FindOrInsert(std::hash<int64_t>()(key), equalTo(key), [key]() { return key; });
+	}
+
+	ASSERT_EQ(storage.GetCapacity(), capacity);
+	ASSERT_EQ(storage.GetSize(), count);
+
+	for (int64_t key : keys)
+	{
+		ASSERT_NE(storage.Find(std::hash<int64_t>()(key), equalTo(key)), nullptr);
+	}
+}
+
+struct ConstantHasher
+{
+	size_t operator()(int) const
+	{
+		return 42;
+	}
+};
+
+TEST(HashTableCuckooEngineTest, HashTableCuckooEngineStashesValuesOfFullBuckets)
+{
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, ConstantHasher, Structs::Engines::Cuckoo> table;
+	size_t fit = 3 * Structs::Control::BucketWidth;
+
+	for (int i = 0; i < static_cast<int>(fit); ++i)
+	{
+		table.Insert(i);
+	}
+
+	ASSERT_THROW(table.Insert(-1), std::invalid_argument);
+	ASSERT_EQ(table.GetSize(), fit);
+
+	for (int i = 0; i < static_cast<int>(fit); i += 2)
+	{
+		table.Remove(i);
+	}
+
+	for (int i = 0; i < static_cast<int>(fit); ++i)
+	{
+		ASSERT_EQ(table.Contains(i), i % 2 == 1);
+	}
+
+	ASSERT_EQ(table.TryInsert(-1), true);
+}
+
+TEST(HashTableCuckooEngineTest, HashTableCuckooEngineRemoveMovesStashedValuesBack)
+{
+	Structs::CuckooStorage<int> storage;
+	auto equalTo = [](int key) { return [key](int value) { return value == key; }; };
+	size_t fit = 3 * Structs::Control::BucketWidth;
+
+	for (int i = 0; i < static_cast<int>(fit); ++i)
+	{
+		storage.FindOrInsert(42, equalTo(i), [i]() { return i; });
+	}
+
+	ASSERT_EQ(storage.GetStashSize(), Structs::Control::BucketWidth);
+
+	for (int i = 0; i < static_cast<int>(Structs::Control::BucketWidth); ++i)
+	{
+		storage.TryRemove(42, equalTo(i));
+	}
+
+	ASSERT_EQ(storage.GetStashSize(), 0);
+	ASSERT_EQ(storage.GetProbeLength(42, equalTo(0)), 2);
+}
+
+TEST(HashTableIncrementalChainedEngineTest, HashTableIncrementalChainedEngineFindsValuesWhileMigrating)
+{
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, std::hash<int>, Structs::Engines::IncrementalChained<1>> table;
+	int inserted = 0;
+
+	for (; inserted < 10000; ++inserted)
+	{
+		table.Insert(inserted);
+
+		for (int i = 0; i <= inserted; i += 97)
+		{
+			ASSERT_EQ(table.Contains(i), true);
+		}
+	}
+
+	for (int i = 0; i < inserted; i += 2)
+	{
+		ASSERT_EQ(table.TryRemove(i), true);
+	}
+
+	for (int i = 0; i < inserted; ++i)
+	{
+		ASSERT_EQ(table.Contains(i), i % 2 == 1);
+	}
+
+	ASSERT_EQ(table.GetSize(), 5000);
+}
+
+template<typename BucketIndex>
+void InsertWithoutGrowingWhileMigrating()
+{
+	Structs::IncrementalChainedStorage<size_t, 1, BucketIndex> storage;
+	auto equalTo = [](size_t key) { return [key](size_t value) { return value == key; }; };
+	std::hash<size_t> hasher;
+	size_t migrations = 0;
+
+	for (size_t i = 0; i < 100000; ++i)
+	{
+		bool wasMigrating = storage.IsMigrating();
+		size_t capacity = storage.GetCapacity();
+
+		storage.FindOrInsert(hasher(i), equalTo(i), [i]() { return i; });
+
+		// The table only grows by starting a migration, never while one is running.
+		if (storage.GetCapacity() != capacity && capacity != 0)
+		{
+			ASSERT_EQ(wasMigrating, false);
+			ASSERT_EQ(storage.IsMigrating(), true);
+			++migrations;
+		}
+	}
+
+	ASSERT_GT(migrations, 10);
+	ASSERT_EQ(storage.GetSize(), 100000);
+}
+
+TEST(HashTableIncrementalChainedEngineTest, HashTableIncrementalChainedEngineFinishesMigrationBeforeFillingUp)
+{
+	InsertWithoutGrowingWhileMigrating<Structs::Buckets::Fibonacci>();
+	InsertWithoutGrowingWhileMigrating<Structs::Buckets::PrimeModulo>();
+}
+
+TEST(HashTableChainedEngineTest, HashTableChainedEngineGrowsThroughPolicyCapacities)
+{
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, std::hash<int>, Structs::Engines::Chained<>> fibonacci;
+	Structs::HashTable<int, int, Structs::Keys::NoSelector<int>, std::hash<int>, Structs::Engines::Chained<Structs::Buckets::PrimeModulo>> prime;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		fibonacci.Insert(i * 1024);
+		prime.Insert(i * 1024);
+	}
+
+	ASSERT_EQ(fibonacci.GetCapacity(), 2048);
+	ASSERT_EQ(prime.GetCapacity(), 1597);
+}
+
+TEST(HashTableChainedEngineTest, FibonacciBucketIndexSpreadsStridedKeysOverAllBuckets)
+{
+	std::vector<int> buckets(1024, 0);
+
+	for (size_t i = 0; i < buckets.size(); ++i)
+	{
+		++buckets[Structs::Buckets::Fibonacci::GetIndex(i * 4096, buckets.size())];
+	}
+
+	size_t usedBuckets = std::count_if(buckets.begin(), buckets.end(), [](int count) { return count != 0; });
+
+	ASSERT_GT(usedBuckets, buckets.size() / 2);
+}
+
+TYPED_TEST(HashTableTest, HashTableBulkBuildMatchesSerialInserts)
+{
+	std::mt19937 random(3);
+	std::vector<int> values(20000);
+
+	for (int& value : values)
+	{
+		value = static_cast<int>(random() % 15000);
+	}
+
+	std::vector<size_t> expectedDuplicates;
+	std::unordered_set<int> seen;
+
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		if (!seen.insert(values[i]).second)
+		{
+			expectedDuplicates.push_back(i);
+		}
+	}
+
+	std::vector<size_t> duplicates = this->table.BulkBuild(values.begin(), values.end(), 4);
+
+	ASSERT_EQ(duplicates, expectedDuplicates);
+	ASSERT_EQ(this->table.GetSize(), seen.size());
+
+	for (int value : seen)
+	{
+		ASSERT_EQ(this->table.Contains(value), true);
+	}
+
+	ASSERT_EQ(this->table.Contains(15000), false);
+
+	size_t count = 0;
+
+	for (int value : this->table)
+	{
+		ASSERT_EQ(seen.count(value), 1);
+		++count;
+	}
+
+	ASSERT_EQ(count, seen.size());
+
+	this->table.Remove(values[0]);
+	this->table.Insert(15000);
+
+	ASSERT_EQ(this->table.Contains(values[0]), false);
+	ASSERT_EQ(this->table.Contains(15000), true);
+}
+
+TYPED_TEST(HashTableTest, HashTableBulkBuildIntoNonEmptyTableReportsContainedKeys)
+{
+	this->FillWithNumbers(100);
+
+	std::vector<int> values;
+
+	for (int i = 90; i < 200; ++i)
+	{
+		values.push_back(i);
+	}
+
+	std::vector<size_t> duplicates = this->table.BulkBuild(values.begin(), values.end(), 2);
+
+	ASSERT_EQ(duplicates, std::vector<size_t>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+	ASSERT_EQ(this->table.GetSize(), 200);
+}
+
+struct BulkBuildValue
+{
+	int key;
+	std::string text;
+
+	static int throwOn;
+	static std::atomic<int> live;
+
+	BulkBuildValue(int key)
+		: key(key), text(std::to_string(key) + " is long enough to be allocated")
+	{
+		++live;
+	}
+
+	BulkBuildValue(const BulkBuildValue& value)
+		: key(value.key), text(value.text)
+	{
+		if (key == throwOn)
+		{
+			throw std::runtime_error("Copy failed");
+		}
+
+		++live;
+	}
+
+	BulkBuildValue(BulkBuildValue&& value) noexcept
+		: key(value.key), text(std::move(value.text))
+	{
+		++live;
+	}
+
+	BulkBuildValue& operator=(BulkBuildValue&& value) noexcept
+	{
+		key = value.key;
+		text = std::move(value.text);
+		return *this;
+	}
+
+	~BulkBuildValue()
+	{
+		--live;
+	}
+
+	bool operator==(const BulkBuildValue& rhs) const
+	{
+		return key == rhs.key;
+	}
+};
+
+int BulkBuildValue::throwOn = -1;
+std::atomic<int> BulkBuildValue::live(0);
+
+struct BulkBuildValueHasher
+{
+	size_t operator()(const BulkBuildValue& value) const
+	{
+		return std::hash<int>()(value.key);
+	}
+};
+
+TEST(HashTableChainedEngineTest, HashTableChainedEngineBulkBuildMovesValuesOverDuplicates)
+{
+	std::vector<BulkBuildValue> values;
+
+	for (int i = 0; i < 5000; ++i)
+	{
+		values.emplace_back(i % 7 == 0 ? i / 7 : i);
+	}
+
+	{
+		Structs::HashTable<BulkBuildValue, BulkBuildValue, Structs::Keys::NoSelector<BulkBuildValue>, BulkBuildValueHasher> table;
+		std::vector<size_t> duplicates = table.BulkBuild(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()), 3);
+
+		ASSERT_EQ(table.GetSize() + duplicates.size(), values.size());
+
+		for (size_t position : duplicates)
+		{
+			ASSERT_EQ(position % 7, 0);
+			ASSERT_EQ(values[position].text.empty(), false);
+		}
+
+		for (int i = 1; i < 5000; i += 7)
+		{
+			const BulkBuildValue* value = table.Find(BulkBuildValue(i));
+
+			ASSERT_NE(value, nullptr);
+			ASSERT_EQ(value->text, std::to_string(i) + " is long enough to be allocated");
+		}
+	}
+
+	values.clear();
+	ASSERT_EQ(BulkBuildValue::live, 0);
+}
+
+TEST(HashTableChainedEngineTest, HashTableChainedEngineBulkBuildThrowingCopyLeavesTableEmpty)
+{
+	std::vector<BulkBuildValue> values;
+
+	for (int i = 0; i < 5000; ++i)
+	{
+		values.emplace_back(i);
+	}
+
+	{
+		Structs::HashTable<BulkBuildValue, BulkBuildValue, Structs::Keys::NoSelector<BulkBuildValue>, BulkBuildValueHasher> table;
+		BulkBuildValue::throwOn = 2500;
+
+		ASSERT_THROW(table.BulkBuild(values.begin(), values.end(), 4), std::runtime_error);
+		ASSERT_EQ(table.GetSize(), 0);
+		ASSERT_EQ(table.GetCapacity(), 0);
+
+		BulkBuildValue::throwOn = -1;
+		table.Insert(values[0]);
+
+		ASSERT_EQ(table.Contains(values[0]), true);
+	}
+
+	values.clear();
+	ASSERT_EQ(BulkBuildValue::live, 0);
+}
+
+TEST(HashTableChainedEngineTest, UnorderedMapBulkBuildKeepsFirstValueOfEveryKey)
+{
+	std::vector<std::pair<std::string, int>> pairs;
+
+	for (int i = 0; i < 3000; ++i)
+	{
+		pairs.emplace_back(std::to_string(i % 1000), i);
+	}
+
+	Structs::UnorderedMap<std::string, int> map;
+	std::vector<size_t> duplicates = map.BulkBuild(pairs.begin(), pairs.end(), 2);
+
+	ASSERT_EQ(duplicates.size(), 2000);
+	ASSERT_EQ(duplicates.front(), 1000);
+	ASSERT_EQ(map.GetSize(), 1000);
+	ASSERT_EQ(*map.Find("999"), 999);
+}
@@ -0,0 +1,199 @@
+#include "gtest/gtest.h"
+#include "HashTable/HashTable.h"
+#include "Map/UnorderedMap.h"
+#include "Set/UnorderedSet.h"
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace
+{
+	// The key and message of the reference test vectors: bytes 0, 1, 2 and so on.
+	constexpr Structs::Hashers::Sip::Secret ReferenceSecret{ 0x0706050403020100ull, 0x0f0e0d0c0b0a0908ull };
+
+	std::string GetReferenceMessage(size_t length)
+	{
+		std::string message;
+
+		for (size_t i = 0; i < length; ++i)
+		{
+			message.push_back(static_cast<char>(i));
+		}
+
+		return message;
+	}
+
+	template<typename Hash>
+	double GetMeanFlippedBits(Hash hash, std::string text)
+	{
+		size_t flipped = 0;
+		size_t flips = 0;
+		size_t original = hash(text);
+
+		for (size_t i = 0; i < text.size(); ++i)
+		{
+			for (int bit = 0; bit < 8; ++bit)
+			{
+				text[i] ^= static_cast<char>(1 << bit);
+				flipped += std::bitset<64>(hash(text) ^ original).count();
+				text[i] ^= static_cast<char>(1 << bit);
+				++flips;
+			}
+		}
+
+		return static_cast<double>(flipped) / flips;
+	}
+}
+
+TEST(HashersTest, SipHashMatchesReferenceVectors)
+{
+	ASSERT_EQ(Structs::Hashers::Sip::HashBytes("", 0, ReferenceSecret), 0x726fdb47dd0e0e31ull);
+
+	std::string message = GetReferenceMessage(15);
+	ASSERT_EQ(Structs::Hashers::Sip::HashBytes(message.data(), message.size(), ReferenceSecret), 0xa129ca6149be45e5ull);
+}
+
+TEST(HashersTest, WyHashMatchesReferenceVectors)
+{
+	struct Vector
+	{
+		const char* message;
+		uint64_t hash;
+	};
+
+	// The seed of each vector is its index.
+	const Vector vectors[] =
+	{
+		{ "", 0x93228a4de0eec5a2ull },
+		{ "a", 0xc5bac3db178713c4ull },
+		{ "abc", 0xa97f2f7b1d9b3314ull },
+		{ "message digest", 0x786d1f1df3801df4ull },
+		{ "abcdefghijklmnopqrstuvwxyz", 0xdca5a8138ad37c87ull },
+		{ "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 0xb9e734f117cfaf70ull },
+		{ "12345678901234567890123456789012345678901234567890123456789012345678901234567890", 0x6cc5eab49a92d617ull }
+	};
+
+	for (size_t seed = 0; seed < sizeof(vectors) / sizeof(vectors[0]); ++seed)
+	{
+		std::string_view message = vectors[seed].message;
+		ASSERT_EQ(Structs::Hashers::Wy::HashBytes(message.data(), message.size(), seed), vectors[seed].hash);
+	}
+}
+
+TEST(HashersTest, SipHashOfIntegerHashesItsEightBytes)
+{
+	uint64_t value = 0x0706050403020100ull;
+	std::string message = GetReferenceMessage(8);
+
+	ASSERT_EQ(Structs::Hashers::Sip::HashInteger(value, ReferenceSecret), Structs::Hashers::Sip::HashBytes(message.data(), message.size(), ReferenceSecret));
+}
+
+TEST(HashersTest, SipHashDependsOnSecret)
+{
+	Structs::Hashers::SipHash<std::string> reference(ReferenceSecret);
+	Structs::Hashers::SipHash<std::string> process;
+
+	ASSERT_NE(reference("key"), process("key"));
+	ASSERT_EQ(process("key"), Structs::Hashers::SipHash<std::string>()("key"));
+}
+
+TEST(HashersTest, WyHashDependsOnSeed)
+{
+	ASSERT_NE(Structs::Hashers::WyHash<int>(1)(42), Structs::Hashers::WyHash<int>(2)(42));
+	ASSERT_NE(Structs::Hashers::WyHash<std::string>(1)("key"), Structs::Hashers::WyHash<std::string>(2)("key"));
+}
+
+TEST(HashersTest, StringAndStringViewHashAlike)
+{
+	std::string key = "a key that is longer than forty-eight bytes, to take the wide loop";
+
+	ASSERT_EQ(Structs::Hashers::WyHash<std::string>()(key), Structs::Hashers::WyHash<std::string_view>()(key));
+	ASSERT_EQ(Structs::Hashers::SipHash<std::string>()(key), Structs::Hashers::SipHash<std::string_view>()(key));
+}
+
+TEST(HashersTest, HashersChangeHalfTheBitsForOneFlippedBit)
+{
+	// Every length branch of the string hashes.
+	for (size_t length : { 1, 3, 4, 8, 16, 17, 48, 49, 100 })
+	{
+		std::string text(length, 'x');
+
+		double wy = GetMeanFlippedBits(Structs::Hashers::WyHash<std::string>(), text);
+		double sip = GetMeanFlippedBits(Structs::Hashers::SipHash<std::string>(), text);
+
+		ASSERT_NEAR(wy, 32, 6) << length;
+		ASSERT_NEAR(sip, 32, 6) << length;
+	}
+}
+
+TEST(HashersTest, WyHashSpreadsSequentialIntegers)
+{
+	Structs::Hashers::WyHash<uint64_t> hash;
+	size_t lowBits[16] = {};
+
+	for (uint64_t i = 0; i < 1 << 16; ++i)
+	{
+		++lowBits[hash(i << 16) & 15];
+	}
+
+	for (size_t count : lowBits)
+	{
+		ASSERT_NEAR(count, 4096, 400);
+	}
+}
+
+TEST(HashersTest, UnorderedMapWithSipHashContainsInsertedValues)
+{
+	Structs::UnorderedMap<std::string, int, Structs::Engines::Chained<>, Structs::Hashers::SipHash<std::string>> map;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		map.Insert(std::to_string(i), i);
+	}
+
+	ASSERT_EQ(*map.Find("999"), 999);
+	ASSERT_EQ(map.Contains("1000"), false);
+	ASSERT_EQ(map.Freeze().Contains("500"), true);
+}
+
+TEST(HashersTest, UnorderedSetWithSeededWyHashContainsInsertedValues)
+{
+	Structs::UnorderedSet<int, Structs::Engines::Swiss, Structs::Hashers::WyHash<int>> set(Structs::Hashers::WyHash<int>(7));
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		set.Insert(i * 1024);
+	}
+
+	ASSERT_EQ(set.Contains(999 * 1024), true);
+	ASSERT_EQ(set.Contains(1), false);
+}
+
+TEST(HashersTest, StringHashMatchesStdHashOfStrings)
+{
+	for (const char* text : { "", "a", "string longer than a small-string buffer" })
+	{
+		ASSERT_EQ(Structs::Hashers::StringHash()(text), std::hash<std::string>()(text));
+	}
+
+	static_assert(Structs::Hashers::IsTransparent<Structs::Hashers::Default<std::string>>::value, "Strings are looked up by string_view");
+	static_assert(Structs::Hashers::IsTransparent<Structs::Hashers::WyHash<std::string>>::value, "Strings are looked up by string_view");
+	static_assert(!Structs::Hashers::IsTransparent<Structs::Hashers::Default<int>>::value, "Other keys use std::hash");
+}
+
+TEST(HashersTest, UnorderedSetWithSeededWyHashKeepsHasherWhenMoved)
+{
+	using Set = Structs::UnorderedSet<std::string, Structs::Engines::Swiss, Structs::Hashers::WyHash<std::string>>;
+	Set set(Structs::Hashers::WyHash<std::string>(7));
+
+	for (int i = 0; i < 100; ++i)
+	{
+		set.Insert(std::to_string(i));
+	}
+
+	Set moved(std::move(set));
+
+	ASSERT_EQ(moved.Contains(std::string_view("42")), true);
+	ASSERT_EQ(moved.Contains(std::string("99")), true);
+}
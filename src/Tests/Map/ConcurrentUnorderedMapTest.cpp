@@ -0,0 +1,269 @@
+#include "gtest/gtest.h"
+#include "Map/ConcurrentUnorderedMap.h"
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+class ConcurrentUnorderedMapTest : public testing::Test
+{
+public:
+	static constexpr int Threads = 8;
+
+	Structs::ConcurrentUnorderedMap<int, std::string> map;
+
+	void FillWith10Numbers()
+	{
+		for (int i = 0; i < 10; ++i)
+		{
+			map.Insert(i, std::to_string(i));
+		}
+	}
+
+	template<typename Action>
+	static void RunOnThreads(Action action)
+	{
+		std::vector<std::thread> threads;
+
+		for (int thread = 0; thread < Threads; ++thread)
+		{
+			threads.emplace_back(action, thread);
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+};
+
+TEST_F(ConcurrentUnorderedMapTest, ConcurrentUnorderedMapInsertInsertsValues)
+{
+	FillWith10Numbers();
+	std::string value;
+
+	ASSERT_EQ(map.GetSize(), 10);
+	ASSERT_EQ(map.TryGet(7, value), true);
+	ASSERT_EQ(value, "7");
+	ASSERT_EQ(map.TryGet(10, value), false);
+}
+
+TEST_F(ConcurrentUnorderedMapTest, ConcurrentUnorderedMapInsertAlreadyContainingElementThrowsException)
+{
+	FillWith10Numbers();
+
+	ASSERT_THROW(map.Insert(3, "3"), std::invalid_argument);
+	ASSERT_EQ(map.TryInsert(3, "changed"), false);
+}
+
+TEST_F(ConcurrentUnorderedMapTest, ConcurrentUnorderedMapRemoveRemovesOnlyThatValue)
+{
+	FillWith10Numbers();
+	map.Remove(4);
+
+	ASSERT_EQ(map.Contains(4), false);
+	ASSERT_EQ(map.Contains(5), true);
+	ASSERT_EQ(map.TryRemove(4), false);
+	ASSERT_THROW(map.Remove(4), std::invalid_argument);
+}
+
+TEST_F(ConcurrentUnorderedMapTest, ConcurrentUnorderedMapUpsertInsertsOrUpdates)
+{
+	auto append = [](std::string& value) { value += "!"; };
+
+	ASSERT_EQ(map.Upsert(1, "1", append), true);
+	ASSERT_EQ(map.Upsert(1, "1", append), false);
+	ASSERT_EQ(map.InsertOrAssign(2, "2"), true);
+	ASSERT_EQ(map.InsertOrAssign(2, "two"), false);
+
+	std::string value;
+	map.TryGet(1, value);
+	ASSERT_EQ(value, "1!");
+	map.TryGet(2, value);
+	ASSERT_EQ(value, "two");
+}
+
+TEST_F(ConcurrentUnorderedMapTest, ConcurrentUnorderedMapComputeStartsFromDefaultValue)
+{
+	ASSERT_EQ(map.Compute(5, [](std::string& value) { value += "a"; }), "a");
+	ASSERT_EQ(map.Compute(5, [](std::string& value) { value += "b"; }), "ab");
+	ASSERT_EQ(map.GetSize(), 1);
+}
+
+TEST_F(ConcurrentUnorderedMapTest, ConcurrentUnorderedMapSingleSegmentKeepsAllValues)
+{
+	Structs::ConcurrentUnorderedMap<int, int> single(1);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		single.Insert(i, i);
+	}
+
+	ASSERT_EQ(single.GetSegmentCount(), 1);
+	ASSERT_EQ(single.GetSize(), 1000);
+	ASSERT_EQ(single.Contains(999), true);
+}
+
+TEST_F(ConcurrentUnorderedMapTest, ConcurrentUnorderedMapSegmentCountIsRoundedUpToPowerOfTwo)
+{
+	Structs::ConcurrentUnorderedMap<int, int> rounded(5);
+
+	ASSERT_EQ(rounded.GetSegmentCount(), 8);
+	ASSERT_THROW((Structs::ConcurrentUnorderedMap<int, int>(0)), std::invalid_argument);
+}
+
+TEST_F(ConcurrentUnorderedMapTest, ConcurrentUnorderedMapConcurrentComputeCountsEveryIncrement)
+{
+	Structs::ConcurrentUnorderedMap<int, int> counters;
+	constexpr int Keys = 100;
+	constexpr int Increments = 10000;
+
+	RunOnThreads([&counters](int thread)
+	{
+		for (int i = 0; i < Increments; ++i)
+		{
+			counters.Compute((thread + i) % Keys, [](int& value) { ++value; });
+		}
+	});
+
+	int total = 0;
+
+	for (int key = 0; key < Keys; ++key)
+	{
+		int value = 0;
+		ASSERT_EQ(counters.TryGet(key, value), true);
+		total += value;
+	}
+
+	ASSERT_EQ(total, Threads * Increments);
+}
+
+TEST_F(ConcurrentUnorderedMapTest, ConcurrentUnorderedMapConcurrentInsertAndRemoveKeepsOtherThreadsValues)
+{
+	constexpr int Keys = 2000;
+
+	RunOnThreads([this](int thread)
+	{
+		for (int i = 0; i < Keys; ++i)
+		{
+			map.Insert(thread * Keys + i, std::to_string(i));
+		}
+
+		for (int i = 0; i < Keys; i += 2)
+		{
+			map.Remove(thread * Keys + i);
+		}
+	});
+
+	ASSERT_EQ(map.GetSize(), Threads * Keys / 2);
+
+	for (int key = 0; key < Threads * Keys; ++key)
+	{
+		ASSERT_EQ(map.Contains(key), key % 2 == 1);
+	}
+}
+
+TEST_F(ConcurrentUnorderedMapTest, ConcurrentUnorderedMapConcurrentReadersLeaveMigrationAlone)
+{
+	// One segment whose table has just started migrating to a larger one, one bucket per
+	// step, so any read that moved buckets would race with the others.
+	Structs::ConcurrentUnorderedMap<int, int, Structs::Engines::IncrementalChained<1>> migrating(1);
+	constexpr int Count = 770;
+
+	for (int i = 0; i < Count; ++i)
+	{
+		migrating.Insert(i, i * 2);
+	}
+
+	RunOnThreads([&migrating](int thread)
+	{
+		for (int round = 0; round < 20; ++round)
+		{
+			for (int i = thread; i < Count + 100; i += 3)
+			{
+				int value = -1;
+
+				ASSERT_EQ(migrating.Contains(i), i < Count);
+				ASSERT_EQ(migrating.TryGet(i, value), i < Count);
+				ASSERT_EQ(value, i < Count ? i * 2 : -1);
+			}
+		}
+	});
+
+	ASSERT_EQ(migrating.GetSize(), Count);
+}
+
+struct CountingHash
+{
+	static std::atomic<int> calls;
+
+	size_t operator()(int key) const
+	{
+		++calls;
+		return std::hash<int>()(key);
+	}
+};
+
+std::atomic<int> CountingHash::calls(0);
+
+TEST(ConcurrentUnorderedMapHasherTest, ConcurrentUnorderedMapHashesEveryKeyOnce)
+{
+	Structs::ConcurrentUnorderedMap<int, int, Structs::Engines::Chained<>, CountingHash> map;
+	CountingHash::calls = 0;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		map.Insert(i, i);
+	}
+
+	ASSERT_EQ(CountingHash::calls, 1000);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		int value = 0;
+
+		ASSERT_EQ(map.Contains(i), true);
+		ASSERT_EQ(map.TryGet(i, value), true);
+		ASSERT_EQ(value, i);
+		ASSERT_EQ(map.TryRemove(i), true);
+	}
+
+	ASSERT_EQ(CountingHash::calls, 4000);
+}
+
+TEST(ConcurrentUnorderedMapHasherTest, ConcurrentUnorderedMapTakesSeededHasher)
+{
+	Structs::ConcurrentUnorderedMap<int, int, Structs::Engines::Chained<>, Structs::Hashers::WyHash<int>> map(16, Structs::Hashers::WyHash<int>(7));
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		map.Insert(i, -i);
+	}
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		int value = 0;
+
+		ASSERT_EQ(map.TryGet(i, value), true);
+		ASSERT_EQ(value, -i);
+	}
+
+	ASSERT_EQ(map.GetSize(), 1000);
+}
+
+TEST(ConcurrentUnorderedMapHasherTest, ConcurrentUnorderedMapFindsStringKeysByView)
+{
+	Structs::ConcurrentUnorderedMap<std::string, int> map;
+	map.Insert("a string too long for the small string buffer", 1);
+
+	std::string_view view = "a string too long for the small string buffer";
+	int value = 0;
+
+	ASSERT_EQ(map.Contains(view), true);
+	ASSERT_EQ(map.TryGet(view, value), true);
+	ASSERT_EQ(value, 1);
+	ASSERT_EQ(map.Contains(std::string_view("missing")), false);
+	ASSERT_EQ(map.TryRemove(view), true);
+	ASSERT_EQ(map.IsEmpty(), true);
+}
@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include "Map/UnorderedMap.h"
+#include "Map/FrozenUnorderedMap.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	constexpr auto Weekdays = Structs::MakeFrozenUnorderedMap<std::string_view, int>({
+		{ "monday", 1 }, { "tuesday", 2 }, { "wednesday", 3 }, { "thursday", 4 },
+		{ "friday", 5 }, { "saturday", 6 }, { "sunday", 7 } });
+
+	static_assert(Weekdays.GetSize() == 7, "Every literal pair is kept");
+	static_assert(Weekdays["friday"] == 5, "Lookups run at compile time");
+	static_assert(!Weekdays.Contains("holiday"), "Missing keys are found missing at compile time");
+
+	// Counts into the counter it was given, which a default-constructed copy would not reach.
+	struct CallCountingHasher
+	{
+		static inline size_t ignored = 0;
+		size_t* calls = &ignored;
+
+		size_t operator()(int key) const
+		{
+			++*calls;
+			return std::hash<int>()(key);
+		}
+	};
+}
+
+class FrozenUnorderedMapTest : public testing::Test
+{
+public:
+	Structs::UnorderedMap<int, std::string> map;
+
+	void FillWithNumbers(int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			map.Insert(i * 7, std::to_string(i * 7));
+		}
+	}
+};
+
+class FrozenUnorderedMapParametrizedTestWithSizes :
+	public FrozenUnorderedMapTest,
+	public testing::WithParamInterface<int>
+{};
+
+INSTANTIATE_TEST_CASE_P(
+	FrozenUnorderedMapSizesTests,
+	FrozenUnorderedMapParametrizedTestWithSizes,
+	testing::Values(1, 2, 3, 4, 5, 17, 100, 1000, 50000));
+
+TEST_P(FrozenUnorderedMapParametrizedTestWithSizes, FrozenUnorderedMapFreezeFindsEveryValue)
+{
+	int count = GetParam();
+	FillWithNumbers(count);
+
+	Structs::FrozenUnorderedMap<int, std::string> frozen = map.Freeze();
+
+	ASSERT_EQ(frozen.GetSize(), count);
+
+	for (int i = 0; i < count; ++i)
+	{
+		const std::string* value = frozen.Find(i * 7);
+
+		ASSERT_NE(value, nullptr);
+		ASSERT_EQ(*value, std::to_string(i * 7));
+	}
+}
+
+TEST_P(FrozenUnorderedMapParametrizedTestWithSizes, FrozenUnorderedMapFreezeDoesNotFindMissingKeys)
+{
+	int count = GetParam();
+	FillWithNumbers(count);
+
+	Structs::FrozenUnorderedMap<int, std::string> frozen = map.Freeze();
+
+	for (int i = 0; i < count; ++i)
+	{
+		ASSERT_EQ(frozen.Contains(i * 7 + 1), false);
+	}
+}
+
+TEST_P(FrozenUnorderedMapParametrizedTestWithSizes, FrozenUnorderedMapFreezeIteratesEveryPairOnce)
+{
+	int count = GetParam();
+	FillWithNumbers(count);
+
+	Structs::FrozenUnorderedMap<int, std::string> frozen = map.Freeze();
+	std::vector<int> visits(count);
+
+	for (const auto& pair : frozen)
+	{
+		++visits[pair.first / 7];
+	}
+
+	for (int visit : visits)
+	{
+		ASSERT_EQ(visit, 1);
+	}
+}
+
+TEST_F(FrozenUnorderedMapTest, FrozenUnorderedMapEmptyFindsNothing)
+{
+	Structs::FrozenUnorderedMap<int, std::string> frozen = map.Freeze();
+
+	ASSERT_EQ(frozen.IsEmpty(), true);
+	ASSERT_EQ(frozen.Find(0), nullptr);
+	ASSERT_EQ(frozen.begin(), frozen.end());
+}
+
+TEST_F(FrozenUnorderedMapTest, FrozenUnorderedMapSubscriptMissingKeyThrowsException)
+{
+	FillWithNumbers(10);
+	Structs::FrozenUnorderedMap<int, std::string> frozen = map.Freeze();
+
+	ASSERT_EQ(frozen[14], "14");
+	ASSERT_THROW(frozen[15], std::invalid_argument);
+}
+
+TEST_F(FrozenUnorderedMapTest, FrozenUnorderedMapDuplicateKeysThrowException)
+{
+	std::vector<std::pair<int, int>> pairs = { { 1, 1 }, { 2, 2 }, { 1, 3 } };
+
+	ASSERT_THROW((Structs::FrozenUnorderedMap<int, int>(pairs.begin(), pairs.end())), std::invalid_argument);
+}
+
+TEST_F(FrozenUnorderedMapTest, FrozenUnorderedMapFreezeKeepsHasherOfMap)
+{
+	size_t calls = 0;
+	Structs::UnorderedMap<int, int, Structs::Engines::Chained<>, CallCountingHasher> counted(CallCountingHasher{ &calls });
+
+	for (int i = 0; i < 100; ++i)
+	{
+		counted.Insert(i, i);
+	}
+
+	Structs::FrozenUnorderedMap<int, int, CallCountingHasher> frozen = counted.Freeze();
+	Structs::FrozenUnorderedMap<int, int, CallCountingHasher> moved = std::move(frozen);
+	calls = 0;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		ASSERT_EQ(*moved.Find(i), i);
+	}
+
+	ASSERT_EQ(calls, 100);
+}
+
+TEST_F(FrozenUnorderedMapTest, FrozenUnorderedMapAllocatesOneSlotPerValue)
+{
+	FillWithNumbers(1000);
+	Structs::FrozenUnorderedMap<int, std::string> frozen = map.Freeze();
+
+	ASSERT_LT(frozen.GetAllocatedBytes(), 1000 * (sizeof(std::pair<int, std::string>) + 4));
+}
+
+TEST_F(FrozenUnorderedMapTest, FrozenUnorderedMapBuiltAtCompileTimeFindsLiteralKeys)
+{
+	ASSERT_EQ(*Weekdays.Find("monday"), 1);
+	ASSERT_EQ(*Weekdays.Find("sunday"), 7);
+	ASSERT_EQ(Weekdays.Find("someday"), nullptr);
+}
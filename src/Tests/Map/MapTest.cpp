@@ -2,6 +2,7 @@
 #include "Map/Map.h"
 #include <vector>
 #include <string>
+#include <string_view>
 
 class MapTest : public testing::Test
 {
@@ -196,6 +197,111 @@ TEST_P(MapParametrizedTestWith10Values, MapContainsInvalidValueReturnsFalse)
 	ASSERT_EQ(map.Contains(value.first), false);
 }
 
+TEST_P(MapParametrizedTestWith10Values, MapFindValidValueReturnsValue)
+{
+	FillWith10Numbers();
+	auto value = GetParam();
+	std::string* found = map.Find(value.first);
+
+	ASSERT_NE(found, nullptr);
+	ASSERT_EQ(*found, value.second);
+}
+
+TEST_P(MapParametrizedTestWith10Values, MapFindInvalidValueReturnsNull)
+{
+	auto value = GetParam();
+
+	ASSERT_EQ(map.Find(value.first), nullptr);
+}
+
+TEST_P(MapParametrizedTestWith10Values, MapTryGetValidValueReturnsTrueAndValue)
+{
+	FillWith10Numbers();
+	auto value = GetParam();
+	std::string* found = nullptr;
+
+	ASSERT_EQ(map.TryGet(value.first, found), true);
+	ASSERT_EQ(*found, value.second);
+}
+
+TEST_P(MapParametrizedTestWith10Values, MapTryGetInvalidValueReturnsFalse)
+{
+	auto value = GetParam();
+	std::string* found = nullptr;
+
+	ASSERT_EQ(map.TryGet(value.first, found), false);
+	ASSERT_EQ(found, nullptr);
+}
+
+TEST_P(MapParametrizedTestWith10Values, MapSubscriptValidValueReturnsValue)
+{
+	FillWith10Numbers();
+	auto value = GetParam();
+
+	ASSERT_EQ(map[value.first], value.second);
+	ASSERT_EQ(map.GetSize(), 10);
+}
+
+TEST_P(MapParametrizedTestWith10Values, MapSubscriptInvalidValueInsertsDefaultValue)
+{
+	auto value = GetParam();
+
+	ASSERT_EQ(map[value.first], std::string());
+	ASSERT_EQ(map.Contains(value.first), true);
+	ASSERT_EQ(map.GetSize(), 1);
+}
+
+TEST_P(MapParametrizedTestWith10Values, MapSubscriptAssignmentChangesValue)
+{
+	FillWith10Numbers();
+	auto value = GetParam();
+	map[value.first] = "changed";
+
+	ASSERT_EQ(*map.Find(value.first), "changed");
+}
+
+TEST_F(MapTest, MapStringViewLookupFindsStringKeys)
+{
+	Structs::Map<std::string, int> strings;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		strings.Insert(std::to_string(i), i);
+	}
+
+	std::string_view key = "42";
+
+	ASSERT_EQ(strings.Contains(key), true);
+	ASSERT_EQ(*strings.Find(key), 42);
+	ASSERT_EQ(strings.Contains(std::string_view("100")), false);
+	ASSERT_EQ(strings.Find(std::string_view("100")), nullptr);
+	ASSERT_EQ(strings.TryRemove(key), true);
+	ASSERT_EQ(strings.TryRemove(key), false);
+	ASSERT_EQ(strings.Contains("42"), false);
+	ASSERT_EQ(strings.GetSize(), 99);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		ASSERT_EQ(strings.Contains(std::to_string(i)), i != 42);
+	}
+}
+
+TEST_F(MapTest, MapTryRemoveMissingKeyKeepsTree)
+{
+	FillWith10Numbers();
+
+	ASSERT_EQ(map.TryRemove(10), false);
+	ASSERT_THROW(map.Remove(10), std::invalid_argument);
+	ASSERT_EQ(map.GetSize(), 10);
+
+	int key = 0;
+
+	for (auto& value : map)
+	{
+		ASSERT_EQ(value.first, key++);
+	}
+}
+
 TEST_F(MapTest, MapIteratorOnEmptyTreeThrowsNoExcpetion)
 {
 	ASSERT_NO_THROW(
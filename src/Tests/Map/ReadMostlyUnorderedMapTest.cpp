@@ -0,0 +1,264 @@
+#include "gtest/gtest.h"
+#include "Map/ReadMostlyUnorderedMap.h"
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// Counts into the counter it was given, which a default-constructed copy would not reach.
+	struct CallCountingHasher
+	{
+		static inline size_t ignored = 0;
+		size_t* calls = &ignored;
+
+		size_t operator()(int key) const
+		{
+			++*calls;
+			return std::hash<int>()(key);
+		}
+	};
+}
+
+class ReadMostlyUnorderedMapTest : public testing::Test
+{
+public:
+	Structs::ReadMostlyUnorderedMap<int, std::string> map;
+
+	void FillWith10Numbers()
+	{
+		map.Update([](auto& table)
+		{
+			for (int i = 0; i < 10; ++i)
+			{
+				table.Insert({ i, std::to_string(i) });
+			}
+		});
+	}
+};
+
+TEST_F(ReadMostlyUnorderedMapTest, ReadMostlyUnorderedMapUpdatePublishesAllChanges)
+{
+	FillWith10Numbers();
+	std::string value;
+
+	ASSERT_EQ(map.GetSize(), 10);
+	ASSERT_EQ(map.TryGet(9, value), true);
+	ASSERT_EQ(value, "9");
+	ASSERT_EQ(map.Contains(10), false);
+}
+
+TEST_F(ReadMostlyUnorderedMapTest, ReadMostlyUnorderedMapInsertAlreadyContainingElementThrowsException)
+{
+	FillWith10Numbers();
+
+	ASSERT_THROW(map.Insert(1, "1"), std::invalid_argument);
+	ASSERT_EQ(map.TryInsert(10, "10"), true);
+	ASSERT_EQ(map.GetSize(), 11);
+}
+
+TEST_F(ReadMostlyUnorderedMapTest, ReadMostlyUnorderedMapInsertOrAssignReplacesValue)
+{
+	FillWith10Numbers();
+	std::string value;
+
+	ASSERT_EQ(map.InsertOrAssign(3, "three"), false);
+	ASSERT_EQ(map.InsertOrAssign(30, "thirty"), true);
+	map.TryGet(3, value);
+	ASSERT_EQ(value, "three");
+}
+
+TEST_F(ReadMostlyUnorderedMapTest, ReadMostlyUnorderedMapRemoveRemovesValue)
+{
+	FillWith10Numbers();
+	map.Remove(5);
+
+	ASSERT_EQ(map.Contains(5), false);
+	ASSERT_EQ(map.TryRemove(5), false);
+	ASSERT_THROW(map.Remove(5), std::invalid_argument);
+	ASSERT_EQ(map.GetSize(), 9);
+}
+
+TEST_F(ReadMostlyUnorderedMapTest, ReadMostlyUnorderedMapFailedUpdatePublishesNothing)
+{
+	FillWith10Numbers();
+
+	ASSERT_THROW(map.Update([](auto& table)
+	{
+		table.Remove(0);
+		table.Remove(0);
+	}), std::invalid_argument);
+
+	ASSERT_EQ(map.Contains(0), true);
+	ASSERT_EQ(map.GetSize(), 10);
+}
+
+TEST_F(ReadMostlyUnorderedMapTest, ReadMostlyUnorderedMapAssignReplacesContent)
+{
+	FillWith10Numbers();
+	Structs::ReadMostlyUnorderedMap<int, std::string>::Table table;
+	table.Insert({ 100, "100" });
+
+	map.Assign(std::move(table));
+
+	ASSERT_EQ(map.GetSize(), 1);
+	ASSERT_EQ(map.Contains(100), true);
+	ASSERT_EQ(map.Contains(0), false);
+}
+
+TEST(ReadMostlyUnorderedMapStressTest, ReadMostlyUnorderedMapReadersSeeWholeVersionsWhileWriterRebuilds)
+{
+	constexpr int Keys = 64;
+	constexpr int Versions = 200;
+	constexpr int Readers = 4;
+
+	Structs::ReadMostlyUnorderedMap<int, int, Structs::Engines::IncrementalChained<1>> map;
+	std::atomic<bool> done(false);
+	std::atomic<int> torn(0);
+	std::vector<std::thread> readers;
+
+	for (int reader = 0; reader < Readers; ++reader)
+	{
+		readers.emplace_back([&map, &done, &torn]()
+		{
+			while (!done.load())
+			{
+				bool whole = map.Read([](const auto& table)
+				{
+					const std::pair<int, int>* first = table.Find(0);
+
+					for (int key = 1; key < Keys; ++key)
+					{
+						const std::pair<int, int>* pair = table.Find(key);
+
+						if ((first == nullptr) != (pair == nullptr) || (first != nullptr && pair->second != first->second))
+						{
+							return false;
+						}
+					}
+
+					return true;
+				});
+
+				torn += !whole;
+			}
+		});
+	}
+
+	for (int version = 0; version < Versions; ++version)
+	{
+		map.Update([version](auto& table)
+		{
+			for (int key = 0; key < Keys; ++key)
+			{
+				table.TryRemove(key);
+				table.Insert({ key, version });
+			}
+		});
+	}
+
+	done = true;
+
+	for (std::thread& reader : readers)
+	{
+		reader.join();
+	}
+
+	int value = 0;
+
+	ASSERT_EQ(torn.load(), 0);
+	ASSERT_EQ(map.TryGet(Keys - 1, value), true);
+	ASSERT_EQ(value, Versions - 1);
+}
+
+TEST(ReadMostlyUnorderedMapStressTest, ReadMostlyUnorderedMapRetiresEveryReplacedTable)
+{
+	Structs::Memory::EpochDomain& domain = Structs::Memory::EpochDomain::GetDefault();
+	std::atomic<bool> done(false);
+
+	{
+		Structs::ReadMostlyUnorderedMap<int, std::string> map;
+		std::thread reader([&map, &done]()
+		{
+			std::string value;
+
+			while (!done.load())
+			{
+				map.TryGet(1, value);
+			}
+		});
+
+		for (int i = 0; i < 500; ++i)
+		{
+			map.InsertOrAssign(i % 10, std::to_string(i));
+		}
+
+		done = true;
+		reader.join();
+	}
+
+	domain.Reclaim();
+	ASSERT_EQ(domain.GetRetiredCount(), 0);
+}
+
+TEST(ReadMostlyUnorderedMapHasherTest, ReadMostlyUnorderedMapCopiesKeepItsHasher)
+{
+	size_t calls = 0;
+	Structs::ReadMostlyUnorderedMap<int, int, Structs::Engines::Chained<>, CallCountingHasher> map(CallCountingHasher{ &calls });
+
+	for (int i = 0; i < 10; ++i)
+	{
+		map.Insert(i, -i);
+	}
+
+	map.Clear();
+	map.Insert(1, -1);
+	calls = 0;
+
+	int value = 0;
+
+	ASSERT_EQ(map.TryGet(1, value), true);
+	ASSERT_EQ(value, -1);
+	ASSERT_EQ(map.Contains(2), false);
+	ASSERT_EQ(calls, 2);
+}
+
+TEST(ReadMostlyUnorderedMapHasherTest, ReadMostlyUnorderedMapTakesSeededHasher)
+{
+	Structs::ReadMostlyUnorderedMap<int, int, Structs::Engines::Chained<>, Structs::Hashers::WyHash<int>> map(Structs::Hashers::WyHash<int>(7));
+
+	map.Update([](auto& table)
+	{
+		for (int i = 0; i < 1000; ++i)
+		{
+			table.Insert({ i, -i });
+		}
+	});
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		int value = 0;
+
+		ASSERT_EQ(map.TryGet(i, value), true);
+		ASSERT_EQ(value, -i);
+	}
+}
+
+TEST(ReadMostlyUnorderedMapHasherTest, ReadMostlyUnorderedMapFindsStringKeysByView)
+{
+	Structs::ReadMostlyUnorderedMap<std::string, int> map;
+	map.Insert("a string too long for the small string buffer", 1);
+
+	std::string_view view = "a string too long for the small string buffer";
+	int value = 0;
+
+	ASSERT_EQ(map.Contains(view), true);
+	ASSERT_EQ(map.TryGet(view, value), true);
+	ASSERT_EQ(value, 1);
+	ASSERT_EQ(map.Visit(view, [](const int& found) { ASSERT_EQ(found, 1); }), true);
+	ASSERT_EQ(map.Contains(std::string_view("missing")), false);
+	ASSERT_EQ(map.TryRemove(view), true);
+	ASSERT_EQ(map.IsEmpty(), true);
+}
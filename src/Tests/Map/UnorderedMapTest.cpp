@@ -2,6 +2,7 @@
 #include "Map/UnorderedMap.h"
 #include <vector>
 #include <string>
+#include <string_view>
 
 class UnorderedMapTest : public testing::Test
 {
@@ -196,6 +197,147 @@ TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapContainsInvalidValu
 	ASSERT_EQ(map.Contains(value.first), false);
 }
 
+TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapFindValidValueReturnsValue)
+{
+	FillWith10Numbers();
+	auto value = GetParam();
+	std::string* found = map.Find(value.first);
+
+	ASSERT_NE(found, nullptr);
+	ASSERT_EQ(*found, value.second);
+}
+
+TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapFindInvalidValueReturnsNull)
+{
+	auto value = GetParam();
+
+	ASSERT_EQ(map.Find(value.first), nullptr);
+}
+
+TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapTryGetValidValueReturnsTrueAndValue)
+{
+	FillWith10Numbers();
+	auto value = GetParam();
+	std::string* found = nullptr;
+
+	ASSERT_EQ(map.TryGet(value.first, found), true);
+	ASSERT_EQ(*found, value.second);
+}
+
+TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapTryGetInvalidValueReturnsFalse)
+{
+	auto value = GetParam();
+	std::string* found = nullptr;
+
+	ASSERT_EQ(map.TryGet(value.first, found), false);
+	ASSERT_EQ(found, nullptr);
+}
+
+TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapSubscriptValidValueReturnsValue)
+{
+	FillWith10Numbers();
+	auto value = GetParam();
+
+	ASSERT_EQ(map[value.first], value.second);
+	ASSERT_EQ(map.GetSize(), 10);
+}
+
+TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapSubscriptInvalidValueInsertsDefaultValue)
+{
+	auto value = GetParam();
+
+	ASSERT_EQ(map[value.first], std::string());
+	ASSERT_EQ(map.Contains(value.first), true);
+	ASSERT_EQ(map.GetSize(), 1);
+}
+
+TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapSubscriptAssignmentChangesValue)
+{
+	FillWith10Numbers();
+	auto value = GetParam();
+	map[value.first] = "changed";
+
+	ASSERT_EQ(*map.Find(value.first), "changed");
+}
+
+TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapTryEmplaceElementReturnsTrueAndInsertsValue)
+{
+	auto value = GetParam();
+
+	ASSERT_EQ(map.TryEmplace(value.first, value.second.size(), 'x'), true);
+	ASSERT_EQ(*map.Find(value.first), std::string(value.second.size(), 'x'));
+	ASSERT_EQ(map.GetSize(), 1);
+}
+
+TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapTryEmplaceAlreadyContainingElementKeepsValue)
+{
+	FillWith10Numbers();
+	auto value = GetParam();
+
+	ASSERT_EQ(map.TryEmplace(value.first, "changed"), false);
+	ASSERT_EQ(*map.Find(value.first), value.second);
+	ASSERT_EQ(map.GetSize(), 10);
+}
+
+TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapEmplaceAlreadyContainingElementThrowsException)
+{
+	FillWith10Numbers();
+	auto value = GetParam();
+
+	ASSERT_THROW(map.Emplace(value.first, value.second), std::invalid_argument);
+}
+
+TEST_P(UnorderedMapParametrizedTestWith10Values, UnorderedMapTryInsertMovedPairInsertsValue)
+{
+	auto value = GetParam();
+
+	ASSERT_EQ(map.TryInsert(std::pair<int, std::string>(value)), true);
+	ASSERT_EQ(*map.Find(value.first), value.second);
+}
+
+TEST_F(UnorderedMapTest, UnorderedMapFindManyReturnsValuesOfContainedKeys)
+{
+	FillWith10Numbers();
+	int keys[] = { 0, 5, 10, 9, -1 };
+	std::string* values[5];
+	bool found[5];
+
+	map.FindMany(keys, 5, values);
+	map.ContainsMany(keys, 5, found);
+
+	for (int i = 0; i < 5; ++i)
+	{
+		bool contains = keys[i] >= 0 && keys[i] < 10;
+
+		ASSERT_EQ(found[i], contains);
+		ASSERT_EQ(values[i] != nullptr, contains);
+
+		if (contains)
+		{
+			ASSERT_EQ(*values[i], std::to_string(keys[i]));
+		}
+	}
+}
+
+TEST_F(UnorderedMapTest, UnorderedMapStringViewLookupFindsStringKeys)
+{
+	Structs::UnorderedMap<std::string, int> strings;
+	strings.Insert("first", 1);
+	strings.Insert("second", 2);
+
+	std::string_view first = "first";
+
+	ASSERT_EQ(strings.Contains(first), true);
+	ASSERT_EQ(*strings.Find(first), 1);
+	ASSERT_EQ(strings.Contains(std::string_view("third")), false);
+	ASSERT_EQ(strings.Find(std::string_view("third")), nullptr);
+	ASSERT_EQ(strings.Contains("second"), true);
+	ASSERT_EQ(strings.TryRemove(first), true);
+	ASSERT_EQ(strings.TryRemove(first), false);
+	ASSERT_EQ(strings.Contains(std::string("first")), false);
+	ASSERT_EQ(strings.GetSize(), 1);
+}
+
 TEST_F(UnorderedMapTest, UnorderedMapIteratorOnEmptyTreeThrowsNoExcpetion)
 {
 	ASSERT_NO_THROW(
@@ -0,0 +1,255 @@
+#include "gtest/gtest.h"
+#include "Map/UnorderedMultiMap.h"
+#include "Set/UnorderedMultiSet.h"
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+template <typename Engine>
+class UnorderedMultiMapTest : public testing::Test
+{
+public:
+	Structs::UnorderedMultiMap<int, int, Engine> map;
+};
+
+using MultiMapEngines = testing::Types<
+	Structs::Engines::Chained<>,
+	Structs::Engines::IncrementalChained<>,
+	Structs::Engines::Swiss,
+	Structs::Engines::RobinHood,
+	Structs::Engines::Cuckoo>;
+TYPED_TEST_CASE(UnorderedMultiMapTest, MultiMapEngines);
+
+TYPED_TEST(UnorderedMultiMapTest, UnorderedMultiMapEqualRangeReturnsValuesInInsertionOrder)
+{
+	for (int i = 0; i < 100; ++i)
+	{
+		this->map.Insert(i % 3, i);
+	}
+
+	auto values = this->map.EqualRange(1);
+
+	ASSERT_EQ(values.GetSize(), 33);
+
+	for (size_t i = 0; i < values.GetSize(); ++i)
+	{
+		ASSERT_EQ(values[i], static_cast<int>(3 * i + 1));
+	}
+
+	ASSERT_EQ(this->map.GetSize(), 100);
+	ASSERT_EQ(this->map.GetKeyCount(), 3);
+}
+
+TYPED_TEST(UnorderedMultiMapTest, UnorderedMultiMapEqualRangeOfMissingKeyIsEmpty)
+{
+	this->map.Insert(1, 1);
+
+	ASSERT_EQ(this->map.EqualRange(2).IsEmpty(), true);
+	ASSERT_EQ(this->map.Count(2), 0);
+	ASSERT_EQ(this->map.Contains(2), false);
+}
+
+TYPED_TEST(UnorderedMultiMapTest, UnorderedMultiMapMatchesStdMultimapUnderRandomOperations)
+{
+	std::map<int, std::vector<int>> expected;
+	std::mt19937 random(7);
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		int key = static_cast<int>(random() % 200);
+
+		if (random() % 50 == 0)
+		{
+			ASSERT_EQ(this->map.TryRemove(key), expected.erase(key) != 0);
+		}
+		else
+		{
+			this->map.Insert(key, i);
+			expected[key].push_back(i);
+		}
+	}
+
+	size_t size = 0;
+
+	for (auto& pair : expected)
+	{
+		auto values = this->map.EqualRange(pair.first);
+
+		ASSERT_EQ(std::vector<int>(values.begin(), values.end()), pair.second);
+		size += pair.second.size();
+	}
+
+	ASSERT_EQ(this->map.GetSize(), size);
+	ASSERT_EQ(this->map.GetKeyCount(), expected.size());
+}
+
+TYPED_TEST(UnorderedMultiMapTest, UnorderedMultiMapRemoveMissingKeyThrowsException)
+{
+	ASSERT_THROW(this->map.Remove(1), std::invalid_argument);
+	ASSERT_THROW(this->map.Remove(1000), std::invalid_argument);
+}
+
+TYPED_TEST(UnorderedMultiMapTest, UnorderedMultiMapForEachVisitsEveryKeyOnce)
+{
+	for (int i = 0; i < 1000; ++i)
+	{
+		this->map.Insert(i % 10, i);
+	}
+
+	size_t keys = 0;
+	size_t values = 0;
+
+	this->map.ForEach([&keys, &values](int key, Structs::Span<const int> group)
+	{
+		++keys;
+		values += group.GetSize();
+
+		for (int value : group)
+		{
+			ASSERT_EQ(value % 10, key);
+		}
+	});
+
+	ASSERT_EQ(keys, 10);
+	ASSERT_EQ(values, 1000);
+}
+
+TEST(UnorderedMultiMapTest, UnorderedMultiMapKeepsMoveOnlyValues)
+{
+	Structs::UnorderedMultiMap<std::string, std::unique_ptr<int>> map;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		map.Emplace(std::to_string(i % 7), new int(i));
+	}
+
+	ASSERT_EQ(map.TryRemove(std::string_view("3")), true);
+	ASSERT_EQ(map.Contains(std::string_view("3")), false);
+
+	auto values = map.EqualRange(std::string_view("6"));
+
+	ASSERT_EQ(values.GetSize(), 14);
+	ASSERT_EQ(*values[13], 97);
+}
+
+TEST(UnorderedMultiMapTest, UnorderedMultiMapInsertAfterReserveKeepsArena)
+{
+	Structs::UnorderedMultiMap<int, int> map;
+	map.Reserve(10, 1000);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		map.Insert(i % 10, i);
+	}
+
+	const int* first = map.EqualRange(0).GetData();
+
+	map.Insert(0, 100);
+
+	ASSERT_EQ(map.EqualRange(0).GetData(), first);
+}
+
+TEST(UnorderedMultiMapTest, UnorderedMultiMapShrinkToFitPacksValues)
+{
+	Structs::UnorderedMultiMap<int, int> map;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		map.Insert(i % 7, i);
+	}
+
+	map.ShrinkToFit();
+	map.Insert(3, 1000);
+
+	ASSERT_EQ(map.GetSize(), 1001);
+	ASSERT_EQ(map.EqualRange(3).GetSize(), 144);
+	ASSERT_EQ(map.EqualRange(3)[143], 1000);
+	ASSERT_EQ(map.EqualRange(4)[0], 4);
+}
+
+TEST(UnorderedMultiMapTest, UnorderedMultiMapInsertOwnValueWhileGrowing)
+{
+	Structs::UnorderedMultiMap<int, std::string> map;
+	std::string first = "a value too long for the small string buffer";
+
+	map.Insert(0, first);
+
+	// Every other key keeps the group of 0 away from the end of the arena, so it moves or the
+	// arena is copied each time it grows.
+	for (int i = 1; i < 300; ++i)
+	{
+		map.Insert(i, std::to_string(i));
+		map.Insert(0, map.EqualRange(0)[0]);
+	}
+
+	auto values = map.EqualRange(0);
+
+	ASSERT_EQ(values.GetSize(), 300);
+
+	for (size_t i = 0; i < values.GetSize(); ++i)
+	{
+		ASSERT_EQ(values[i], first);
+	}
+}
+
+struct ThrowingValue
+{
+	int value;
+
+	explicit ThrowingValue(int value)
+		: value(value)
+	{
+		if (value < 0)
+		{
+			throw std::runtime_error("negative");
+		}
+	}
+};
+
+TEST(UnorderedMultiMapTest, UnorderedMultiMapThrowingConstructorLeavesNoEmptyKey)
+{
+	Structs::UnorderedMultiMap<int, ThrowingValue> map;
+	map.Emplace(1, 10);
+
+	ASSERT_THROW(map.Emplace(2, -1), std::runtime_error);
+	ASSERT_THROW(map.Emplace(1, -1), std::runtime_error);
+
+	size_t visited = 0;
+	map.ForEach([&visited](int, Structs::Span<const ThrowingValue> values)
+	{
+		ASSERT_EQ(values.IsEmpty(), false);
+		++visited;
+	});
+
+	ASSERT_EQ(visited, 1);
+	ASSERT_EQ(map.GetKeyCount(), 1);
+	ASSERT_EQ(map.GetSize(), 1);
+	ASSERT_EQ(map.Contains(2), false);
+	ASSERT_EQ(map.EqualRange(1)[0].value, 10);
+
+	map.Emplace(2, 20);
+
+	ASSERT_EQ(map.EqualRange(2)[0].value, 20);
+}
+
+TEST(UnorderedMultiSetTest, UnorderedMultiSetCountsCopies)
+{
+	Structs::UnorderedMultiSet<std::string> set;
+	set.Insert("a");
+	set.Insert("b");
+	set.Insert("a");
+
+	ASSERT_EQ(set.Count("a"), 2);
+	ASSERT_EQ(set.EqualRange(std::string_view("a")).GetSize(), 2);
+	ASSERT_EQ(set.GetSize(), 3);
+	ASSERT_EQ(set.GetDistinctCount(), 2);
+
+	set.Remove("a");
+
+	ASSERT_EQ(set.Contains("a"), false);
+	ASSERT_EQ(set.GetSize(), 1);
+}
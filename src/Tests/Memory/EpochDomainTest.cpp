@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include "Memory/EpochDomain.h"
+#include <atomic>
+#include <thread>
+
+namespace
+{
+	struct Tracked
+	{
+		static std::atomic<int> alive;
+
+		Tracked() { ++alive; }
+		~Tracked() { --alive; }
+	};
+
+	std::atomic<int> Tracked::alive(0);
+}
+
+class EpochDomainTest : public testing::Test
+{
+public:
+	Structs::Memory::EpochDomain& domain = Structs::Memory::EpochDomain::GetDefault();
+
+	void TearDown() override
+	{
+		domain.Reclaim();
+	}
+};
+
+TEST_F(EpochDomainTest, EpochDomainRetireWithoutReadersDeletesImmediately)
+{
+	domain.Retire(new Tracked());
+
+	ASSERT_EQ(Tracked::alive.load(), 0);
+}
+
+TEST_F(EpochDomainTest, EpochDomainRetireWhileGuardedDefersDeleteUntilGuardEnds)
+{
+	Tracked* tracked = new Tracked();
+
+	{
+		Structs::Memory::EpochDomain::Guard guard(domain);
+		domain.Retire(tracked);
+
+		ASSERT_EQ(Tracked::alive.load(), 1);
+		ASSERT_EQ(domain.Reclaim(), 0);
+	}
+
+	ASSERT_EQ(domain.Reclaim(), 1);
+	ASSERT_EQ(Tracked::alive.load(), 0);
+}
+
+TEST_F(EpochDomainTest, EpochDomainNestedGuardsKeepOutermostEpoch)
+{
+	Tracked* tracked = new Tracked();
+
+	{
+		Structs::Memory::EpochDomain::Guard outer(domain);
+
+		{
+			Structs::Memory::EpochDomain::Guard inner(domain);
+		}
+
+		domain.Retire(tracked);
+		ASSERT_EQ(Tracked::alive.load(), 1);
+	}
+
+	domain.Reclaim();
+	ASSERT_EQ(Tracked::alive.load(), 0);
+}
+
+TEST_F(EpochDomainTest, EpochDomainGuardEnteredAfterRetireDoesNotDeferDelete)
+{
+	Tracked* tracked = new Tracked();
+	std::atomic<bool> entered(false);
+	std::atomic<bool> done(false);
+
+	Structs::Memory::EpochDomain::Guard* guard = new Structs::Memory::EpochDomain::Guard(domain);
+	domain.Retire(tracked);
+
+	std::thread reader([this, &entered, &done]()
+	{
+		Structs::Memory::EpochDomain::Guard guard(domain);
+		entered = true;
+
+		while (!done.load())
+		{
+			std::this_thread::yield();
+		}
+	});
+
+	while (!entered.load())
+	{
+		std::this_thread::yield();
+	}
+
+	delete guard;
+	size_t reclaimed = domain.Reclaim();
+
+	done = true;
+	reader.join();
+
+	ASSERT_EQ(reclaimed, 1);
+	ASSERT_EQ(Tracked::alive.load(), 0);
+}
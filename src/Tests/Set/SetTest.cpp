@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 #include "Set/Set.h"
 #include <vector>
+#include <string>
+#include <string_view>
 
 class SetTest : public testing::Test
 {
@@ -185,6 +187,20 @@ TEST_P(SetParametrizedTestWith10Values, SetContainsInvalidValueReturnsFalse)
 	ASSERT_EQ(set.Contains(value), false);
 }
 
+TEST_F(SetTest, SetStringViewLookupFindsStrings)
+{
+	Structs::Set<std::string> strings;
+	strings.Insert("first");
+	strings.Insert("second");
+
+	ASSERT_EQ(strings.Contains(std::string_view("first")), true);
+	ASSERT_EQ(strings.Contains(std::string_view("third")), false);
+	ASSERT_EQ(strings.TryRemove(std::string_view("second")), true);
+	ASSERT_EQ(strings.TryRemove(std::string_view("second")), false);
+	ASSERT_EQ(strings.Contains("second"), false);
+	ASSERT_EQ(strings.GetSize(), 1);
+}
+
 TEST_F(SetTest, SetIteratorOnEmptyTreeThrowsNoExcpetion)
 {
 	ASSERT_NO_THROW(
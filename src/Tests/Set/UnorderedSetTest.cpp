@@ -1,6 +1,24 @@
 #include "gtest/gtest.h"
 #include "Set/UnorderedSet.h"
 #include <vector>
+#include <string>
+#include <string_view>
+
+namespace
+{
+	// Counts into the counter it was given, which a default-constructed copy would not reach.
+	struct CallCountingHasher
+	{
+		static inline size_t ignored = 0;
+		size_t* calls = &ignored;
+
+		size_t operator()(int value) const
+		{
+			++*calls;
+			return std::hash<int>()(value);
+		}
+	};
+}
 
 class UnorderedSetTest : public testing::Test
 {
@@ -174,6 +192,62 @@ TEST_P(UnorderedSetParametrizedTestWith10Values, UnorderedSetContainsInvalidValu
 	ASSERT_EQ(set.Contains(value), false);
 }
 
+TEST_F(UnorderedSetTest, UnorderedSetFreezeContainsSameValues)
+{
+	FillWith10Numbers();
+	Structs::FrozenUnorderedSet<int> frozen = set.Freeze();
+
+	ASSERT_EQ(frozen.GetSize(), 10);
+
+	for (int i = -5; i < 15; ++i)
+	{
+		ASSERT_EQ(frozen.Contains(i), set.Contains(i));
+	}
+}
+
+TEST_F(UnorderedSetTest, UnorderedSetFreezeKeepsHasherOfSet)
+{
+	size_t calls = 0;
+	Structs::UnorderedSet<int, Structs::Engines::Chained<>, CallCountingHasher> counted(CallCountingHasher{ &calls });
+
+	for (int i = 0; i < 100; ++i)
+	{
+		counted.Insert(i);
+	}
+
+	Structs::FrozenUnorderedSet<int, CallCountingHasher> frozen = counted.Freeze();
+	calls = 0;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		ASSERT_EQ(frozen.Contains(i), true);
+	}
+
+	ASSERT_EQ(calls, 100);
+}
+
+TEST_F(UnorderedSetTest, UnorderedSetFrozenAtCompileTimeContainsLiteralValues)
+{
+	constexpr auto primes = Structs::MakeFrozenUnorderedSet<int>({ 2, 3, 5, 7, 11, 13 });
+	static_assert(primes.Contains(11) && !primes.Contains(9), "Lookups run at compile time");
+
+	ASSERT_EQ(primes.Contains(13), true);
+	ASSERT_EQ(primes.Contains(4), false);
+}
+
+TEST_F(UnorderedSetTest, UnorderedSetStringViewLookupFindsStrings)
+{
+	Structs::UnorderedSet<std::string, Structs::Engines::Swiss> strings;
+	strings.Insert("first");
+	strings.Insert("second");
+
+	ASSERT_EQ(strings.Contains(std::string_view("first")), true);
+	ASSERT_EQ(strings.Contains(std::string_view("third")), false);
+	ASSERT_EQ(strings.TryRemove(std::string_view("second")), true);
+	ASSERT_EQ(strings.Contains("second"), false);
+	ASSERT_EQ(strings.GetSize(), 1);
+}
+
 TEST_F(UnorderedSetTest, UnorderedSetIteratorOnEmptyTreeThrowsNoExcpetion)
 {
 	ASSERT_NO_THROW(